@@ -1,14 +1,20 @@
 package main
 
 import (
+	"compress/gzip"
+	"compress/zlib"
 	"database/sql"
+	"encoding/binary"
 	"encoding/json"
 	"fmt"
+	"io"
 	"log"
 	"net/http"
 	"os"
+	"strings"
+	"time"
 
-	_ "github.com/lib/pq"
+	"github.com/lib/pq"
 )
 
 type Config struct {
@@ -33,16 +39,6 @@ type DevicePayload struct {
 	DeepSleepSec   int16  `json:"deep_sleep_sec"`
 }
 
-type PacketPayload struct {
-	DeviceID   string          `json:"device_id"`
-	GatewayID  string          `json:"gateway_id"`
-	MsgType    int16           `json:"msg_type"`
-	SequenceNum int32          `json:"sequence_num"`
-	RSSI       int16           `json:"rssi"`
-	SNR        int16           `json:"snr"`
-	Payload    json.RawMessage `json:"payload"`
-}
-
 type CommandPayload struct {
 	DeviceID    string `json:"device_id"`
 	CommandType int16  `json:"command_type"`
@@ -59,6 +55,30 @@ type EventPayload struct {
 
 var db *sql.DB
 
+// maxBatchRows caps rows per batch request (PostgreSQL allows 65535 bind parameters)
+const maxBatchRows = 1000
+
+// Packet history batches are binary (DbPacketBatch in the gateway firmware):
+// magic, version, row size and row count, then fixed little-endian rows of
+// device_id u64, age_ms u32, sequence u16, rssi i16, snr i8, msg_type u8
+const (
+	packetBatchMagic   = 0x544B504C // "LPKT"
+	packetBatchVersion = 1
+	packetHeaderSize   = 8
+	packetRowSize      = 18
+	maxPacketRows      = 4096
+)
+
+// packetPartitionInterval is how often next month's partition is ensured
+const packetPartitionInterval = 6 * time.Hour
+
+// acceptedEncodings is advertised in /api/health responses (RFC 7694) so
+// clients know they may compress request bodies
+const acceptedEncodings = "gzip, deflate"
+
+// maxDecodedBody caps a decompressed request body
+const maxDecodedBody = 8 << 20
+
 func main() {
 	config := Config{
 		Port:       getEnv("PORT", "3000"),
@@ -87,12 +107,14 @@ func main() {
 
 	log.Printf("Connected to PostgreSQL at %s:%s", config.DBHost, config.DBPort)
 
+	go maintainPacketPartitions()
+
 	// CORS middleware
 	corsHandler := func(next http.HandlerFunc) http.HandlerFunc {
 		return func(w http.ResponseWriter, r *http.Request) {
 			w.Header().Set("Access-Control-Allow-Origin", "*")
 			w.Header().Set("Access-Control-Allow-Methods", "GET, POST, OPTIONS")
-			w.Header().Set("Access-Control-Allow-Headers", "Content-Type")
+			w.Header().Set("Access-Control-Allow-Headers", "Content-Type, Content-Encoding")
 			if r.Method == "OPTIONS" {
 				w.WriteHeader(http.StatusOK)
 				return
@@ -102,12 +124,16 @@ func main() {
 	}
 
 	// Setup HTTP routes
-	// NOTE: Packets endpoint removed - sensor data goes to MQTT → timeseries DB
-	// This API is for device registry and management only
+	// NOTE: Sensor readings go to MQTT → timeseries DB; /api/packets/batch
+	// only records packet history (link quality, sequence numbers)
 	http.HandleFunc("/api/health", corsHandler(healthHandler))
-	http.HandleFunc("/api/devices", corsHandler(devicesHandler))
-	http.HandleFunc("/api/commands", corsHandler(commandsHandler))
-	http.HandleFunc("/api/events", corsHandler(eventsHandler))
+	http.HandleFunc("/api/devices", corsHandler(contentDecoding(devicesHandler)))
+	http.HandleFunc("/api/commands", corsHandler(contentDecoding(commandsHandler)))
+	http.HandleFunc("/api/events", corsHandler(contentDecoding(eventsHandler)))
+	http.HandleFunc("/api/devices/batch", corsHandler(contentDecoding(devicesBatchHandler)))
+	http.HandleFunc("/api/commands/batch", corsHandler(contentDecoding(commandsBatchHandler)))
+	http.HandleFunc("/api/events/batch", corsHandler(contentDecoding(eventsBatchHandler)))
+	http.HandleFunc("/api/packets/batch", corsHandler(contentDecoding(packetsBatchHandler)))
 
 	// Start server
 	addr := ":" + config.Port
@@ -129,10 +155,44 @@ func healthHandler(w http.ResponseWriter, r *http.Request) {
 		return
 	}
 
+	w.Header().Set("Accept-Encoding", acceptedEncodings)
 	w.WriteHeader(http.StatusOK)
 	w.Write([]byte("OK"))
 }
 
+// contentDecoding transparently decompresses gzip or deflate request bodies
+// Other encodings get 415 listing the supported ones in Accept-Encoding
+func contentDecoding(next http.HandlerFunc) http.HandlerFunc {
+	return func(w http.ResponseWriter, r *http.Request) {
+		var body io.ReadCloser
+		var err error
+		switch strings.ToLower(strings.TrimSpace(r.Header.Get("Content-Encoding"))) {
+		case "", "identity":
+			next(w, r)
+			return
+		case "gzip", "x-gzip":
+			body, err = gzip.NewReader(r.Body)
+		case "deflate":
+			body, err = zlib.NewReader(r.Body)
+		default:
+			w.Header().Set("Accept-Encoding", acceptedEncodings)
+			http.Error(w, "Unsupported Content-Encoding", http.StatusUnsupportedMediaType)
+			return
+		}
+		if err != nil {
+			http.Error(w, "Invalid compressed body", http.StatusBadRequest)
+			log.Printf("Invalid compressed body: %v", err)
+			return
+		}
+		defer body.Close()
+
+		r.Body = http.MaxBytesReader(w, body, maxDecodedBody)
+		r.Header.Del("Content-Encoding")
+		r.ContentLength = -1
+		next(w, r)
+	}
+}
+
 func devicesHandler(w http.ResponseWriter, r *http.Request) {
 	if r.Method != http.MethodPost {
 		http.Error(w, "Method not allowed", http.StatusMethodNotAllowed)
@@ -182,9 +242,6 @@ func devicesHandler(w http.ResponseWriter, r *http.Request) {
 	w.WriteHeader(http.StatusOK)
 }
 
-// packetsHandler removed - sensor data goes to MQTT → timeseries DB
-// This API handles device registry and management only
-
 func commandsHandler(w http.ResponseWriter, r *http.Request) {
 	if r.Method != http.MethodPost {
 		http.Error(w, "Method not allowed", http.StatusMethodNotAllowed)
@@ -305,6 +362,262 @@ func eventsHandler(w http.ResponseWriter, r *http.Request) {
 	w.WriteHeader(http.StatusOK)
 }
 
+// decodeBatch reads a JSON array request body into rows
+// Writes the error response and returns false if the request is invalid
+func decodeBatch(w http.ResponseWriter, r *http.Request, rows interface{}, count func() int) bool {
+	if r.Method != http.MethodPost {
+		http.Error(w, "Method not allowed", http.StatusMethodNotAllowed)
+		return false
+	}
+
+	if err := json.NewDecoder(r.Body).Decode(rows); err != nil {
+		http.Error(w, "Invalid JSON", http.StatusBadRequest)
+		log.Printf("Invalid JSON: %v", err)
+		return false
+	}
+
+	if count() > maxBatchRows {
+		http.Error(w, "Batch too large", http.StatusRequestEntityTooLarge)
+		return false
+	}
+
+	return true
+}
+
+// valuesList builds "($1, ..., $n<suffix>), (...)" for a multi-row INSERT
+func valuesList(rows, cols int, suffix string) string {
+	var b strings.Builder
+	for i := 0; i < rows; i++ {
+		if i > 0 {
+			b.WriteString(", ")
+		}
+		b.WriteString("(")
+		for c := 0; c < cols; c++ {
+			if c > 0 {
+				b.WriteString(", ")
+			}
+			fmt.Fprintf(&b, "$%d", i*cols+c+1)
+		}
+		b.WriteString(suffix)
+		b.WriteString(")")
+	}
+	return b.String()
+}
+
+// nullIfEmpty maps an empty string to SQL NULL (e.g. for JSONB columns)
+func nullIfEmpty(s string) interface{} {
+	if s == "" {
+		return nil
+	}
+	return s
+}
+
+func devicesBatchHandler(w http.ResponseWriter, r *http.Request) {
+	var payloads []DevicePayload
+	if !decodeBatch(w, r, &payloads, func() int { return len(payloads) }) {
+		return
+	}
+	if len(payloads) == 0 {
+		w.WriteHeader(http.StatusOK)
+		return
+	}
+
+	// One UPSERT may not touch a row twice; keep the latest update per device
+	latest := make(map[string]int, len(payloads))
+	var devices []DevicePayload
+	for _, p := range payloads {
+		if i, ok := latest[p.DeviceID]; ok {
+			devices[i] = p
+			continue
+		}
+		latest[p.DeviceID] = len(devices)
+		devices = append(devices, p)
+	}
+
+	args := make([]interface{}, 0, len(devices)*10)
+	for _, p := range devices {
+		args = append(args, p.DeviceID, p.Name, p.Location, p.SensorType,
+			p.LastRSSI, p.LastSNR, p.PacketCount,
+			p.LastSequence, p.SensorInterval, p.DeepSleepSec)
+	}
+
+	query := `
+		INSERT INTO devices (
+			device_id, name, location, sensor_type, last_rssi, last_snr,
+			packet_count, last_sequence, sensor_interval, deep_sleep_sec,
+			last_seen, updated_at
+		) VALUES ` + valuesList(len(devices), 10, ", NOW(), NOW()") + `
+		ON CONFLICT (device_id) DO UPDATE SET
+			name = EXCLUDED.name,
+			location = EXCLUDED.location,
+			sensor_type = EXCLUDED.sensor_type,
+			last_rssi = EXCLUDED.last_rssi,
+			last_snr = EXCLUDED.last_snr,
+			packet_count = EXCLUDED.packet_count,
+			last_sequence = EXCLUDED.last_sequence,
+			sensor_interval = EXCLUDED.sensor_interval,
+			deep_sleep_sec = EXCLUDED.deep_sleep_sec,
+			last_seen = NOW(),
+			updated_at = NOW()
+	`
+
+	if _, err := db.Exec(query, args...); err != nil {
+		http.Error(w, "Database error", http.StatusInternalServerError)
+		log.Printf("Failed to upsert device batch: %v", err)
+		return
+	}
+
+	log.Printf("Device batch: %d updates, %d devices", len(payloads), len(devices))
+	w.WriteHeader(http.StatusOK)
+}
+
+func commandsBatchHandler(w http.ResponseWriter, r *http.Request) {
+	var payloads []CommandPayload
+	if !decodeBatch(w, r, &payloads, func() int { return len(payloads) }) {
+		return
+	}
+	if len(payloads) == 0 {
+		w.WriteHeader(http.StatusOK)
+		return
+	}
+
+	args := make([]interface{}, 0, len(payloads)*4)
+	for _, p := range payloads {
+		args = append(args, p.DeviceID, p.CommandType, nullIfEmpty(p.Parameters), p.Status)
+	}
+
+	query := `
+		INSERT INTO commands (
+			device_id, command_type, parameters, status, created_at
+		) VALUES ` + valuesList(len(payloads), 4, ", NOW()")
+
+	if _, err := db.Exec(query, args...); err != nil {
+		http.Error(w, "Database error", http.StatusInternalServerError)
+		log.Printf("Failed to insert command batch: %v", err)
+		return
+	}
+
+	log.Printf("Command batch: %d logged", len(payloads))
+	w.WriteHeader(http.StatusOK)
+}
+
+func eventsBatchHandler(w http.ResponseWriter, r *http.Request) {
+	var payloads []EventPayload
+	if !decodeBatch(w, r, &payloads, func() int { return len(payloads) }) {
+		return
+	}
+	if len(payloads) == 0 {
+		w.WriteHeader(http.StatusOK)
+		return
+	}
+
+	args := make([]interface{}, 0, len(payloads)*4)
+	for _, p := range payloads {
+		args = append(args, p.DeviceID, p.EventType, p.Severity, p.Message)
+	}
+
+	query := `
+		INSERT INTO events (
+			device_id, event_type, severity, message, received_at
+		) VALUES ` + valuesList(len(payloads), 4, ", NOW()")
+
+	if _, err := db.Exec(query, args...); err != nil {
+		http.Error(w, "Database error", http.StatusInternalServerError)
+		log.Printf("Failed to insert event batch: %v", err)
+		return
+	}
+
+	log.Printf("Event batch: %d logged", len(payloads))
+	w.WriteHeader(http.StatusOK)
+}
+
+// packetsBatchHandler stores one binary packet history batch
+// Rows carry their age instead of a timestamp (the gateway has no wall
+// clock); received_at is NOW() minus the age, on the database clock like
+// every other table. One INSERT over unnest()ed arrays: fixed parameter
+// count regardless of batch size
+func packetsBatchHandler(w http.ResponseWriter, r *http.Request) {
+	if r.Method != http.MethodPost {
+		http.Error(w, "Method not allowed", http.StatusMethodNotAllowed)
+		return
+	}
+
+	body, err := io.ReadAll(io.LimitReader(r.Body, packetHeaderSize+maxPacketRows*packetRowSize+1))
+	if err != nil {
+		http.Error(w, "Invalid packet batch", http.StatusBadRequest)
+		return
+	}
+
+	if len(body) < packetHeaderSize ||
+		binary.LittleEndian.Uint32(body[0:]) != packetBatchMagic ||
+		body[4] != packetBatchVersion || body[5] != packetRowSize {
+		http.Error(w, "Invalid packet batch", http.StatusBadRequest)
+		log.Printf("Invalid packet batch header (%d bytes)", len(body))
+		return
+	}
+
+	count := int(binary.LittleEndian.Uint16(body[6:]))
+	if count > maxPacketRows {
+		http.Error(w, "Batch too large", http.StatusRequestEntityTooLarge)
+		return
+	}
+	if len(body) != packetHeaderSize+count*packetRowSize {
+		http.Error(w, "Invalid packet batch", http.StatusBadRequest)
+		log.Printf("Packet batch length %d does not match %d rows", len(body), count)
+		return
+	}
+	if count == 0 {
+		w.WriteHeader(http.StatusOK)
+		return
+	}
+
+	deviceIDs := make([]int64, count)
+	ages := make([]int64, count)
+	sequences := make([]int64, count)
+	rssis := make([]int64, count)
+	snrs := make([]int64, count)
+	msgTypes := make([]int64, count)
+	for i := 0; i < count; i++ {
+		row := body[packetHeaderSize+i*packetRowSize:]
+		deviceIDs[i] = int64(binary.LittleEndian.Uint64(row[0:]))
+		ages[i] = int64(binary.LittleEndian.Uint32(row[8:]))
+		sequences[i] = int64(binary.LittleEndian.Uint16(row[12:]))
+		rssis[i] = int64(int16(binary.LittleEndian.Uint16(row[14:])))
+		snrs[i] = int64(int8(row[16]))
+		msgTypes[i] = int64(row[17])
+	}
+
+	query := `
+		INSERT INTO packets (
+			device_id, msg_type, sequence_num, rssi, snr, received_at
+		)
+		SELECT d, t, s, r, n, NOW() - a * INTERVAL '1 millisecond'
+		FROM unnest($1::bigint[], $2::smallint[], $3::integer[],
+		            $4::smallint[], $5::smallint[], $6::bigint[]) AS u(d, t, s, r, n, a)
+	`
+
+	if _, err := db.Exec(query, pq.Array(deviceIDs), pq.Array(msgTypes), pq.Array(sequences),
+		pq.Array(rssis), pq.Array(snrs), pq.Array(ages)); err != nil {
+		http.Error(w, "Database error", http.StatusInternalServerError)
+		log.Printf("Failed to insert packet batch: %v", err)
+		return
+	}
+
+	log.Printf("Packet batch: %d logged", count)
+	w.WriteHeader(http.StatusOK)
+}
+
+// maintainPacketPartitions keeps the current and next month's packets
+// partitions in place (see ensure_packet_partitions in schema.sql)
+func maintainPacketPartitions() {
+	for {
+		if _, err := db.Exec("SELECT ensure_packet_partitions()"); err != nil {
+			log.Printf("Failed to ensure packet partitions: %v", err)
+		}
+		time.Sleep(packetPartitionInterval)
+	}
+}
+
 func getEnv(key, defaultValue string) string {
 	if value := os.Getenv(key); value != "" {
 		return value
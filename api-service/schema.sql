@@ -28,8 +28,45 @@ CREATE TABLE IF NOT EXISTS devices (
 
 CREATE INDEX IF NOT EXISTS idx_devices_last_seen ON devices(last_seen DESC);
 
--- NOTE: Packet/sensor data is NOT stored here - it goes to MQTT → timeseries DB
--- This database is for device registry and management only
+-- Packet History (INSERT only, high volume)
+-- One row per received LoRa packet: link quality and sequence, not sensor
+-- readings (those still go to MQTT → timeseries DB). Range-partitioned by
+-- month so inserts and recent-history queries touch one small partition and
+-- retention is DROP TABLE packets_YYYY_MM instead of a bulk DELETE.
+-- No foreign key to devices: a packet can arrive before its device upsert
+CREATE TABLE IF NOT EXISTS packets (
+    device_id BIGINT NOT NULL,
+    msg_type SMALLINT NOT NULL,
+    sequence_num INTEGER NOT NULL,
+    rssi SMALLINT,
+    snr SMALLINT,
+    received_at TIMESTAMP NOT NULL
+) PARTITION BY RANGE (received_at);
+
+-- Catches rows outside the monthly partitions (e.g. partition job not run)
+CREATE TABLE IF NOT EXISTS packets_default PARTITION OF packets DEFAULT;
+
+CREATE INDEX IF NOT EXISTS idx_packets_device_time ON packets(device_id, received_at DESC);
+
+-- Create monthly partitions for the current month and months_ahead more
+-- Called at API startup and periodically (and by the gateway in direct
+-- PostgreSQL mode); safe to run any number of times
+CREATE OR REPLACE FUNCTION ensure_packet_partitions(months_ahead INTEGER DEFAULT 1)
+RETURNS void AS $$
+DECLARE
+    month_start DATE;
+BEGIN
+    FOR i IN 0..months_ahead LOOP
+        month_start := date_trunc('month', NOW()) + make_interval(months => i);
+        EXECUTE format(
+            'CREATE TABLE IF NOT EXISTS %I PARTITION OF packets FOR VALUES FROM (%L) TO (%L)',
+            'packets_' || to_char(month_start, 'YYYY_MM'),
+            month_start, month_start + INTERVAL '1 month');
+    END LOOP;
+END;
+$$ LANGUAGE plpgsql;
+
+SELECT ensure_packet_partitions();
 
 -- Command Queue and History (INSERT only)
 CREATE TABLE IF NOT EXISTS commands (
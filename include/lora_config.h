@@ -8,6 +8,13 @@
 // Frequency Configuration
 #define LORA_FREQUENCY      915.0   // MHz (US: 915, EU: 868)
 
+// Regional plan (sets regulatory defaults such as the downlink duty cycle)
+#define LORA_REGION_US915   1       // FCC 15.247: dwell time limits, no duty cycle
+#define LORA_REGION_EU868   2       // ETSI EN 300 220: 1% duty cycle sub-bands
+#ifndef LORA_REGION
+#define LORA_REGION         LORA_REGION_US915   // Must match LORA_FREQUENCY
+#endif
+
 // Radio Parameters (must match sensor settings exactly)
 #define LORA_BANDWIDTH      125.0   // kHz
 #define LORA_SPREADING      9       // SF7-SF12
@@ -2,6 +2,7 @@
 #define LORA_PROTOCOL_H
 
 #include <stdint.h>
+#include <string.h>
 
 // ====================================================================
 // LoRa Peer-to-Peer Communication Protocol
@@ -27,7 +28,9 @@ enum LoRaMsgType {
     MSG_STATUS       = 0x02,  // Device status/health
     MSG_EVENT        = 0x03,  // System events (startup, errors)
     MSG_COMMAND      = 0x10,  // Command from gateway to sensor
+    MSG_COMMAND_BATCH = 0x11, // Several commands in one frame (one RX window)
     MSG_ACK          = 0x20,  // Acknowledgment
+    MSG_COMMAND_ACK  = 0x21,  // Per-command results from sensor
     MSG_BEACON       = 0x30   // Gateway beacon (discovery)
 };
 
@@ -98,8 +101,108 @@ enum CommandType {
     CMD_SET_INTERVAL    = 0x07,  // Set sensor read interval
     CMD_OTA_START       = 0x08,  // Start OTA update (future)
     CMD_TIME_SYNC       = 0x09,  // Time synchronization
+    CMD_SET_GROUP       = 0x0A,  // Assign sensor to a command group
 };
 
+// ====================================================================
+// Group / Broadcast Addressing
+// ====================================================================
+
+// Command frames whose header deviceId is a group address are executed by
+// every sensor in that group (groups 1-254). Group LORA_GROUP_BROADCAST
+// addresses every sensor; LORA_GROUP_NONE means "not in a group".
+// Each member answers with its own MSG_COMMAND_ACK, so sensors should
+// delay that ACK by a random slot to avoid colliding with other members.
+#define LORA_GROUP_ADDRESS_BASE 0xFFFFFFFFFFFFFF00ULL
+#define LORA_GROUP_NONE         0x00
+#define LORA_GROUP_BROADCAST    0xFF
+
+// Header deviceId for a group
+inline uint64_t loraGroupAddress(uint8_t groupId) {
+    return LORA_GROUP_ADDRESS_BASE | groupId;
+}
+
+// True if deviceId is a group/broadcast address rather than a sensor
+inline bool isLoraGroupAddress(uint64_t deviceId) {
+    return (deviceId & ~0xFFULL) == LORA_GROUP_ADDRESS_BASE;
+}
+
+// Group ID from a group address
+inline uint8_t loraGroupId(uint64_t address) {
+    return (uint8_t)(address & 0xFF);
+}
+
+// Range checks for group IDs read as wider integers (e.g. from JSON), so
+// 256 or -1 are rejected instead of wrapping into another group
+inline bool isLoraGroupTarget(long groupId) {      // Command target: 1-255
+    return groupId > LORA_GROUP_NONE && groupId <= LORA_GROUP_BROADCAST;
+}
+inline bool isLoraGroupAssignment(long groupId) {  // CMD_SET_GROUP value: 0-254
+    return groupId >= LORA_GROUP_NONE && groupId < LORA_GROUP_BROADCAST;
+}
+
+// ====================================================================
+// Command Parameters (binary TLV)
+// ====================================================================
+
+// Sensor capability flags
+// Sensors advertise these in an optional byte appended after StatusPayload
+// (payloadLen == sizeof(StatusPayload) + 1). Sensors that omit it are
+// treated as legacy: ASCII decimal parameters, single-command frames only.
+#define LORA_CAP_PARAM_TLV      0x01  // Understands TLV command parameters
+#define LORA_CAP_COMMAND_BATCH  0x02  // Understands MSG_COMMAND_BATCH
+#define LORA_CAP_GROUP_ADDR     0x04  // Accepts group/broadcast frames (implies TLV + batch)
+#define LORA_CAP_COMMAND_ACK    0x08  // Answers command frames with MSG_COMMAND_ACK
+
+// Gateway-internal: set in a queued cmdType when params are TLV-encoded
+// (otherwise legacy ASCII). Never sent over the air: the wire cmdType is
+// always the plain CommandType, and TLV is only sent to sensors advertising
+// LORA_CAP_PARAM_TLV. Such a sensor can still tell the two apart from the
+// params alone: a TLV tag is below 0x20, ASCII decimal starts with a digit.
+#define CMD_FLAG_TLV_PARAMS     0x80
+#define CMD_TYPE_MASK           0x7F
+
+// Parameter tags
+enum ParamTag {
+    PARAM_NONE          = 0x00,  // Command takes no parameters
+    PARAM_SECONDS       = 0x01,  // uint32_t seconds
+    PARAM_PRESSURE_PA   = 0x02,  // uint32_t pressure in Pa (hPa * 100)
+    PARAM_UNIX_TIME     = 0x03,  // uint32_t Unix timestamp (seconds)
+    PARAM_GROUP_ID      = 0x04,  // uint8_t group ID (LORA_GROUP_NONE to leave)
+};
+
+// TLV parameter (2 + len bytes, value little-endian)
+struct ParamTlv {
+    uint8_t  tag;             // Parameter tag (see enum above)
+    uint8_t  len;             // Value length in bytes
+    uint8_t  value[4];        // Value (only len bytes are sent)
+} __attribute__((packed));
+
+// Expected parameter per command type
+struct CommandParamSchema {
+    uint8_t  tag;             // ParamTag (PARAM_NONE = no parameters)
+    uint8_t  size;            // Value size in bytes
+};
+
+// Parameter schema, indexed by CommandType
+static constexpr CommandParamSchema COMMAND_PARAM_SCHEMA[] = {
+    { PARAM_NONE,        0 },  // 0x00 (unused)
+    { PARAM_NONE,        0 },  // CMD_CALIBRATE
+    { PARAM_PRESSURE_PA, 4 },  // CMD_SET_BASELINE
+    { PARAM_NONE,        0 },  // CMD_CLEAR_BASELINE
+    { PARAM_NONE,        0 },  // CMD_RESTART
+    { PARAM_NONE,        0 },  // CMD_STATUS
+    { PARAM_SECONDS,     4 },  // CMD_SET_SLEEP
+    { PARAM_SECONDS,     4 },  // CMD_SET_INTERVAL
+    { PARAM_NONE,        0 },  // CMD_OTA_START
+    { PARAM_UNIX_TIME,   4 },  // CMD_TIME_SYNC
+    { PARAM_GROUP_ID,    1 },  // CMD_SET_GROUP
+};
+
+#define COMMAND_PARAM_SCHEMA_COUNT (sizeof(COMMAND_PARAM_SCHEMA) / sizeof(COMMAND_PARAM_SCHEMA[0]))
+static_assert(COMMAND_PARAM_SCHEMA_COUNT == CMD_SET_GROUP + 1,
+              "COMMAND_PARAM_SCHEMA must have one entry per CommandType");
+
 // Event types
 enum EventType {
     EVENT_STARTUP       = 0x01,  // Device startup
@@ -127,6 +230,37 @@ struct CommandPayload {
     uint8_t  params[238];     // Parameters (binary or small JSON)
 } __attribute__((packed));
 
+// Maximum commands packed into one MSG_COMMAND_BATCH frame
+#define MAX_BATCH_COMMANDS 16
+
+// Command batch payload (variable length, max 240 bytes)
+// Layout: cmdCount, then cmdCount x { cmdType, paramLen, params[paramLen] }
+// Each tuple is encoded exactly like a single CommandPayload.
+struct CommandBatchHeader {
+    uint8_t  cmdCount;        // Number of command tuples that follow
+} __attribute__((packed));
+
+// Per-command result codes (reported in CommandAckPayload)
+enum CommandResultCode {
+    CMD_RESULT_OK            = 0x00,  // Command executed
+    CMD_RESULT_UNKNOWN       = 0x01,  // Command type not supported
+    CMD_RESULT_INVALID_PARAM = 0x02,  // Parameters missing or out of range
+    CMD_RESULT_FAILED        = 0x03   // Command failed while executing
+};
+
+struct CommandResult {
+    uint8_t  cmdType;         // Command type this result belongs to
+    uint8_t  status;          // CommandResultCode
+} __attribute__((packed));
+
+// Command ACK payload (variable length, 3 + 2 * resultCount bytes)
+// Sent by the sensor once per MSG_COMMAND / MSG_COMMAND_BATCH frame
+struct CommandAckPayload {
+    uint16_t ackSequenceNum;  // Sequence number of the command frame
+    uint8_t  resultCount;     // Number of results that follow
+    CommandResult results[MAX_BATCH_COMMANDS];
+} __attribute__((packed));
+
 // Event payload (variable length)
 struct EventPayload {
     uint8_t  eventType;       // Event type code
@@ -200,4 +334,84 @@ inline void initHeader(LoRaPacketHeader* header, uint8_t msgType,
     header->checksum = calculateHeaderChecksum(header);
 }
 
+// Get parameter schema for a command type (flag bits ignored)
+inline const CommandParamSchema& commandParamSchema(uint8_t cmdType) {
+    cmdType &= CMD_TYPE_MASK;
+    return COMMAND_PARAM_SCHEMA[cmdType < COMMAND_PARAM_SCHEMA_COUNT ? cmdType : 0];
+}
+
+// Encode a command's parameter as TLV into out (at least sizeof(ParamTlv))
+// Returns encoded length, or 0 if the command takes no parameter or the
+// value does not fit the schema width
+inline uint8_t encodeCommandParam(uint8_t cmdType, uint32_t value, uint8_t* out) {
+    const CommandParamSchema& schema = commandParamSchema(cmdType);
+    if (schema.size == 0 || (schema.size < 4 && (value >> (schema.size * 8)) != 0)) {
+        return 0;
+    }
+    out[0] = schema.tag;
+    out[1] = schema.size;
+    memcpy(out + 2, &value, schema.size);  // Both ends are little-endian
+    return 2 + schema.size;
+}
+
+// Decode a command's TLV parameter
+// Returns false if params do not match the schema for cmdType
+inline bool decodeCommandParam(uint8_t cmdType, const uint8_t* params, uint8_t paramLen,
+                               uint32_t* value) {
+    const CommandParamSchema& schema = commandParamSchema(cmdType);
+    *value = 0;
+    if (schema.size == 0 || paramLen != 2 + schema.size ||
+        params[0] != schema.tag || params[1] != schema.size) {
+        return false;
+    }
+    memcpy(value, params + 2, schema.size);
+    return true;
+}
+
+// Append one command tuple to a batch payload
+// payload must hold LORA_MAX_PAYLOAD_SIZE bytes; *payloadLen starts at 0
+// Returns false (payload unchanged) if the tuple does not fit
+inline bool appendBatchCommand(uint8_t* payload, uint8_t* payloadLen, uint8_t cmdType,
+                               const uint8_t* params, uint8_t paramLen) {
+    size_t len = *payloadLen;
+    if (len == 0) {
+        len = sizeof(CommandBatchHeader);
+        payload[0] = 0;
+    }
+    if (payload[0] >= MAX_BATCH_COMMANDS ||
+        len + 2 + paramLen > LORA_MAX_PAYLOAD_SIZE) {
+        return false;
+    }
+
+    payload[len++] = cmdType;
+    payload[len++] = paramLen;
+    for (uint8_t i = 0; i < paramLen; i++) {
+        payload[len++] = params[i];
+    }
+    payload[0]++;
+    *payloadLen = (uint8_t)len;
+    return true;
+}
+
+// Read the next command tuple from a batch payload
+// *offset starts at sizeof(CommandBatchHeader) and is advanced past the tuple
+// Returns false when no complete tuple remains
+inline bool nextBatchCommand(const uint8_t* payload, uint8_t payloadLen, uint8_t* offset,
+                             uint8_t* cmdType, const uint8_t** params, uint8_t* paramLen) {
+    size_t pos = *offset;
+    if (pos + 2 > payloadLen) {
+        return false;
+    }
+    uint8_t len = payload[pos + 1];
+    if (pos + 2 + len > payloadLen) {
+        return false;
+    }
+
+    *cmdType = payload[pos];
+    *paramLen = len;
+    *params = payload + pos + 2;
+    *offset = (uint8_t)(pos + 2 + len);
+    return true;
+}
+
 #endif // LORA_PROTOCOL_H
@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+"""
+Dashboard asset build - LoRa Gateway
+
+Minifies web/dashboard.html, gzips it and writes src/dashboard_html.h: the
+page as a PROGMEM byte array plus a content-hash ETag. The web server sends
+the bytes as is with Content-Encoding: gzip.
+
+Runs before every PlatformIO build (extra_scripts = pre:...) and can be run
+by hand: python3 scripts/build_dashboard.py
+The header is only rewritten when the page changed, so an unchanged page
+does not trigger a rebuild.
+"""
+
+import gzip
+import hashlib
+import os
+import re
+
+SOURCE = os.path.join("web", "dashboard.html")
+OUTPUT = os.path.join("src", "dashboard_html.h")
+BYTES_PER_LINE = 16
+
+
+def minify_block(text, comment_pattern, line_comments):
+    """Drop comments, indentation and blank lines; newlines are kept so
+    JavaScript automatic semicolon insertion still sees line ends"""
+    text = re.sub(comment_pattern, "", text, flags=re.S)
+    lines = []
+    for line in text.splitlines():
+        line = line.strip()
+        if not line or (line_comments and line.startswith("//")):
+            continue
+        lines.append(line)
+    return "\n".join(lines)
+
+
+def minify(html):
+    parts = re.split(r"(<style>.*?</style>|<script>.*?</script>)", html, flags=re.S)
+    out = []
+    for part in parts:
+        if part.startswith("<style>"):
+            out.append(minify_block(part, r"/\*.*?\*/", False))
+        elif part.startswith("<script>"):
+            out.append(minify_block(part, r"/\*.*?\*/", True))
+        else:
+            out.append(minify_block(part, r"<!--.*?-->", False))
+    return "\n".join(p for p in out if p)
+
+
+def render_header(page, packed, etag):
+    lines = [
+        "// Generated by scripts/build_dashboard.py from web/dashboard.html - do not edit",
+        "",
+        "#ifndef DASHBOARD_HTML_H",
+        "#define DASHBOARD_HTML_H",
+        "",
+        "#include <Arduino.h>",
+        "",
+        "#define DASHBOARD_HTML_ETAG \"\\\"%s\\\"\"" % etag,
+        "#define DASHBOARD_HTML_SIZE %d              // Minified, before gzip" % len(page),
+        "",
+        "static const uint8_t dashboard_html_gz[] PROGMEM = {",
+    ]
+    for i in range(0, len(packed), BYTES_PER_LINE):
+        chunk = packed[i:i + BYTES_PER_LINE]
+        lines.append("    " + ", ".join("0x%02x" % b for b in chunk) + ",")
+    lines += [
+        "};",
+        "",
+        "#endif // DASHBOARD_HTML_H",
+        "",
+    ]
+    return "\n".join(lines)
+
+
+def build(project_dir):
+    source = os.path.join(project_dir, SOURCE)
+    output = os.path.join(project_dir, OUTPUT)
+
+    with open(source, encoding="utf-8") as f:
+        html = f.read()
+
+    page = minify(html).encode("utf-8")
+    # Fixed mtime keeps the output (and the ETag) reproducible
+    packed = gzip.compress(page, compresslevel=9, mtime=0)
+    etag = hashlib.sha256(page).hexdigest()[:16]
+    header = render_header(page, packed, etag)
+
+    if os.path.exists(output):
+        with open(output, encoding="utf-8") as f:
+            if f.read() == header:
+                return
+
+    with open(output, "w", encoding="utf-8") as f:
+        f.write(header)
+    print("Dashboard: %d bytes -> %d minified -> %d gzip, ETag %s" %
+          (len(html.encode("utf-8")), len(page), len(packed), etag))
+
+
+try:
+    Import("env")  # noqa: F821 - provided when run by PlatformIO (SCons)
+    build(env.subst("$PROJECT_DIR"))  # noqa: F821
+except NameError:
+    build(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+"""
+Metrics format check - LoRa Gateway
+
+Fetches /metrics from a gateway (or reads a saved scrape) and checks that it
+parses as Prometheus text format: "\\n" line ends only (a "\\r" makes the
+scraper reject the whole page), # HELP / # TYPE before each family's samples,
+and a numeric value on every sample line.
+
+Usage: python3 scripts/check_metrics.py <gateway-ip | http://host/metrics | file | ->
+Exits non-zero and lists the offending lines when the output is invalid.
+"""
+
+import re
+import sys
+import urllib.request
+
+SAMPLE = re.compile(
+    r'^([a-zA-Z_:][a-zA-Z0-9_:]*)'            # Metric name
+    r'(\{([a-zA-Z_][a-zA-Z0-9_]*="([^"\\]|\\.)*",?)*\})?'   # Labels
+    r' (-?[0-9.eE+-]+|NaN|[+-]Inf)$')         # Value
+SUFFIXES = ("_bucket", "_sum", "_count")
+
+
+def read_scrape(source):
+    if source == "-":
+        return sys.stdin.buffer.read()
+    if source.startswith("http://") or source.startswith("https://"):
+        url = source
+    elif "/" in source or source.endswith(".txt"):
+        with open(source, "rb") as f:
+            return f.read()
+    else:
+        url = "http://%s/metrics" % source
+    with urllib.request.urlopen(url, timeout=10) as response:
+        return response.read()
+
+
+def family_of(name, families):
+    if name in families:
+        return name
+    for suffix in SUFFIXES:
+        if name.endswith(suffix) and name[:-len(suffix)] in families:
+            return name[:-len(suffix)]
+    return None
+
+
+def check(data):
+    errors = []
+    if b"\r" in data:
+        errors.append("output contains '\\r' (lines must end with '\\n' only)")
+    if data and not data.endswith(b"\n"):
+        errors.append("output does not end with '\\n'")
+
+    typed = set()
+    for number, line in enumerate(data.decode("utf-8", "replace").split("\n"), 1):
+        line = line.rstrip("\r")
+        if not line:
+            continue
+        if line.startswith("# TYPE "):
+            typed.add(line.split(" ")[2])
+            continue
+        if line.startswith("#"):
+            continue
+        match = SAMPLE.match(line)
+        if not match:
+            errors.append("line %d: not a valid sample: %r" % (number, line))
+        elif family_of(match.group(1), typed) is None:
+            errors.append("line %d: %s has no # TYPE line before it" % (number, match.group(1)))
+    return errors
+
+
+def main():
+    if len(sys.argv) != 2:
+        print(__doc__.strip())
+        return 2
+
+    errors = check(read_scrape(sys.argv[1]))
+    for error in errors:
+        print("❌ " + error)
+    if errors:
+        return 1
+    print("✅ /metrics output is valid Prometheus text format")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
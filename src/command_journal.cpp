@@ -0,0 +1,278 @@
+/**
+ * Command Journal - LoRa Gateway
+ * Persists the command queue across reboots/OTA as an append-only
+ * LittleFS journal so pending sensor reconfigurations are not lost
+ */
+
+#include "command_journal.h"
+#include <LittleFS.h>
+
+#define JOURNAL_MAGIC 0x4A514D43   // "CMQJ"
+#define JOURNAL_VERSION 1
+
+enum JournalOp : uint8_t {
+    JOURNAL_OP_QUEUED = 0x01,
+    JOURNAL_OP_REMOVED = 0x02
+};
+
+struct JournalFileHeader {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t recordSize;       // sizeof(JournalRecord); changes with MAX_SENSORS
+} __attribute__((packed));
+
+// One journal record, followed by paramLen parameter bytes
+struct JournalRecord {
+    uint8_t op;
+    uint8_t checksum;         // XOR of record (checksum = 0) and params
+    uint8_t cmdType;
+    uint8_t paramLen;
+    uint32_t id;
+    uint64_t sensorId;
+    uint32_t stampSec;        // Journal clock: queue time or removal time
+    uint32_t deadlineSec;     // Journal clock: command deadline
+    uint8_t priority;         // CommandPriority class
+    uint8_t flags;            // QUEUED_FLAG_*
+    uint8_t pendingMembers[REGISTRY_SLOT_MASK_BYTES];  // Group members yet to ACK
+} __attribute__((packed));
+
+// Journal clock: seconds of gateway uptime accumulated across reboots
+// Restored from the newest record stamp, so it only stands still while
+// the gateway is off
+static uint32_t clockBaseSec = 0;
+static uint32_t clockBaseMs = 0;
+
+static int recordsSinceCompact = 0;
+
+/**
+ * Helper: Convert a millis() timestamp to journal clock seconds
+ */
+static uint32_t toJournalSec(uint32_t ms) {
+    return clockBaseSec + (int32_t)(ms - clockBaseMs) / 1000;
+}
+
+/**
+ * Helper: Convert journal clock seconds back to a millis() timestamp
+ * (unsigned wrap keeps now - result equal to the true age)
+ */
+static uint32_t fromJournalSec(uint32_t sec) {
+    return clockBaseMs + (int32_t)(sec - clockBaseSec) * 1000;
+}
+
+/**
+ * Helper: XOR checksum over record header and parameter bytes
+ */
+static uint8_t recordChecksum(const JournalRecord* rec, const uint8_t* params) {
+    const uint8_t* bytes = (const uint8_t*)rec;
+    uint8_t sum = 0;
+    for (size_t i = 0; i < sizeof(JournalRecord); i++) {
+        sum ^= bytes[i];
+    }
+    sum ^= rec->checksum;  // Checksum field itself is excluded
+    for (uint8_t i = 0; i < rec->paramLen; i++) {
+        sum ^= params[i];
+    }
+    return sum;
+}
+
+/**
+ * Helper: Build a journal record for a queued command
+ */
+static void initQueuedRecord(JournalRecord* rec, const QueuedCommand* cmd) {
+    rec->op = JOURNAL_OP_QUEUED;
+    rec->checksum = 0;
+    rec->cmdType = cmd->cmdType;
+    rec->paramLen = cmd->paramLen;
+    rec->id = cmd->id;
+    rec->sensorId = cmd->sensorId;
+    rec->stampSec = toJournalSec(cmd->queuedAt);
+    rec->deadlineSec = toJournalSec(cmd->deadline);
+    rec->priority = cmd->priority;
+    rec->flags = cmd->flags;
+    memcpy(rec->pendingMembers, cmd->pendingMembers, sizeof(rec->pendingMembers));
+    rec->checksum = recordChecksum(rec, cmd->params);
+}
+
+/**
+ * Helper: Append one record to the journal (one small flash write)
+ */
+static void appendRecord(const JournalRecord* rec, const uint8_t* params) {
+    File file = LittleFS.open(COMMAND_JOURNAL_FILE, "a");
+    if (!file) {
+        Serial.println("⚠️  [JOURNAL] Failed to open command journal for append");
+        return;
+    }
+
+    // New (or removed) file starts with the format header
+    if (file.size() == 0) {
+        JournalFileHeader header = { JOURNAL_MAGIC, JOURNAL_VERSION, sizeof(JournalRecord) };
+        file.write((const uint8_t*)&header, sizeof(header));
+    }
+
+    file.write((const uint8_t*)rec, sizeof(JournalRecord));
+    if (rec->paramLen > 0) {
+        file.write(params, rec->paramLen);
+    }
+    file.close();
+    recordsSinceCompact++;
+}
+
+/**
+ * Helper: Find queue index of command id, -1 if not present
+ */
+static int findCommand(const QueuedCommand* queue, int count, uint32_t id) {
+    for (int i = 0; i < count; i++) {
+        if (queue[i].id == id) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Restore queued commands by replaying the journal
+ */
+int restoreCommandJournal(QueuedCommand* queue, int maxCount) {
+    // Finish a compaction interrupted between remove and rename
+    if (!LittleFS.exists(COMMAND_JOURNAL_FILE) && LittleFS.exists(COMMAND_JOURNAL_TMP_FILE)) {
+        LittleFS.rename(COMMAND_JOURNAL_TMP_FILE, COMMAND_JOURNAL_FILE);
+    }
+
+    clockBaseMs = millis();
+    clockBaseSec = 0;
+
+    File file = LittleFS.open(COMMAND_JOURNAL_FILE, "r");
+    if (!file) {
+        return 0;
+    }
+
+    JournalFileHeader header;
+    if (file.read((uint8_t*)&header, sizeof(header)) != sizeof(header) ||
+        header.magic != JOURNAL_MAGIC || header.version != JOURNAL_VERSION ||
+        header.recordSize != sizeof(JournalRecord)) {
+        Serial.println("⚠️  [JOURNAL] Unknown command journal format, discarding");
+        file.close();
+        LittleFS.remove(COMMAND_JOURNAL_FILE);
+        return 0;
+    }
+
+    int count = 0;
+    int records = 0;
+    JournalRecord rec;
+    uint8_t params[sizeof(((QueuedCommand*)0)->params)];
+
+    while (file.read((uint8_t*)&rec, sizeof(rec)) == sizeof(rec)) {
+        if (rec.paramLen > sizeof(params) ||
+            file.read(params, rec.paramLen) != rec.paramLen ||
+            recordChecksum(&rec, params) != rec.checksum) {
+            // Torn write from a reset mid-append; everything before it is valid
+            Serial.println("⚠️  [JOURNAL] Truncated record at end of journal, ignoring");
+            break;
+        }
+        records++;
+
+        if (rec.stampSec > clockBaseSec) {
+            clockBaseSec = rec.stampSec;
+        }
+
+        int index = findCommand(queue, count, rec.id);
+        if (rec.op == JOURNAL_OP_QUEUED) {
+            if (index < 0) {
+                if (count >= maxCount) {
+                    continue;
+                }
+                index = count++;
+            }
+            QueuedCommand* cmd = &queue[index];
+            cmd->id = rec.id;
+            cmd->sensorId = rec.sensorId;
+            cmd->cmdType = rec.cmdType;
+            cmd->paramLen = rec.paramLen;
+            memcpy(cmd->params, params, rec.paramLen);
+            cmd->queuedAt = rec.stampSec;     // Rebased below once the clock is known
+            cmd->deadline = rec.deadlineSec;
+            cmd->retryCount = 0;
+            cmd->priority = rec.priority;
+            cmd->flags = rec.flags;
+            memcpy(cmd->pendingMembers, rec.pendingMembers, sizeof(rec.pendingMembers));
+        } else if (rec.op == JOURNAL_OP_REMOVED && index >= 0) {
+            for (int j = index; j < count - 1; j++) {
+                queue[j] = queue[j + 1];
+            }
+            count--;
+        }
+    }
+    file.close();
+
+    // Rebase queue times and deadlines from journal seconds onto this boot's millis()
+    for (int i = 0; i < count; i++) {
+        queue[i].queuedAt = fromJournalSec(queue[i].queuedAt);
+        queue[i].deadline = fromJournalSec(queue[i].deadline);
+    }
+
+    Serial.printf("📒 [JOURNAL] Replayed %d records, restored %d queued commands\n",
+                  records, count);
+    return count;
+}
+
+/**
+ * Record a new or updated queued command
+ */
+void journalCommandQueued(const QueuedCommand* cmd) {
+    JournalRecord rec;
+    initQueuedRecord(&rec, cmd);
+    appendRecord(&rec, cmd->params);
+}
+
+/**
+ * Record that a queued command was sent or expired
+ */
+void journalCommandRemoved(uint32_t id) {
+    JournalRecord rec = {};
+    rec.op = JOURNAL_OP_REMOVED;
+    rec.id = id;
+    rec.stampSec = toJournalSec(millis());
+    rec.checksum = recordChecksum(&rec, nullptr);
+    appendRecord(&rec, nullptr);
+}
+
+/**
+ * Rewrite the journal with only the live queue entries
+ * Written to a temp file and renamed so a reset never loses the journal
+ */
+void compactCommandJournal(const QueuedCommand* queue, int count) {
+    File file = LittleFS.open(COMMAND_JOURNAL_TMP_FILE, "w");
+    if (!file) {
+        Serial.println("⚠️  [JOURNAL] Failed to open temp file for compaction");
+        return;
+    }
+
+    JournalFileHeader header = { JOURNAL_MAGIC, JOURNAL_VERSION, sizeof(JournalRecord) };
+    file.write((const uint8_t*)&header, sizeof(header));
+
+    for (int i = 0; i < count; i++) {
+        JournalRecord rec;
+        initQueuedRecord(&rec, &queue[i]);
+        file.write((const uint8_t*)&rec, sizeof(rec));
+        file.write(queue[i].params, queue[i].paramLen);
+    }
+
+    // Clock record (id 0 is never assigned) carries the current journal time
+    JournalRecord clock = {};
+    clock.op = JOURNAL_OP_REMOVED;
+    clock.stampSec = toJournalSec(millis());
+    clock.checksum = recordChecksum(&clock, nullptr);
+    file.write((const uint8_t*)&clock, sizeof(clock));
+    file.close();
+
+    LittleFS.remove(COMMAND_JOURNAL_FILE);
+    LittleFS.rename(COMMAND_JOURNAL_TMP_FILE, COMMAND_JOURNAL_FILE);
+    recordsSinceCompact = count;
+}
+
+/**
+ * Number of records appended since the last compaction
+ */
+int getCommandJournalRecords() {
+    return recordsSinceCompact;
+}
@@ -0,0 +1,36 @@
+#ifndef COMMAND_JOURNAL_H
+#define COMMAND_JOURNAL_H
+
+#include <Arduino.h>
+#include "command_sender.h"
+
+// Append-only command queue journal on LittleFS
+// Every enqueue/update appends one queued record and every completion or
+// expiry one removed record; the live queue is rewritten (compacted)
+// on boot and whenever the journal grows past COMMAND_JOURNAL_COMPACT_RECORDS
+#define COMMAND_JOURNAL_FILE "/cmd_journal.bin"
+#define COMMAND_JOURNAL_TMP_FILE "/cmd_journal.tmp"
+
+#ifndef COMMAND_JOURNAL_COMPACT_RECORDS
+#define COMMAND_JOURNAL_COMPACT_RECORDS (4 * MAX_QUEUED_COMMANDS)
+#endif
+
+// Restore queued commands from the journal (call once LittleFS is mounted)
+// queuedAt/deadline are rebased onto millis() so each command keeps its remaining
+// lifetime; time the gateway spent powered off is not counted (no RTC)
+// Returns number of commands written to queue
+int restoreCommandJournal(QueuedCommand* queue, int maxCount);
+
+// Record a new or updated queued command (upsert by cmd->id)
+void journalCommandQueued(const QueuedCommand* cmd);
+
+// Record that a queued command was sent or expired
+void journalCommandRemoved(uint32_t id);
+
+// Rewrite the journal with only the live queue entries
+void compactCommandJournal(const QueuedCommand* queue, int count);
+
+// Number of records appended since the last compaction
+int getCommandJournalRecords();
+
+#endif // COMMAND_JOURNAL_H
@@ -7,63 +7,367 @@
 #include "lora_config.h"
 #include "lora_protocol.h"
 #include "device_config.h"
+#include "database_manager.h"
+#include "device_registry.h"
+#include "command_journal.h"
 #include <RadioLib.h>
+#include <vector>
 
 // Forward declarations - radio initialized in lora_receiver.cpp
-extern SX1262* getRadio();
 extern uint64_t getGatewayId();
 extern bool isRadioInitialized();
 extern SemaphoreHandle_t getRadioMutex();
+extern bool transmitFrame(uint8_t* data, size_t len);
+extern uint32_t getTimeOnAirMs(size_t len);
 
 // ====================================================================
 // Command Queue for Persistent Retry
 // ====================================================================
 
-struct QueuedCommand {
-    uint64_t sensorId;
-    uint8_t cmdType;
-    uint8_t params[238];
-    uint8_t paramLen;
-    uint32_t queuedAt;
-    uint8_t retryCount;
-};
-
 static QueuedCommand commandQueue[MAX_QUEUED_COMMANDS];
 static uint8_t queueSize = 0;
+static uint32_t nextCommandId = 1;
+
+// Queue is shared by the MQTT task, web server and serial console and
+// every change is journaled, so all access is serialized
+static SemaphoreHandle_t queueMutex = NULL;
+
+// Bumped on every queue change (under the lock) so the dashboard stream
+// knows when command queue info is stale
+static uint32_t queueVersion = 0;
+
+#define LOCK_QUEUE() if (queueMutex) xSemaphoreTake(queueMutex, portMAX_DELAY)
+#define UNLOCK_QUEUE() if (queueMutex) xSemaphoreGive(queueMutex)
+
+// Delivery statistics per priority class (updated under the queue lock)
+static CommandClassStats classStats[CMD_PRIORITY_COUNT];
+
+// Group sent to each sensor in CMD_SET_GROUP, by registry slot, held until
+// the sensor's MSG_COMMAND_ACK confirms it (updated under the queue lock)
+static uint8_t pendingSetGroup[MAX_SENSORS];
+static uint8_t pendingSetGroupMask[REGISTRY_SLOT_MASK_BYTES];
+
+// Downlink airtime token bucket (shared by every task that transmits commands)
+static uint32_t airtimeTokensMs = COMMAND_AIRTIME_BURST_MS;
+static uint32_t airtimeRefillAt = 0;
+static portMUX_TYPE airtimeMux = portMUX_INITIALIZER_UNLOCKED;
+
+/**
+ * Helper: Refill airtime tokens for elapsed time
+ * Caller must hold airtimeMux
+ */
+static void refillAirtime() {
+#if COMMAND_AIRTIME_DUTY_PERMILLE > 0
+    uint32_t now = millis();
+    uint32_t elapsed = now - airtimeRefillAt;
+    
+    if (elapsed >= (uint32_t)COMMAND_AIRTIME_BURST_MS * 1000 / COMMAND_AIRTIME_DUTY_PERMILLE) {
+        airtimeTokensMs = COMMAND_AIRTIME_BURST_MS;
+        airtimeRefillAt = now;
+        return;
+    }
+    
+    uint32_t earned = elapsed * COMMAND_AIRTIME_DUTY_PERMILLE / 1000;
+    if (earned > 0) {
+        airtimeTokensMs = min((uint32_t)COMMAND_AIRTIME_BURST_MS, airtimeTokensMs + earned);
+        airtimeRefillAt += earned * 1000 / COMMAND_AIRTIME_DUTY_PERMILLE;
+    }
+#endif
+}
+
+/**
+ * Helper: Downlink airtime currently available (ms)
+ */
+static uint32_t getAirtimeAvailableMs() {
+    if (COMMAND_AIRTIME_DUTY_PERMILLE == 0) {
+        return UINT32_MAX;  // No duty cycle limit in this region
+    }
+    portENTER_CRITICAL(&airtimeMux);
+    refillAirtime();
+    uint32_t available = airtimeTokensMs;
+    portEXIT_CRITICAL(&airtimeMux);
+    return available;
+}
+
+/**
+ * Helper: Take airtime from the budget, false if not enough is left
+ */
+static bool consumeAirtime(uint32_t airtimeMs) {
+    if (COMMAND_AIRTIME_DUTY_PERMILLE == 0) {
+        return true;
+    }
+    portENTER_CRITICAL(&airtimeMux);
+    refillAirtime();
+    bool ok = airtimeTokensMs >= airtimeMs;
+    if (ok) {
+        airtimeTokensMs -= airtimeMs;
+    }
+    portEXIT_CRITICAL(&airtimeMux);
+    return ok;
+}
+
+/**
+ * Charge airtime that was (or will be) used regardless of the budget
+ * Called from the RX task for ACKs, so it only takes the spinlock
+ */
+void chargeDownlinkAirtime(uint32_t airtimeMs) {
+    if (COMMAND_AIRTIME_DUTY_PERMILLE == 0) {
+        return;
+    }
+    portENTER_CRITICAL(&airtimeMux);
+    refillAirtime();
+    airtimeTokensMs = airtimeTokensMs > airtimeMs ? airtimeTokensMs - airtimeMs : 0;
+    portEXIT_CRITICAL(&airtimeMux);
+}
+
+uint32_t parseCommandDeadline(uint32_t seconds) {
+    if (seconds >= COMMAND_DEADLINE_MAX_MS / 1000) {
+        return COMMAND_DEADLINE_MAX_MS;
+    }
+    return seconds * 1000UL;
+}
+
+/**
+ * Helper: Priority class a command type belongs to by default
+ */
+static uint8_t defaultCommandPriority(uint8_t cmdType) {
+    switch (cmdType & CMD_TYPE_MASK) {
+        case CMD_RESTART:
+        case CMD_TIME_SYNC:
+        case CMD_OTA_START:
+            return CMD_PRIORITY_CRITICAL;
+        case CMD_STATUS:
+            return CMD_PRIORITY_STATUS;
+        default:
+            return CMD_PRIORITY_CONFIG;
+    }
+}
+
+/**
+ * Helper: Default deadline (from queue time) for a priority class
+ */
+static uint32_t defaultCommandDeadlineMs(uint8_t priority) {
+    switch (priority) {
+        case CMD_PRIORITY_CRITICAL: return COMMAND_DEADLINE_CRITICAL_MS;
+        case CMD_PRIORITY_STATUS: return COMMAND_DEADLINE_STATUS_MS;
+        default: return COMMAND_DEADLINE_CONFIG_MS;
+    }
+}
 
 /**
  * Initialize command sender
+ * Restores pending commands from the journal (LittleFS mounted by registry)
  */
 void initCommandSender() {
-    queueSize = 0;
-    Serial.println("[CMD] Command sender initialized with retry mechanism");
+    queueMutex = xSemaphoreCreateMutex();
+    if (queueMutex == NULL) {
+        Serial.println("❌ [CMD] Failed to create command queue mutex!");
+    }
+    
+    queueSize = restoreCommandJournal(commandQueue, MAX_QUEUED_COMMANDS);
+    for (int i = 0; i < queueSize; i++) {
+        if (commandQueue[i].id >= nextCommandId) {
+            nextCommandId = commandQueue[i].id + 1;
+        }
+    }
+    
+    // Start each boot with a journal holding only live commands
+    compactCommandJournal(commandQueue, queueSize);
+    
+    Serial.printf("[CMD] Command sender initialized with retry mechanism (%d restored)\n",
+                  queueSize);
 }
 
 /**
- * Add command to persistent queue
+ * Helper: True if a group command still waits for the member in slot
  */
-bool queueCommand(uint64_t sensorId, uint8_t cmdType, const uint8_t* params, uint8_t paramLen) {
-    if (queueSize >= MAX_QUEUED_COMMANDS) {
-        Serial.println("❌ [CMD] Command queue full!");
-        return false;
+static bool isMemberPending(const QueuedCommand* cmd, int slot) {
+    return slot >= 0 && isLoraGroupAddress(cmd->sensorId) &&
+           (cmd->pendingMembers[slot / 8] & (1 << (slot % 8)));
+}
+
+/**
+ * Helper: Number of group members a command still waits for
+ */
+static int countPendingMembers(const QueuedCommand* cmd) {
+    int count = 0;
+    for (int i = 0; i < REGISTRY_SLOT_MASK_BYTES; i++) {
+        count += __builtin_popcount(cmd->pendingMembers[i]);
+    }
+    return count;
+}
+
+/**
+ * Helper: True if a queued command is addressed to the sensor
+ * (directly, or as a group command it has not ACKed yet)
+ */
+static bool isCommandForSensor(const QueuedCommand* cmd, uint64_t sensorId, int slot) {
+    return cmd->sensorId == sensorId || isMemberPending(cmd, slot);
+}
+
+/**
+ * Helper: Note a CMD_SET_GROUP that was just sent to a sensor
+ * Sensors advertising LORA_CAP_COMMAND_ACK join the group in the registry
+ * once they ACK it; for the rest, sending it is the only confirmation.
+ * Returns the group to apply now, -1 if none. Caller must hold the queue lock
+ */
+static int noteSetGroupSent(const QueuedCommand* cmd, int slot, uint8_t capabilities) {
+    uint32_t groupId;
+    if ((cmd->cmdType & CMD_TYPE_MASK) != CMD_SET_GROUP || slot < 0 ||
+        !decodeCommandParam(cmd->cmdType, cmd->params, cmd->paramLen, &groupId)) {
+        return -1;
+    }
+    if (!(capabilities & LORA_CAP_COMMAND_ACK)) {
+        return groupId;
+    }
+    pendingSetGroup[slot] = groupId;
+    pendingSetGroupMask[slot / 8] |= 1 << (slot % 8);
+    return -1;
+}
+
+/**
+ * Helper: Format a TLV-encoded parameter as legacy ASCII decimal string
+ * Returns string length, 0 if params do not match the command schema
+ */
+static uint8_t formatLegacyParam(uint8_t cmdType, const uint8_t* params, uint8_t paramLen,
+                                 uint8_t* out, size_t outSize) {
+    uint32_t value;
+    if (!decodeCommandParam(cmdType, params, paramLen, &value)) {
+        return 0;
     }
     
-    // Check if same command already queued for this sensor
+    int len;
+    if ((cmdType & CMD_TYPE_MASK) == CMD_SET_BASELINE) {
+        // Baseline travels as Pa; legacy sensors expect hPa with 2 decimals
+        len = snprintf((char*)out, outSize, "%.2f", value / 100.0);
+    } else {
+        len = snprintf((char*)out, outSize, "%lu", value);
+    }
+    return (len > 0 && (size_t)len < outSize) ? len : 0;
+}
+
+/**
+ * Helper: Encode command parameters for what the sensor understands
+ * TLV parameters are sent as-is to sensors advertising LORA_CAP_PARAM_TLV
+ * and converted to ASCII decimal strings for legacy sensors
+ * The wire type never carries CMD_FLAG_TLV_PARAMS, so the opcode is the
+ * same for both encodings
+ * out must hold 238 bytes; returns encoded parameter length
+ */
+static uint8_t encodeForSensor(uint8_t capabilities, uint8_t cmdType, const uint8_t* params,
+                               uint8_t paramLen, uint8_t* outType, uint8_t* out) {
+    *outType = cmdType & CMD_TYPE_MASK;
+    if ((cmdType & CMD_FLAG_TLV_PARAMS) && !(capabilities & LORA_CAP_PARAM_TLV)) {
+        return formatLegacyParam(cmdType, params, paramLen, out, 16);
+    }
+    
+    if (paramLen > 0 && params) {
+        memcpy(out, params, paramLen);
+    }
+    return paramLen;
+}
+
+/**
+ * Helper: Send a (possibly TLV-encoded) command in the sensor's format
+ */
+static bool sendEncodedCommand(uint64_t sensorId, uint8_t cmdType, const uint8_t* params,
+                               uint8_t paramLen) {
+    uint8_t wireType;
+    uint8_t wireParams[238];
+    uint8_t wireLen = encodeForSensor(getDeviceCapabilities(sensorId), cmdType, params,
+                                      paramLen, &wireType, wireParams);
+    return sendCommand(sensorId, wireType, wireParams, wireLen);
+}
+
+/**
+ * Helper: Compact the journal once enough records have accumulated
+ * Caller must hold the queue lock
+ */
+static void maybeCompactJournal() {
+    if (getCommandJournalRecords() >= COMMAND_JOURNAL_COMPACT_RECORDS) {
+        compactCommandJournal(commandQueue, queueSize);
+    }
+}
+
+/**
+ * Helper: Index of the queued command of the same type for a sensor, -1 if none
+ * Caller must hold the queue lock
+ */
+static int findQueuedCommand(uint64_t sensorId, uint8_t cmdType) {
     for (int i = 0; i < queueSize; i++) {
-        if (commandQueue[i].sensorId == sensorId && commandQueue[i].cmdType == cmdType) {
-            Serial.println("⚠️  [CMD] Command already queued, updating timestamp");
-            commandQueue[i].queuedAt = millis();
-            commandQueue[i].retryCount = 0;
-            if (paramLen > 0 && params) {
-                memcpy(commandQueue[i].params, params, paramLen);
-                commandQueue[i].paramLen = paramLen;
-            }
-            return true;
+        if (commandQueue[i].sensorId == sensorId &&
+            (commandQueue[i].cmdType & CMD_TYPE_MASK) == (cmdType & CMD_TYPE_MASK)) {
+            return i;
         }
     }
+    return -1;
+}
+
+/**
+ * Helper: Resolve default priority/deadline and group members of a command
+ * Takes the registry lock, so call it before LOCK_QUEUE (lock order is
+ * registry -> queue). Returns false for a group without members
+ */
+static bool prepareCommand(uint64_t sensorId, uint8_t cmdType, uint8_t* priority,
+                           uint32_t* deadlineMs, uint8_t* members) {
+    if (*priority >= CMD_PRIORITY_COUNT) {
+        *priority = defaultCommandPriority(cmdType);
+    }
+    if (*deadlineMs == 0) {
+        *deadlineMs = defaultCommandDeadlineMs(*priority);
+    }
+    
+    // Group commands track every current member until it ACKs
+    memset(members, 0, REGISTRY_SLOT_MASK_BYTES);
+    if (isLoraGroupAddress(sensorId)) {
+        int memberCount = getGroupMemberMask(loraGroupId(sensorId), members);
+        if (memberCount == 0) {
+            Serial.printf("❌ [CMD] Group %d has no members\n", loraGroupId(sensorId));
+            return false;
+        }
+        Serial.printf("👥 [CMD] Group %d command for %d members\n", loraGroupId(sensorId), memberCount);
+    }
+    return true;
+}
+
+/**
+ * Helper: Queue a prepared command, replacing a queued one of the same type
+ * Caller must hold the queue lock
+ * Returns the command id, 0 if the queue is full
+ */
+static uint32_t enqueueCommand(uint64_t sensorId, uint8_t cmdType, const uint8_t* params,
+                               uint8_t paramLen, uint8_t priority, uint32_t deadlineMs,
+                               const uint8_t* members) {
+    // Check if same command already queued for this sensor
+    int existing = findQueuedCommand(sensorId, cmdType);
+    if (existing >= 0) {
+        QueuedCommand* cmd = &commandQueue[existing];
+        Serial.println("⚠️  [CMD] Command already queued, updating timestamp");
+        cmd->cmdType = cmdType;
+        cmd->queuedAt = millis();
+        cmd->retryCount = 0;
+        cmd->priority = priority;
+        cmd->deadline = cmd->queuedAt + deadlineMs;
+        cmd->flags = 0;
+        memcpy(cmd->pendingMembers, members, REGISTRY_SLOT_MASK_BYTES);
+        if (paramLen > 0 && params) {
+            memcpy(cmd->params, params, paramLen);
+            cmd->paramLen = paramLen;
+        }
+        queueVersion++;
+        journalCommandQueued(cmd);
+        maybeCompactJournal();
+        return cmd->id;
+    }
+    
+    if (queueSize >= MAX_QUEUED_COMMANDS) {
+        Serial.println("❌ [CMD] Command queue full!");
+        return 0;
+    }
     
     // Add new command to queue
     QueuedCommand* cmd = &commandQueue[queueSize];
+    cmd->id = nextCommandId++;
     cmd->sensorId = sensorId;
     cmd->cmdType = cmdType;
     cmd->paramLen = paramLen;
@@ -72,85 +376,422 @@ bool queueCommand(uint64_t sensorId, uint8_t cmdType, const uint8_t* params, uin
     }
     cmd->queuedAt = millis();
     cmd->retryCount = 0;
+    cmd->priority = priority;
+    cmd->deadline = cmd->queuedAt + deadlineMs;
+    cmd->flags = 0;
+    memcpy(cmd->pendingMembers, members, REGISTRY_SLOT_MASK_BYTES);
     queueSize++;
     
-    Serial.printf("✅ [CMD] Queued command 0x%02X for sensor 0x%016llX (%d in queue)\n", 
-                  cmdType, sensorId, queueSize);
+    queueVersion++;
+    journalCommandQueued(cmd);
+    maybeCompactJournal();
     
-    // Try sending immediately
-    sendCommand(sensorId, cmdType, params, paramLen);
+    Serial.printf("✅ [CMD] Queued command 0x%02X (%s, %lus) for sensor 0x%016llX (%d in queue)\n", 
+                  cmdType, getCommandPriorityName(priority), deadlineMs / 1000, sensorId, queueSize);
+    return cmd->id;
+}
+
+/**
+ * Add command to persistent queue
+ */
+bool queueCommand(uint64_t sensorId, uint8_t cmdType, const uint8_t* params, uint8_t paramLen,
+                  uint8_t priority, uint32_t deadlineMs) {
+    uint8_t members[REGISTRY_SLOT_MASK_BYTES];
+    if (!prepareCommand(sensorId, cmdType, &priority, &deadlineMs, members)) {
+        return false;
+    }
+    
+    LOCK_QUEUE();
+    bool replaced = findQueuedCommand(sensorId, cmdType) >= 0;
+    uint32_t id = enqueueCommand(sensorId, cmdType, params, paramLen, priority, deadlineMs, members);
+    UNLOCK_QUEUE();
+    
+    if (id == 0) {
+        return false;
+    }
+    
+    // Group commands wait for a member's RX window; try new sensor
+    // commands immediately (a replaced one is already being retried)
+    if (!replaced && !isLoraGroupAddress(sensorId)) {
+        sendEncodedCommand(sensorId, cmdType, params, paramLen);
+    }
     
     return true;
 }
 
 /**
- * Remove expired commands from queue
+ * Queue several commands as one unit: all of them or none
+ * Room is checked for the whole batch under one lock hold (requests that
+ * replace a queued command, or an earlier request of the batch, need no
+ * new entry), so a full queue rejects the batch before anything changes
+ */
+CommandBatchResult queueCommandBatch(const CommandRequest* requests, size_t count, uint32_t* ids,
+                                     size_t* failedIndex) {
+    if (count == 0) {
+        return BATCH_QUEUED;
+    }
+    
+    // Defaults and group members first (registry lock, see prepareCommand)
+    struct PreparedCommand {
+        uint8_t priority;
+        uint32_t deadlineMs;
+        uint8_t members[REGISTRY_SLOT_MASK_BYTES];
+    };
+    std::vector<PreparedCommand> prepared(count);
+    for (size_t i = 0; i < count; i++) {
+        prepared[i].priority = requests[i].priority;
+        prepared[i].deadlineMs = requests[i].deadlineMs;
+        if (!prepareCommand(requests[i].sensorId, requests[i].cmdType, &prepared[i].priority,
+                            &prepared[i].deadlineMs, prepared[i].members)) {
+            if (failedIndex) {
+                *failedIndex = i;
+            }
+            return BATCH_EMPTY_GROUP;
+        }
+    }
+    
+    LOCK_QUEUE();
+    
+    int needed = 0;
+    for (size_t i = 0; i < count; i++) {
+        bool replaces = findQueuedCommand(requests[i].sensorId, requests[i].cmdType) >= 0;
+        for (size_t j = 0; j < i && !replaces; j++) {
+            replaces = requests[j].sensorId == requests[i].sensorId &&
+                       (requests[j].cmdType & CMD_TYPE_MASK) == (requests[i].cmdType & CMD_TYPE_MASK);
+        }
+        if (!replaces) {
+            needed++;
+        }
+    }
+    
+    if (needed > MAX_QUEUED_COMMANDS) {
+        UNLOCK_QUEUE();
+        Serial.printf("❌ [CMD] Batch of %u needs %d queue entries, queue holds %d\n",
+                      (unsigned)count, needed, MAX_QUEUED_COMMANDS);
+        return BATCH_TOO_LARGE;
+    }
+    if (queueSize + needed > MAX_QUEUED_COMMANDS) {
+        UNLOCK_QUEUE();
+        Serial.printf("❌ [CMD] Batch of %u needs %d queue entries, %d free\n",
+                      (unsigned)count, needed, MAX_QUEUED_COMMANDS - queueSize);
+        return BATCH_QUEUE_FULL;
+    }
+    
+    for (size_t i = 0; i < count; i++) {
+        ids[i] = enqueueCommand(requests[i].sensorId, requests[i].cmdType,
+                                requests[i].params, requests[i].paramLen,
+                                prepared[i].priority, prepared[i].deadlineMs, prepared[i].members);
+    }
+    
+    UNLOCK_QUEUE();
+    
+    // Nothing is transmitted here: each sensor gets its commands in its next
+    // RX window (retryCommandsForSensor), instead of one radio attempt per
+    // request inside the caller
+    return BATCH_QUEUED;
+}
+
+/**
+ * Add command with a single TLV-encoded parameter to persistent queue
+ */
+bool queueCommandValue(uint64_t sensorId, uint8_t cmdType, uint32_t value,
+                       uint8_t priority, uint32_t deadlineMs) {
+    uint8_t params[sizeof(ParamTlv)];
+    uint8_t paramLen = encodeCommandParam(cmdType, value, params);
+    if (paramLen == 0) {
+        Serial.printf("❌ [CMD] Cannot encode value %lu for command 0x%02X\n", value, cmdType);
+        return false;
+    }
+    
+    return queueCommand(sensorId, cmdType | CMD_FLAG_TLV_PARAMS, params, paramLen,
+                        priority, deadlineMs);
+}
+
+/**
+ * Remove command at index from queue by shifting remaining items
+ * Caller must hold the queue lock
+ */
+static void removeQueuedCommand(int index) {
+    queueVersion++;
+    journalCommandRemoved(commandQueue[index].id);
+    for (int j = index; j < queueSize - 1; j++) {
+        commandQueue[j] = commandQueue[j + 1];
+    }
+    queueSize--;
+}
+
+/**
+ * Remove commands past their deadline from queue
+ * Caller must hold the queue lock
  */
 static void cleanExpiredCommands() {
     uint32_t now = millis();
     
     for (int i = queueSize - 1; i >= 0; i--) {
-        if (now - commandQueue[i].queuedAt > COMMAND_EXPIRATION_MS) {
-            Serial.printf("⏰ [CMD] Command 0x%02X expired for sensor 0x%016llX\n", 
-                          commandQueue[i].cmdType, commandQueue[i].sensorId);
+        if ((int32_t)(now - commandQueue[i].deadline) >= 0) {
+            Serial.printf("⏰ [CMD] Command 0x%02X (%s) expired for sensor 0x%016llX\n", 
+                          commandQueue[i].cmdType, getCommandPriorityName(commandQueue[i].priority),
+                          commandQueue[i].sensorId);
             
-            // Remove from queue by shifting remaining items
-            for (int j = i; j < queueSize - 1; j++) {
-                commandQueue[j] = commandQueue[j + 1];
+            if (isLoraGroupAddress(commandQueue[i].sensorId)) {
+                Serial.printf("   %d group member(s) never ACKed\n",
+                              countPendingMembers(&commandQueue[i]));
+            }
+            if (commandQueue[i].priority < CMD_PRIORITY_COUNT) {
+                classStats[commandQueue[i].priority].expired++;
             }
-            queueSize--;
+            removeQueuedCommand(i);
         }
     }
 }
 
+/**
+ * Helper: Queue indices of a sensor's commands (including pending group
+ * commands not in skipIds), ordered by priority class then earliest
+ * deadline (EDF within class)
+ * Caller must hold the queue lock; returns number of indices
+ */
+static int sortCommandsForSensor(uint64_t sensorId, int slot, const uint32_t* skipIds,
+                                 int skipCount, int* order) {
+    int count = 0;
+    for (int i = 0; i < queueSize; i++) {
+        if (!isCommandForSensor(&commandQueue[i], sensorId, slot)) {
+            continue;
+        }
+        bool skip = false;
+        for (int k = 0; k < skipCount; k++) {
+            skip |= (commandQueue[i].id == skipIds[k]);
+        }
+        if (skip) {
+            continue;
+        }
+        
+        // Insertion sort; the queue holds at most MAX_QUEUED_COMMANDS
+        const QueuedCommand* cmd = &commandQueue[i];
+        int pos = count++;
+        while (pos > 0) {
+            const QueuedCommand* prev = &commandQueue[order[pos - 1]];
+            bool before = cmd->priority < prev->priority ||
+                          (cmd->priority == prev->priority &&
+                           (int32_t)(cmd->deadline - prev->deadline) < 0);
+            if (!before) {
+                break;
+            }
+            order[pos] = order[pos - 1];
+            pos--;
+        }
+        order[pos] = i;
+    }
+    return count;
+}
+
+/**
+ * Helper: Record delivery latency of a transmitted command
+ * Caller must hold the queue lock
+ */
+static void recordCommandSent(const QueuedCommand* cmd) {
+    if (cmd->priority >= CMD_PRIORITY_COUNT) {
+        return;
+    }
+    uint32_t latencyMs = millis() - cmd->queuedAt;
+    CommandClassStats* stats = &classStats[cmd->priority];
+    stats->sent++;
+    stats->latencySumMs += latencyMs;
+    if (latencyMs > stats->latencyMaxMs) {
+        stats->latencyMaxMs = latencyMs;
+    }
+}
+
+static bool sendCommandBatch(uint64_t sensorId, const uint8_t* payload, uint8_t payloadLen,
+                             int count);
+
 /**
  * Retry queued commands for a specific sensor
  * Call this when sensor transmits (opens its RX window)
+ * Commands are taken by priority class, earliest deadline first, and packed
+ * into MSG_COMMAND_BATCH frames whose time-on-air fits both the remaining
+ * RX window and the gateway airtime budget; the rest wait for the next uplink
+ * 
+ * Group commands go to the group address the first time (every member in RX
+ * hears them), then to stragglers individually until each one ACKs
  */
-void retryCommandsForSensor(uint64_t sensorId) {
+void retryCommandsForSensor(uint64_t sensorId, uint32_t uplinkAt) {
+    // Legacy sensors only understand single MSG_COMMAND frames
+    uint8_t capabilities = getDeviceCapabilities(sensorId);
+    bool batchEnabled = COMMAND_BATCH_ENABLED && (capabilities & LORA_CAP_COMMAND_BATCH);
+    int slot = getDeviceSlot(sensorId);
+    uint32_t windowStart = uplinkAt + SENSOR_RX_DELAY_MS;
+    
+    // Group commands stay queued after TX; send each at most once per window
+    uint32_t sentGroupIds[MAX_QUEUED_COMMANDS];
+    int sentGroupCount = 0;
+    
+    // Registry group to apply once the queue lock is released
+    int joinedGroup = -1;
+    
+    LOCK_QUEUE();
     cleanExpiredCommands();
     
     bool foundCommands = false;
-    for (int i = 0; i < queueSize; i++) {
-        if (commandQueue[i].sensorId == sensorId) {
-            foundCommands = true;
-            commandQueue[i].retryCount++;
-            
-            Serial.printf("🔄 [CMD] Retrying command 0x%02X for sensor 0x%016llX (attempt %d)\n", 
-                          commandQueue[i].cmdType, sensorId, commandQueue[i].retryCount);
+    while (true) {
+        int order[MAX_QUEUED_COMMANDS];
+        int candidates = sortCommandsForSensor(sensorId, slot, sentGroupIds, sentGroupCount, order);
+        if (candidates == 0) {
+            break;
+        }
+        
+        // Frame goes to the group address if the first scheduled command is
+        // a group command that has not been broadcast yet
+        const QueuedCommand* first = &commandQueue[order[0]];
+        uint64_t destination = sensorId;
+        if (isLoraGroupAddress(first->sensorId) && !(first->flags & QUEUED_FLAG_BROADCAST_SENT) &&
+            (capabilities & LORA_CAP_GROUP_ADDR)) {
+            destination = first->sensorId;
+        }
+        
+        // Downlink airtime this frame may use
+        int32_t sinceOpen = (int32_t)(millis() - windowStart);
+        uint32_t elapsed = sinceOpen > 0 ? sinceOpen : 0;
+        uint32_t budgetMs = min(SENSOR_RX_WINDOW_MS - min(elapsed, (uint32_t)SENSOR_RX_WINDOW_MS),
+                                getAirtimeAvailableMs());
+        
+        // Fill one frame in schedule order, skipping commands that don't fit
+        uint32_t frameIds[MAX_BATCH_COMMANDS];
+        uint32_t frameQueuedAt[MAX_BATCH_COMMANDS];
+        int frameCount = 0;
+        uint8_t payloadLen = 0;
+        uint8_t payload[LORA_MAX_PAYLOAD_SIZE] = {0};
+        QueuedCommand single;
+        
+        for (int c = 0; c < candidates && frameCount < MAX_BATCH_COMMANDS; c++) {
+            QueuedCommand* cmd = &commandQueue[order[c]];
+            if (!batchEnabled && frameCount == 1) {
+                break;
+            }
+            if (destination != sensorId &&
+                (cmd->sensorId != destination || (cmd->flags & QUEUED_FLAG_BROADCAST_SENT))) {
+                continue;  // Group frame carries only this group's unsent commands
+            }
+            uint8_t wireType;
+            uint8_t wireParams[238];
+            uint8_t wireLen = encodeForSensor(capabilities, cmd->cmdType, cmd->params,
+                                              cmd->paramLen, &wireType, wireParams);
             
-            bool success = sendCommand(sensorId, commandQueue[i].cmdType, 
-                                      commandQueue[i].params, commandQueue[i].paramLen);
+            uint8_t savedLen = payloadLen;
+            uint8_t savedCount = payload[0];
+            bool fits = appendBatchCommand(payload, &payloadLen, wireType, wireParams, wireLen);
+            if (!fits && frameCount > 0) {
+                continue;  // Try smaller commands; this one goes in a later frame
+            }
             
-            if (success) {
-                // Remove from queue on successful transmission
-                Serial.printf("✅ [CMD] Command sent, removing from queue\n");
-                for (int j = i; j < queueSize - 1; j++) {
-                    commandQueue[j] = commandQueue[j + 1];
+            // Oversized commands are sent alone as a single MSG_COMMAND
+            size_t frameBytes = sizeof(LoRaPacketHeader) + (fits ? payloadLen : 2 + wireLen);
+            if (getTimeOnAirMs(frameBytes) > budgetMs) {
+                if (fits) {
+                    payloadLen = savedLen;
+                    payload[0] = savedCount;
                 }
-                queueSize--;
-                i--;  // Adjust index after removal
+                continue;
             }
             
-            // Small delay between retries
-            delay(50);
+            if (frameCount == 0) {
+                single = *cmd;
+            }
+            cmd->retryCount++;
+            queueVersion++;
+            Serial.printf("🔄 [CMD] Retrying command 0x%02X (%s) for sensor 0x%016llX (attempt %d)\n", 
+                          cmd->cmdType, getCommandPriorityName(cmd->priority), sensorId,
+                          cmd->retryCount);
+            frameIds[frameCount] = cmd->id;
+            frameQueuedAt[frameCount] = cmd->queuedAt;
+            frameCount++;
+            if (!fits) {
+                break;
+            }
+        }
+        
+        if (frameCount == 0) {
+            Serial.printf("⏳ [CMD] %d command(s) deferred: %lums airtime left in window/budget\n",
+                          candidates, budgetMs);
+            break;
+        }
+        foundCommands = true;
+        
+        // Radio TX can take seconds; don't block other queue users meanwhile
+        UNLOCK_QUEUE();
+        bool success;
+        if (frameCount == 1) {
+            // Single command keeps the plain MSG_COMMAND frame
+            uint8_t wireType;
+            uint8_t wireParams[238];
+            uint8_t wireLen = encodeForSensor(capabilities, single.cmdType, single.params,
+                                              single.paramLen, &wireType, wireParams);
+            success = sendCommand(destination, wireType, wireParams, wireLen);
+        } else {
+            success = sendCommandBatch(destination, payload, payloadLen, frameCount);
+        }
+        LOCK_QUEUE();
+        
+        if (!success) {
+            break;  // Keep everything queued for the next RX window
+        }
+        
+        // Remove sent commands, unless re-queued with new parameters during TX
+        Serial.printf("✅ [CMD] %d command(s) sent, removing from queue\n", frameCount);
+        for (int k = 0; k < frameCount; k++) {
+            for (int i = 0; i < queueSize; i++) {
+                QueuedCommand* cmd = &commandQueue[i];
+                if (cmd->id != frameIds[k] || cmd->queuedAt != frameQueuedAt[k]) {
+                    continue;
+                }
+                
+                if (isLoraGroupAddress(cmd->sensorId)) {
+                    // Group commands complete when every member has ACKed;
+                    // sensors without MSG_COMMAND_ACK count as done once sent
+                    sentGroupIds[sentGroupCount++] = cmd->id;
+                    if (destination != sensorId) {
+                        cmd->flags |= QUEUED_FLAG_BROADCAST_SENT;
+                    } else if (!(capabilities & LORA_CAP_COMMAND_ACK)) {
+                        cmd->pendingMembers[slot / 8] &= ~(1 << (slot % 8));
+                    }
+                    if (countPendingMembers(cmd) > 0) {
+                        queueVersion++;
+                        journalCommandQueued(cmd);
+                        break;
+                    }
+                }
+                int groupId = noteSetGroupSent(cmd, slot, capabilities);
+                if (groupId >= 0) {
+                    joinedGroup = groupId;
+                }
+                recordCommandSent(cmd);
+                removeQueuedCommand(i);
+                break;
+            }
         }
     }
     
     if (foundCommands && queueSize > 0) {
         Serial.printf("📋 [CMD] %d commands remaining in queue\n", queueSize);
     }
+    maybeCompactJournal();
+    UNLOCK_QUEUE();
+    
+    // Registry lock is taken before the queue lock, never inside it
+    if (joinedGroup >= 0) {
+        updateDeviceGroup(sensorId, joinedGroup);
+    }
 }
 
 /**
  * Helper: Create LoRa packet header
  */
-static void initCommandHeader(LoRaPacketHeader* header, uint64_t deviceId, 
+static void initCommandHeader(LoRaPacketHeader* header, uint8_t msgType, uint64_t deviceId, 
                                uint16_t seqNum, uint8_t payloadLen) {
     header->magic[0] = LORA_MAGIC_BYTE_1;
     header->magic[1] = LORA_MAGIC_BYTE_2;
     header->version = LORA_PROTOCOL_VERSION;
-    header->msgType = MSG_COMMAND;
+    header->msgType = msgType;
     header->deviceId = deviceId;
     header->sequenceNum = seqNum;
     header->payloadLen = payloadLen;
@@ -163,31 +804,55 @@ static void initCommandHeader(LoRaPacketHeader* header, uint64_t deviceId,
     }
 }
 
+// Sequence number for gateway → sensor command frames
+static uint16_t commandSeqNum = 0;
+
 /**
- * Send a command to a remote LoRa sensor
+ * Helper: Transmit a complete command frame and return radio to RX
  */
-bool sendCommand(uint64_t sensorId, uint8_t cmdType, const uint8_t* params, uint8_t paramLen) {
-    if (!isRadioInitialized()) {
-        Serial.println("❌ [COMMAND] LoRa radio not initialized!");
+static bool transmitCommandFrame(uint8_t* packet, size_t packetLen) {
+    SemaphoreHandle_t radioMutex = getRadioMutex();
+    
+    if (!radioMutex) {
+        Serial.println("❌ [COMMAND] Radio mutex not available!");
         return false;
     }
     
-    if (paramLen > 238) {
-        Serial.printf("❌ [COMMAND] Parameters too large: %d bytes (max 238)\n", paramLen);
+    // Respect the gateway downlink airtime budget
+    uint32_t airtimeMs = getTimeOnAirMs(packetLen);
+    if (!consumeAirtime(airtimeMs)) {
+        Serial.printf("⏳ [COMMAND] Airtime budget exhausted (%lums needed), deferring\n", airtimeMs);
         return false;
     }
     
-    SX1262* radio = getRadio();
-    uint64_t gatewayId = getGatewayId();
-    SemaphoreHandle_t radioMutex = getRadioMutex();
+    // Acquire radio mutex (wait up to 5 seconds to allow RX task to finish)
+    Serial.print("  Acquiring radio mutex... ");
+    if (xSemaphoreTake(radioMutex, pdMS_TO_TICKS(5000)) != pdTRUE) {
+        Serial.println("❌ Failed (timeout)!");
+        return false;
+    }
+    Serial.println("✅");
+
+    // Non-blocking TX; returns on the DIO1 TX done interrupt with RX restarted
+    Serial.print("  Transmitting... ");
+    bool success = transmitFrame(packet, packetLen);
+    xSemaphoreGive(radioMutex);
     
-    if (!radio) {
-        Serial.println("❌ [COMMAND] Radio pointer is null!");
+    Serial.println(success ? "✅ Success!" : "❌ Failed!");
+    return success;
+}
+
+/**
+ * Send a command to a remote LoRa sensor
+ */
+bool sendCommand(uint64_t sensorId, uint8_t cmdType, const uint8_t* params, uint8_t paramLen) {
+    if (!isRadioInitialized()) {
+        Serial.println("❌ [COMMAND] LoRa radio not initialized!");
         return false;
     }
     
-    if (!radioMutex) {
-        Serial.println("❌ [COMMAND] Radio mutex not available!");
+    if (paramLen > 238) {
+        Serial.printf("❌ [COMMAND] Parameters too large: %d bytes (max 238)\n", paramLen);
         return false;
     }
     
@@ -206,8 +871,7 @@ bool sendCommand(uint64_t sensorId, uint8_t cmdType, const uint8_t* params, uint
     uint8_t packet[sizeof(LoRaPacketHeader) + actualPayloadLen];
     LoRaPacketHeader* header = (LoRaPacketHeader*)packet;
 
-    static uint16_t commandSeqNum = 0;
-    initCommandHeader(header, sensorId, commandSeqNum++, actualPayloadLen);
+    initCommandHeader(header, MSG_COMMAND, sensorId, commandSeqNum++, actualPayloadLen);
 
     // Copy only the actual command data (not the full CommandPayload buffer)
     packet[sizeof(LoRaPacketHeader)] = cmd.cmdType;
@@ -221,60 +885,111 @@ bool sendCommand(uint64_t sensorId, uint8_t cmdType, const uint8_t* params, uint
     Serial.printf("  Type: 0x%02X, Params: %d bytes, Seq: %d\n", 
                   cmdType, paramLen, commandSeqNum - 1);
     
-    // Acquire radio mutex (wait up to 5 seconds to allow RX task to finish)
-    Serial.print("  Acquiring radio mutex... ");
-    if (xSemaphoreTake(radioMutex, pdMS_TO_TICKS(5000)) != pdTRUE) {
-        Serial.println("❌ Failed (timeout)!");
-        return false;
-    }
-    Serial.println("✅");
+    return transmitCommandFrame(packet, sizeof(packet));
+}
 
-    // Stop RX mode - must explicitly call standby when in continuous RX
-    Serial.print("  Stopping RX mode... ");
-    int state = radio->standby();
-    if (state != RADIOLIB_ERR_NONE) {
-        Serial.printf("❌ Failed! (code: %d)\n", state);
-        xSemaphoreGive(radioMutex);
+/**
+ * Send several commands to a sensor in one MSG_COMMAND_BATCH frame
+ * payload is a batch built with appendBatchCommand()
+ */
+static bool sendCommandBatch(uint64_t sensorId, const uint8_t* payload, uint8_t payloadLen,
+                             int count) {
+    if (!isRadioInitialized()) {
+        Serial.println("❌ [COMMAND] LoRa radio not initialized!");
         return false;
     }
-    Serial.println("✅");
-
-    // Wait for radio to be ready (BUSY pin should be LOW)
-    uint32_t timeout = millis() + 1000;
-    while (digitalRead(LORA_BUSY) == HIGH && millis() < timeout) {
-        delay(1);
+    
+    uint8_t packet[sizeof(LoRaPacketHeader) + LORA_MAX_PAYLOAD_SIZE];
+    memcpy(packet + sizeof(LoRaPacketHeader), payload, payloadLen);
+    
+    initCommandHeader((LoRaPacketHeader*)packet, MSG_COMMAND_BATCH, sensorId,
+                      commandSeqNum++, payloadLen);
+    
+    // Display command info
+    Serial.printf("\n[COMMAND TX] Sending batch to sensor: 0x%016llX\n", sensorId);
+    Serial.printf("  Commands: %d, Payload: %d bytes, Seq: %d\n", 
+                  count, payloadLen, commandSeqNum - 1);
+    
+    uint8_t offset = sizeof(CommandBatchHeader);
+    uint8_t cmdType, paramLen;
+    const uint8_t* params;
+    while (nextBatchCommand(payload, payloadLen, &offset, &cmdType, &params, &paramLen)) {
+        Serial.printf("    0x%02X (%s), Params: %d bytes\n",
+                      cmdType, getCommandName(cmdType), paramLen);
     }
+    
+    return transmitCommandFrame(packet, sizeof(LoRaPacketHeader) + payloadLen);
+}
 
-    if (digitalRead(LORA_BUSY) == HIGH) {
-        Serial.println("❌ Radio still BUSY after timeout!");
-        radio->startReceive();
-        xSemaphoreGive(radioMutex);
-        return false;
+/**
+ * Handle per-command results from a sensor's MSG_COMMAND_ACK
+ */
+void handleCommandAck(uint64_t sensorId, const CommandAckPayload* ack, uint8_t resultCount) {
+    Serial.printf("📨 [CMD] ACK from sensor 0x%016llX for seq %d (%d results)\n",
+                  sensorId, ack->ackSequenceNum, resultCount);
+    
+    // Any result (ok or failed) settles this member of a pending group command
+    int slot = getDeviceSlot(sensorId);
+    int joinedGroup = -1;
+    LOCK_QUEUE();
+    for (uint8_t r = 0; r < resultCount; r++) {
+        uint8_t ackType = ack->results[r].cmdType & CMD_TYPE_MASK;
+        
+        // The sensor is in its new group only once it confirms the change
+        if (ackType == CMD_SET_GROUP && slot >= 0 &&
+            (pendingSetGroupMask[slot / 8] & (1 << (slot % 8)))) {
+            pendingSetGroupMask[slot / 8] &= ~(1 << (slot % 8));
+            if (ack->results[r].status == CMD_RESULT_OK) {
+                joinedGroup = pendingSetGroup[slot];
+            }
+        }
+        
+        for (int i = queueSize - 1; i >= 0; i--) {
+            QueuedCommand* cmd = &commandQueue[i];
+            if (!isMemberPending(cmd, slot) || (cmd->cmdType & CMD_TYPE_MASK) != ackType) {
+                continue;
+            }
+            cmd->pendingMembers[slot / 8] &= ~(1 << (slot % 8));
+            int remaining = countPendingMembers(cmd);
+            Serial.printf("👥 [CMD] Group %d 0x%02X: %d member(s) still pending\n",
+                          loraGroupId(cmd->sensorId), ackType, remaining);
+            if (remaining > 0) {
+                queueVersion++;
+                journalCommandQueued(cmd);
+            } else {
+                recordCommandSent(cmd);
+                removeQueuedCommand(i);
+            }
+        }
+    }
+    maybeCompactJournal();
+    UNLOCK_QUEUE();
+    
+    if (joinedGroup >= 0) {
+        updateDeviceGroup(sensorId, joinedGroup);
+    }
+    
+    for (uint8_t i = 0; i < resultCount; i++) {
+        const CommandResult* result = &ack->results[i];
+        bool ok = (result->status == CMD_RESULT_OK);
+        Serial.printf("  %s 0x%02X (%s): status %d\n", ok ? "✅" : "❌",
+                      result->cmdType, getCommandName(result->cmdType), result->status);
+        dbManager.writeCommand(sensorId, result->cmdType, "", ok ? "confirmed" : "failed");
     }
+}
 
-    // Transmit command packet
-    Serial.print("  Transmitting... ");
-    state = radio->transmit((uint8_t*)packet, sizeof(packet));
-    
-    if (state == RADIOLIB_ERR_NONE) {
-        Serial.println("✅ Success!");
-        // Small delay before restarting RX
-        delay(10);
-        // Restart RX mode
-        radio->startReceive();
-        // Release mutex
-        xSemaphoreGive(radioMutex);
-        return true;
-    } else {
-        Serial.printf("❌ Failed! (code: %d)\n", state);
-        // Small delay before restarting RX
-        delay(10);
-        // Restart RX mode even on failure
-        radio->startReceive();
-        // Release mutex
-        xSemaphoreGive(radioMutex);
+/**
+ * Helper: Send a command with one numeric parameter immediately
+ */
+static bool sendCommandValue(uint64_t sensorId, uint8_t cmdType, uint32_t value) {
+    uint8_t params[sizeof(ParamTlv)];
+    uint8_t paramLen = encodeCommandParam(cmdType, value, params);
+    if (paramLen == 0) {
+        Serial.printf("❌ Cannot encode value %lu for command 0x%02X\n", value, cmdType);
         return false;
     }
+    
+    return sendEncodedCommand(sensorId, cmdType | CMD_FLAG_TLV_PARAMS, params, paramLen);
 }
 
 /**
@@ -288,12 +1003,7 @@ bool sendSetSleepCommand(uint64_t sensorId, uint32_t sleepSeconds) {
     
     Serial.printf("\n📡 Sending SET_SLEEP command: %lu seconds\n", sleepSeconds);
     
-    // Pack seconds as ASCII decimal string for readability in logs
-    char paramStr[16];
-    snprintf(paramStr, sizeof(paramStr), "%lu", sleepSeconds);
-    uint8_t paramLen = strlen(paramStr);
-    
-    return sendCommand(sensorId, CMD_SET_SLEEP, (uint8_t*)paramStr, paramLen);
+    return sendCommandValue(sensorId, CMD_SET_SLEEP, sleepSeconds);
 }
 
 /**
@@ -307,12 +1017,7 @@ bool sendSetIntervalCommand(uint64_t sensorId, uint32_t intervalSeconds) {
     
     Serial.printf("\n📡 Sending SET_INTERVAL command: %lu seconds\n", intervalSeconds);
     
-    // Pack seconds as ASCII decimal string
-    char paramStr[16];
-    snprintf(paramStr, sizeof(paramStr), "%lu", intervalSeconds);
-    uint8_t paramLen = strlen(paramStr);
-    
-    return sendCommand(sensorId, CMD_SET_INTERVAL, (uint8_t*)paramStr, paramLen);
+    return sendCommandValue(sensorId, CMD_SET_INTERVAL, intervalSeconds);
 }
 
 /**
@@ -350,12 +1055,8 @@ bool sendSetBaselineCommand(uint64_t sensorId, float baselineHpa) {
 
     Serial.printf("\n📡 Sending SET_BASELINE command: %.2f hPa\n", baselineHpa);
 
-    // Pack baseline as ASCII decimal string
-    char paramStr[16];
-    snprintf(paramStr, sizeof(paramStr), "%.2f", baselineHpa);
-    uint8_t paramLen = strlen(paramStr);
-
-    return sendCommand(sensorId, CMD_SET_BASELINE, (uint8_t*)paramStr, paramLen);
+    // Baseline travels as integer Pa (hPa * 100)
+    return sendCommandValue(sensorId, CMD_SET_BASELINE, (uint32_t)lroundf(baselineHpa * 100.0f));
 }
 
 /**
@@ -366,51 +1067,137 @@ bool sendClearBaselineCommand(uint64_t sensorId) {
     return sendCommand(sensorId, CMD_CLEAR_BASELINE, nullptr, 0);
 }
 
+/**
+ * Get readable name for a command type
+ */
+const char* getCommandName(uint8_t cmdType) {
+    switch (cmdType & CMD_TYPE_MASK) {
+        case CMD_SET_SLEEP: return "set_sleep";
+        case CMD_SET_INTERVAL: return "set_interval";
+        case CMD_RESTART: return "restart";
+        case CMD_STATUS: return "status";
+        case CMD_CALIBRATE: return "calibrate";
+        case CMD_SET_BASELINE: return "set_baseline";
+        case CMD_CLEAR_BASELINE: return "clear_baseline";
+        case CMD_OTA_START: return "ota_start";
+        case CMD_TIME_SYNC: return "time_sync";
+        case CMD_SET_GROUP: return "set_group";
+        default: return "unknown";
+    }
+}
+
+/**
+ * Parse a priority class name
+ */
+uint8_t parseCommandPriority(const char* name) {
+    if (name == nullptr) {
+        return CMD_PRIORITY_DEFAULT;
+    }
+    for (uint8_t p = 0; p < CMD_PRIORITY_COUNT; p++) {
+        if (strcmp(name, getCommandPriorityName(p)) == 0) {
+            return p;
+        }
+    }
+    return CMD_PRIORITY_DEFAULT;
+}
+
+/**
+ * Get readable name for a priority class
+ */
+const char* getCommandPriorityName(uint8_t priority) {
+    switch (priority) {
+        case CMD_PRIORITY_CRITICAL: return "critical";
+        case CMD_PRIORITY_CONFIG: return "config";
+        case CMD_PRIORITY_STATUS: return "status";
+        default: return "unknown";
+    }
+}
+
+/**
+ * Get delivery statistics for a priority class
+ */
+bool getCommandClassStats(uint8_t priority, CommandClassStats* stats) {
+    if (priority >= CMD_PRIORITY_COUNT) {
+        return false;
+    }
+    LOCK_QUEUE();
+    *stats = classStats[priority];
+    UNLOCK_QUEUE();
+    return true;
+}
+
 /**
  * Get number of queued commands for a specific sensor
  */
-int getQueuedCommandCount(uint64_t sensorId) {
+int getQueuedCommandCount(uint64_t sensorId, int slot) {
     int count = 0;
+    LOCK_QUEUE();
     for (int i = 0; i < queueSize; i++) {
-        if (commandQueue[i].sensorId == sensorId) {
+        if (isCommandForSensor(&commandQueue[i], sensorId, slot)) {
             count++;
         }
     }
+    UNLOCK_QUEUE();
     return count;
 }
 
 /**
  * Get JSON array of queued commands for a specific sensor
  */
-String getQueuedCommandsJson(uint64_t sensorId) {
+String getQueuedCommandsJson(uint64_t sensorId, int slot) {
     String result = "[";
     bool first = true;
     
+    LOCK_QUEUE();
     for (int i = 0; i < queueSize; i++) {
-        if (commandQueue[i].sensorId == sensorId) {
+        if (isCommandForSensor(&commandQueue[i], sensorId, slot)) {
             if (!first) result += ",";
             first = false;
             
-            // Map command type to readable name
-            const char* cmdName = "unknown";
-            switch (commandQueue[i].cmdType) {
-                case CMD_SET_SLEEP: cmdName = "set_sleep"; break;
-                case CMD_SET_INTERVAL: cmdName = "set_interval"; break;
-                case CMD_RESTART: cmdName = "restart"; break;
-                case CMD_STATUS: cmdName = "status"; break;
-                case CMD_CALIBRATE: cmdName = "calibrate"; break;
-                case CMD_SET_BASELINE: cmdName = "set_baseline"; break;
-                case CMD_CLEAR_BASELINE: cmdName = "clear_baseline"; break;
-            }
-            
             result += "{\"type\":\"";
-            result += cmdName;
+            result += getCommandName(commandQueue[i].cmdType);
+            result += "\"";
+            if (isLoraGroupAddress(commandQueue[i].sensorId)) {
+                result += ",\"group\":";
+                result += String(loraGroupId(commandQueue[i].sensorId));
+            }
+            result += ",\"priority\":\"";
+            result += getCommandPriorityName(commandQueue[i].priority);
             result += "\",\"retries\":";
             result += String(commandQueue[i].retryCount);
+            result += ",\"expires_in\":";
+            result += String((int32_t)(commandQueue[i].deadline - millis()) / 1000);
             result += "}";
         }
     }
+    UNLOCK_QUEUE();
     
     result += "]";
     return result;
 }
+
+/**
+ * Get a signature of a sensor's queued commands (ids and retry counts)
+ * Equal signatures mean the sensor's queue view did not change
+ */
+uint32_t getQueuedCommandsSignature(uint64_t sensorId, int slot) {
+    uint32_t hash = 2166136261u;  // FNV-1a
+    
+    LOCK_QUEUE();
+    for (int i = 0; i < queueSize; i++) {
+        if (isCommandForSensor(&commandQueue[i], sensorId, slot)) {
+            hash = (hash ^ commandQueue[i].id) * 16777619u;
+            hash = (hash ^ commandQueue[i].retryCount) * 16777619u;
+        }
+    }
+    UNLOCK_QUEUE();
+    
+    return hash;
+}
+
+/**
+ * Command queue version (changes whenever queued commands change)
+ */
+uint32_t getCommandQueueVersion() {
+    return queueVersion;
+}
@@ -3,15 +3,90 @@
 
 #include <Arduino.h>
 #include <stdint.h>
+#include "lora_protocol.h"
+#include "lora_config.h"
+#include "device_registry.h"
 
 // Maximum queued commands
 #define MAX_QUEUED_COMMANDS 10
 
-// Command expiration time (5 minutes)
-#define COMMAND_EXPIRATION_MS (5 * 60 * 1000)
+// Downlink priority classes (lower value is sent first)
+enum CommandPriority : uint8_t {
+    CMD_PRIORITY_CRITICAL = 0,   // restart, time sync, OTA
+    CMD_PRIORITY_CONFIG   = 1,   // sleep/interval/baseline changes
+    CMD_PRIORITY_STATUS   = 2,   // status requests
+    CMD_PRIORITY_COUNT,
+    CMD_PRIORITY_DEFAULT  = 0xFF // Use the class of the command type
+};
+
+// Default delivery deadline per class, measured from queue time
+#define COMMAND_DEADLINE_CRITICAL_MS (30 * 60 * 1000)
+#define COMMAND_DEADLINE_CONFIG_MS (5 * 60 * 1000)
+#define COMMAND_DEADLINE_STATUS_MS (2 * 60 * 1000)
+
+// Longest deadline a client may ask for (deadlines are compared as signed
+// millis() differences, so they must stay well under 24.8 days)
+#define COMMAND_DEADLINE_MAX_MS (24UL * 60 * 60 * 1000)
+
+// Sensor RX timing, measured from the uplink's reception: the sensor is
+// ready SENSOR_RX_DELAY_MS after it (display update + RX setup take ~2 s)
+// and listens for SENSOR_RX_WINDOW_MS; all downlink frames for one uplink
+// must finish transmitting within that window
+#ifndef SENSOR_RX_DELAY_MS
+#define SENSOR_RX_DELAY_MS 3000
+#endif
+#ifndef SENSOR_RX_WINDOW_MS
+#define SENSOR_RX_WINDOW_MS 1000
+#endif
+
+// Gateway downlink airtime budget (token bucket), charged for command
+// frames and ACKs. Refills at COMMAND_AIRTIME_DUTY_PERMILLE of wall time
+// (10 = 1% duty cycle, the EU868 limit); 0 turns the budget off, the
+// default outside duty-cycle regulated regions (US915 limits dwell time)
+#ifndef COMMAND_AIRTIME_DUTY_PERMILLE
+#if LORA_REGION == LORA_REGION_EU868
+#define COMMAND_AIRTIME_DUTY_PERMILLE 10
+#else
+#define COMMAND_AIRTIME_DUTY_PERMILLE 0
+#endif
+#endif
+#define COMMAND_AIRTIME_BURST_MS 5000
+
+// Pack several queued commands for one sensor into a single MSG_COMMAND_BATCH
+// frame (set to 0 for sensors that only understand single MSG_COMMAND frames)
+#ifndef COMMAND_BATCH_ENABLED
+#define COMMAND_BATCH_ENABLED 1
+#endif
+
+// QueuedCommand flags
+#define QUEUED_FLAG_BROADCAST_SENT 0x01  // Group frame already sent to the group address
+
+// Command waiting in the retry queue
+struct QueuedCommand {
+    uint32_t id;              // Unique command ID (journal key)
+    uint64_t sensorId;        // Target sensor, or a group address (loraGroupAddress)
+    uint8_t cmdType;
+    uint8_t params[238];
+    uint8_t paramLen;
+    uint32_t queuedAt;        // millis() when queued (rebased after reboot)
+    uint8_t retryCount;
+    uint8_t priority;         // CommandPriority class
+    uint32_t deadline;        // millis() after which the command expires
+    uint8_t flags;            // QUEUED_FLAG_*
+    uint8_t pendingMembers[REGISTRY_SLOT_MASK_BYTES];  // Group: registry slots yet to ACK
+};
+
+// Per-priority-class delivery statistics
+struct CommandClassStats {
+    uint32_t sent;            // Commands transmitted
+    uint32_t expired;         // Commands dropped at their deadline
+    uint64_t latencySumMs;    // Sum of queue-to-transmit latency
+    uint32_t latencyMaxMs;    // Worst queue-to-transmit latency
+};
 
 /**
  * Initialize command sender with retry mechanism
+ * Restores commands still pending from the LittleFS journal
  */
 void initCommandSender();
 
@@ -30,21 +105,135 @@ bool sendCommand(uint64_t sensorId, uint8_t cmdType, const uint8_t* params, uint
  * Queue a command for persistent retry until received
  * Command will be retried automatically on sensor activity
  * 
- * @param sensorId: 64-bit device ID of target sensor
- * @param cmdType: Command type (from lora_protocol.h)
+ * A group address (loraGroupAddress()) queues one entry for every current
+ * member of the group. It is sent once to the group address in the first
+ * member RX window (members advertising LORA_CAP_GROUP_ADDR), then retried
+ * individually to members that have not ACKed yet
+ * 
+ * @param sensorId: 64-bit device ID of target sensor or group address
+ * @param cmdType: Command type (from lora_protocol.h), may carry CMD_FLAG_TLV_PARAMS
  * @param params: Parameter data (binary)
  * @param paramLen: Length of parameter data (max 238 bytes)
+ * @param priority: CommandPriority class (default: class of cmdType)
+ * @param deadlineMs: Expire this long after queueing (0 = class default)
  * @return true if queued successfully, false if queue full
  */
-bool queueCommand(uint64_t sensorId, uint8_t cmdType, const uint8_t* params, uint8_t paramLen);
+bool queueCommand(uint64_t sensorId, uint8_t cmdType, const uint8_t* params, uint8_t paramLen,
+                  uint8_t priority = CMD_PRIORITY_DEFAULT, uint32_t deadlineMs = 0);
+
+// One command of a bulk submission (see queueCommandBatch)
+struct CommandRequest {
+    uint64_t sensorId;        // Target sensor or group address
+    uint8_t cmdType;          // May carry CMD_FLAG_TLV_PARAMS
+    uint8_t params[sizeof(ParamTlv)];
+    uint8_t paramLen;
+    uint8_t priority;         // CommandPriority class or CMD_PRIORITY_DEFAULT
+    uint32_t deadlineMs;      // 0 = class default
+};
+
+// Outcome of queueCommandBatch (nothing is queued unless BATCH_QUEUED)
+enum CommandBatchResult {
+    BATCH_QUEUED,
+    BATCH_QUEUE_FULL,         // Not enough free queue entries (capacity, retry later)
+    BATCH_TOO_LARGE,          // Needs more entries than the queue holds (never fits)
+    BATCH_EMPTY_GROUP         // A request targets a group without members (client error)
+};
+
+/**
+ * Queue several commands atomically: all of them or none
+ * A request for a sensor/command type that is already queued replaces it
+ * and keeps its id. Nothing is transmitted immediately; each sensor gets
+ * its commands in its next RX window
+ * 
+ * @param requests: Commands to queue
+ * @param count: Number of requests
+ * @param ids: Filled with the command id of each request (for tracking)
+ * @param failedIndex: Receives the request that failed for BATCH_EMPTY_GROUP
+ * @return BATCH_QUEUED if all were queued
+ */
+CommandBatchResult queueCommandBatch(const CommandRequest* requests, size_t count, uint32_t* ids,
+                                     size_t* failedIndex = nullptr);
+
+/**
+ * Queue a command carrying one numeric parameter for persistent retry
+ * The value is stored as a binary TLV parameter (see COMMAND_PARAM_SCHEMA)
+ * and converted to legacy ASCII at send time for sensors that do not
+ * advertise LORA_CAP_PARAM_TLV
+ * 
+ * @param sensorId: 64-bit device ID of target sensor
+ * @param cmdType: Command type with a parameter schema (e.g. CMD_SET_SLEEP)
+ * @param value: Parameter value in schema units (seconds, Pa, Unix time)
+ * @param priority: CommandPriority class (default: class of cmdType)
+ * @param deadlineMs: Expire this long after queueing (0 = class default)
+ * @return true if queued successfully, false if queue full or value invalid
+ */
+bool queueCommandValue(uint64_t sensorId, uint8_t cmdType, uint32_t value,
+                       uint8_t priority = CMD_PRIORITY_DEFAULT, uint32_t deadlineMs = 0);
+
+/**
+ * Parse a priority class name ("critical", "config", "status")
+ * 
+ * @param name: Class name from an MQTT/web request, may be nullptr
+ * @return CommandPriority, CMD_PRIORITY_DEFAULT if missing or unknown
+ */
+uint8_t parseCommandPriority(const char* name);
+
+/**
+ * Get readable name for a priority class (e.g. "critical")
+ */
+const char* getCommandPriorityName(uint8_t priority);
+
+/**
+ * Get delivery statistics for a priority class
+ * 
+ * @param priority: CommandPriority class
+ * @param stats: Filled with a copy of the counters
+ * @return false if priority is out of range
+ */
+bool getCommandClassStats(uint8_t priority, CommandClassStats* stats);
 
 /**
  * Retry queued commands for a specific sensor
  * Call this when a packet is received from the sensor
+ * Commands are picked by priority class, earliest deadline first, and
+ * packed into as few frames as fit the sensor's RX window and the
+ * gateway airtime budget (one MSG_COMMAND_BATCH for a typical reconfiguration)
  * 
  * @param sensorId: 64-bit device ID of sensor that just transmitted
+ * @param uplinkAt: millis() when its packet was received (the RX window
+ *                  opens SENSOR_RX_DELAY_MS later)
+ */
+void retryCommandsForSensor(uint64_t sensorId, uint32_t uplinkAt);
+
+/**
+ * Charge a transmission that bypasses the command queue (e.g. an ACK) to
+ * the downlink airtime budget; it is taken even if the budget is short
+ */
+void chargeDownlinkAirtime(uint32_t airtimeMs);
+
+/**
+ * Deadline in ms for a client-supplied deadline_sec
+ * 0 keeps the class default; values are clamped to COMMAND_DEADLINE_MAX_MS
+ */
+uint32_t parseCommandDeadline(uint32_t seconds);
+
+/**
+ * Handle a MSG_COMMAND_ACK from a sensor
+ * Logs per-command results and records them in the command history
+ * 
+ * @param sensorId: 64-bit device ID of sensor that sent the ACK
+ * @param ack: ACK payload (results beyond resultCount are ignored)
+ * @param resultCount: Number of valid entries in ack->results
  */
-void retryCommandsForSensor(uint64_t sensorId);
+void handleCommandAck(uint64_t sensorId, const CommandAckPayload* ack, uint8_t resultCount);
+
+/**
+ * Get readable name for a command type (e.g. "set_sleep")
+ * 
+ * @param cmdType: Command type (from lora_protocol.h)
+ * @return static string, "unknown" for unrecognised types
+ */
+const char* getCommandName(uint8_t cmdType);
 
 /**
  * Send CMD_SET_SLEEP command to sensor
@@ -116,16 +305,38 @@ bool sendClearBaselineCommand(uint64_t sensorId);
  * Get number of queued commands for a specific sensor
  * 
  * @param sensorId: 64-bit device ID of sensor
+ * @param slot: Registry slot of the sensor to include pending group
+ *              commands (-1 = direct commands only)
  * @return number of commands in queue for this sensor
  */
-int getQueuedCommandCount(uint64_t sensorId);
+int getQueuedCommandCount(uint64_t sensorId, int slot = -1);
 
 /**
  * Get JSON array of queued commands for a specific sensor
  * 
  * @param sensorId: 64-bit device ID of sensor
+ * @param slot: Registry slot of the sensor to include pending group
+ *              commands (-1 = direct commands only)
  * @return JSON string with array of command types
  */
-String getQueuedCommandsJson(uint64_t sensorId);
+String getQueuedCommandsJson(uint64_t sensorId, int slot = -1);
+
+/**
+ * Get a signature of the commands queued for a specific sensor
+ * Changes when one of its commands is queued, retried or removed
+ * 
+ * @param sensorId: 64-bit device ID of sensor
+ * @param slot: Registry slot of the sensor (-1 = direct commands only)
+ * @return hash to compare against a previously seen value
+ */
+uint32_t getQueuedCommandsSignature(uint64_t sensorId, int slot = -1);
+
+/**
+ * Get the command queue version
+ * Changes whenever a command is queued, retried, updated or removed
+ *
+ * @return counter to compare against a previously seen value
+ */
+uint32_t getCommandQueueVersion();
 
 #endif // COMMAND_SENDER_H
@@ -0,0 +1,351 @@
+// Generated by scripts/build_dashboard.py from web/dashboard.html - do not edit
+
+#ifndef DASHBOARD_HTML_H
+#define DASHBOARD_HTML_H
+
+#include <Arduino.h>
+
+#define DASHBOARD_HTML_ETAG "\"d8ff4dc46c944a6d\""
+#define DASHBOARD_HTML_SIZE 17583              // Minified, before gzip
+
+static const uint8_t dashboard_html_gz[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xbd, 0x3c, 0x5d, 0x73, 0xdb, 0x48,
+    0x72, 0xef, 0xfc, 0x15, 0xb3, 0x5c, 0xdf, 0x02, 0xbc, 0x25, 0x21, 0x90, 0x12, 0x75, 0x92, 0x28,
+    0xd2, 0x67, 0xcb, 0xf2, 0xad, 0x6e, 0x6d, 0xc9, 0x91, 0xe4, 0xec, 0x5d, 0x6d, 0xb9, 0x6c, 0x90,
+    0x18, 0x92, 0x58, 0x81, 0x00, 0x02, 0x80, 0x92, 0xb9, 0x3a, 0xbe, 0x5d, 0x5e, 0x52, 0x5b, 0xb9,
+    0xa4, 0x2e, 0x55, 0xf7, 0x92, 0xd4, 0x56, 0xaa, 0xf2, 0x9e, 0xd7, 0xfc, 0x9e, 0xfb, 0x03, 0xd9,
+    0x9f, 0x90, 0xee, 0x9e, 0x19, 0x60, 0xf0, 0x21, 0x4a, 0xf6, 0x3a, 0xb7, 0x2a, 0x8b, 0x20, 0x66,
+    0xa6, 0xa7, 0xbb, 0xa7, 0xbf, 0x7b, 0xb4, 0x87, 0x9f, 0x3d, 0x3b, 0x3b, 0xba, 0xfc, 0xfd, 0xab,
+    0x63, 0x36, 0x4f, 0x17, 0xfe, 0xa8, 0x71, 0xa8, 0x3e, 0xb8, 0xe3, 0xc2, 0xc7, 0x82, 0xa7, 0x0e,
+    0x9b, 0xcc, 0x9d, 0x38, 0xe1, 0xe9, 0xb0, 0xf9, 0xfa, 0xf2, 0x79, 0x67, 0xaf, 0xa9, 0x5e, 0x07,
+    0xce, 0x82, 0x0f, 0x9b, 0xd7, 0x1e, 0xbf, 0x89, 0xc2, 0x38, 0x6d, 0xb2, 0x49, 0x18, 0xa4, 0x3c,
+    0x80, 0x69, 0x37, 0x9e, 0x9b, 0xce, 0x87, 0x2e, 0xbf, 0xf6, 0x26, 0xbc, 0x43, 0x5f, 0xda, 0xcc,
+    0x0b, 0xbc, 0xd4, 0x73, 0xfc, 0x4e, 0x32, 0x71, 0x7c, 0x3e, 0xec, 0x5a, 0x36, 0x82, 0x49, 0xbd,
+    0xd4, 0xe7, 0xa3, 0x17, 0xe1, 0xb9, 0xc3, 0x7e, 0xe3, 0xa4, 0xfc, 0xc6, 0x59, 0xb1, 0x27, 0xee,
+    0xc2, 0x0b, 0x0e, 0xb7, 0xc4, 0x48, 0xe3, 0xd0, 0xf7, 0x82, 0x2b, 0x36, 0x8f, 0xf9, 0x74, 0xd8,
+    0x9c, 0xa7, 0x69, 0x94, 0x1c, 0x6c, 0x6d, 0x4d, 0x61, 0x9b, 0xc4, 0x9a, 0x85, 0xe1, 0xcc, 0xe7,
+    0x4e, 0xe4, 0x25, 0xd6, 0x24, 0x5c, 0x6c, 0x4d, 0x92, 0xa4, 0xf7, 0x78, 0xea, 0x2c, 0x3c, 0x7f,
+    0x35, 0x7c, 0x3d, 0x5e, 0x06, 0xe9, 0xf2, 0xe0, 0x66, 0x36, 0x4f, 0x7f, 0xbd, 0x6d, 0xdb, 0x83,
+    0x1d, 0xf8, 0xd7, 0x87, 0x7f, 0xbf, 0xb2, 0xed, 0x2f, 0x5c, 0x2f, 0x89, 0x7c, 0x67, 0x35, 0x4c,
+    0x6e, 0x9c, 0xa8, 0xc9, 0x62, 0xee, 0x0f, 0x9b, 0x49, 0xba, 0xf2, 0x79, 0x32, 0xe7, 0x3c, 0x45,
+    0x94, 0xe8, 0xdb, 0xa8, 0xf1, 0x4b, 0x76, 0xcb, 0x16, 0x4e, 0x3c, 0xf3, 0x82, 0x03, 0x66, 0x0f,
+    0x58, 0xe4, 0xb8, 0xae, 0x17, 0xcc, 0xe8, 0x79, 0x1c, 0xbe, 0xef, 0x24, 0xde, 0xf7, 0xf4, 0x75,
+    0x1c, 0xc6, 0x2e, 0x8f, 0x3b, 0xf0, 0x6a, 0xc0, 0xd6, 0x8d, 0x71, 0xe8, 0xae, 0xd8, 0x6d, 0x03,
+    0x11, 0xec, 0x08, 0x5c, 0x0e, 0x98, 0x21, 0xb0, 0x31, 0xda, 0x2c, 0x71, 0x82, 0xa4, 0x93, 0xf0,
+    0xd8, 0x9b, 0x0e, 0x1a, 0x63, 0x67, 0x72, 0x35, 0x8b, 0xc3, 0x65, 0xe0, 0x1e, 0xb0, 0xcf, 0xed,
+    0x29, 0xfe, 0x0c, 0x1a, 0x93, 0xd0, 0x0f, 0x63, 0xf8, 0xce, 0x6d, 0xfc, 0x19, 0x34, 0xc2, 0x6b,
+    0x1e, 0x4f, 0xfd, 0xf0, 0xe6, 0x80, 0xcd, 0x3d, 0xd7, 0xe5, 0xc1, 0xa0, 0xb1, 0x6e, 0x58, 0x4e,
+    0x14, 0x75, 0x90, 0xd1, 0x8e, 0x17, 0xf0, 0x18, 0x36, 0x93, 0x04, 0x1d, 0xb0, 0xa9, 0xcf, 0xdf,
+    0x0f, 0x1a, 0x73, 0xee, 0x01, 0xd9, 0x07, 0xac, 0x6b, 0xdb, 0xd7, 0x73, 0x5a, 0x90, 0x78, 0x2e,
+    0x1f, 0x3b, 0x38, 0x95, 0x4e, 0xe2, 0x80, 0xf5, 0xf6, 0xec, 0xe8, 0x7d, 0x09, 0x85, 0xae, 0x83,
+    0x3f, 0xf0, 0x52, 0xd0, 0x13, 0x4b, 0x20, 0xd1, 0x7b, 0x96, 0x84, 0xbe, 0xe7, 0xb2, 0xcf, 0x7b,
+    0x0e, 0xfe, 0x0c, 0xca, 0xdb, 0xe1, 0xef, 0x8e, 0xeb, 0xc5, 0x7c, 0x92, 0x7a, 0x21, 0xb0, 0x0a,
+    0x48, 0x58, 0x2e, 0x82, 0x1c, 0xf5, 0x0e, 0xcc, 0x74, 0x96, 0x69, 0xa8, 0x63, 0xd2, 0x41, 0xd1,
+    0x22, 0xdc, 0x33, 0xae, 0xf6, 0x04, 0x46, 0x8a, 0x99, 0x69, 0x1a, 0x2e, 0x6a, 0x77, 0xaf, 0x02,
+    0x99, 0x77, 0x01, 0x8e, 0x62, 0x9c, 0x6d, 0xbb, 0x3b, 0x53, 0x60, 0x24, 0x1d, 0x00, 0x1c, 0x11,
+    0x07, 0x20, 0xd6, 0x0e, 0x5f, 0xc8, 0x37, 0x37, 0x92, 0x37, 0x28, 0x0b, 0x0d, 0x71, 0xb8, 0xd9,
+    0x66, 0x7d, 0x44, 0xa0, 0x0a, 0xde, 0x4a, 0x96, 0x63, 0x12, 0x45, 0x6d, 0x97, 0xbd, 0xbd, 0xbd,
+    0xc2, 0x16, 0xb6, 0xb5, 0xd7, 0xaf, 0xec, 0x81, 0x72, 0x87, 0xf0, 0x66, 0x42, 0xac, 0x3b, 0x49,
+    0xea, 0xa4, 0xcb, 0xe4, 0x63, 0x69, 0xa6, 0xc5, 0x9d, 0x32, 0x22, 0x35, 0xe4, 0xda, 0xd6, 0xfe,
+    0x83, 0xc8, 0xed, 0x12, 0xbd, 0x29, 0x7f, 0x9f, 0x76, 0xd2, 0x18, 0xe4, 0x72, 0x1a, 0xc6, 0xf0,
+    0x76, 0x19, 0x45, 0x3c, 0x9e, 0x38, 0x09, 0x1f, 0x34, 0x7c, 0x9e, 0xa6, 0x80, 0x57, 0x12, 0x39,
+    0x13, 0x21, 0xf7, 0x56, 0xc6, 0x21, 0x81, 0x8c, 0x97, 0xf2, 0x05, 0xe0, 0x52, 0x86, 0xdb, 0x2b,
+    0xce, 0xf2, 0x9d, 0x31, 0xf7, 0x37, 0xf3, 0xae, 0x9e, 0x75, 0x25, 0xb8, 0x3b, 0x45, 0xb0, 0xd7,
+    0x8e, 0xbf, 0xd4, 0x39, 0x31, 0xad, 0xb2, 0xa1, 0x7a, 0x24, 0x3b, 0xf2, 0x48, 0x24, 0x8c, 0xb1,
+    0xe3, 0xce, 0xb8, 0xae, 0x40, 0x5e, 0x00, 0xc6, 0x86, 0x77, 0xc6, 0x7e, 0x38, 0xb9, 0x1a, 0xe4,
+    0xe7, 0x04, 0x5b, 0x83, 0x36, 0x69, 0x67, 0x15, 0x3b, 0xae, 0xb7, 0x4c, 0x14, 0xad, 0xf7, 0x10,
+    0x43, 0xcc, 0x2f, 0x6a, 0xfb, 0x6e, 0x7f, 0xba, 0xb3, 0x9b, 0x6b, 0x7b, 0xd7, 0x1e, 0xef, 0xef,
+    0x75, 0x2b, 0x98, 0x59, 0x80, 0x17, 0xe8, 0x79, 0x00, 0x9a, 0xc5, 0x5d, 0x40, 0xb3, 0x00, 0xe3,
+    0x57, 0xd3, 0xae, 0xdb, 0x75, 0x35, 0x8b, 0x31, 0xdd, 0x81, 0xff, 0xaa, 0x30, 0x40, 0x2f, 0x05,
+    0x08, 0xa0, 0xa4, 0x02, 0x63, 0x6f, 0xbb, 0xaf, 0x5b, 0x9d, 0x69, 0x7f, 0x9f, 0xdb, 0x63, 0x82,
+    0xb1, 0x00, 0xe3, 0xd2, 0x91, 0xd6, 0x1c, 0xed, 0x19, 0x28, 0x39, 0x90, 0x5b, 0xa7, 0xd5, 0x19,
+    0x97, 0xb6, 0x6d, 0x79, 0x42, 0x72, 0x59, 0xae, 0xe4, 0xa5, 0x93, 0xec, 0xf5, 0xeb, 0x27, 0xce,
+    0x7b, 0x1b, 0xce, 0xb3, 0x7b, 0x17, 0x67, 0xef, 0xd0, 0xe2, 0x12, 0x6c, 0xcb, 0xe5, 0xc9, 0x24,
+    0xf6, 0x22, 0xb4, 0x51, 0x1b, 0x85, 0x71, 0xff, 0x6e, 0x45, 0x4e, 0x78, 0x90, 0x84, 0x71, 0xd2,
+    0x99, 0xc5, 0x9e, 0xab, 0x4b, 0x0d, 0x7e, 0x1f, 0x34, 0xf0, 0x77, 0x07, 0x34, 0x02, 0xde, 0xa5,
+    0xbc, 0x23, 0xac, 0x20, 0x88, 0x48, 0xcc, 0x23, 0xee, 0xa4, 0x26, 0xf2, 0xaa, 0x33, 0xf5, 0x7c,
+    0xbf, 0xcd, 0xc0, 0xb9, 0x2d, 0x9c, 0xf7, 0xe6, 0x0e, 0x6a, 0x7f, 0x9b, 0x75, 0xa7, 0x71, 0xab,
+    0x05, 0xab, 0x9d, 0x48, 0xd9, 0x83, 0x6c, 0xa7, 0xce, 0xc4, 0x89, 0x2b, 0xe7, 0x5e, 0x36, 0xd3,
+    0x05, 0x49, 0xac, 0xb5, 0x2c, 0xb5, 0x26, 0x85, 0x54, 0xde, 0x13, 0x16, 0xdb, 0xf1, 0x7d, 0x20,
+    0x7c, 0x3b, 0x29, 0x6f, 0x7d, 0x30, 0xc7, 0xd3, 0x46, 0x04, 0xc4, 0x5e, 0x65, 0xa3, 0x43, 0x5e,
+    0x70, 0xee, 0xb8, 0xe8, 0x9e, 0x6c, 0xf8, 0xc1, 0x4d, 0x59, 0x3c, 0x1b, 0x3b, 0xa6, 0xdd, 0xee,
+    0x75, 0x7b, 0xed, 0x5e, 0xbf, 0xdf, 0x06, 0xb8, 0x2d, 0x1d, 0x6e, 0x26, 0x13, 0x25, 0x2f, 0xf2,
+    0xdd, 0x32, 0x49, 0xbd, 0xe9, 0x4a, 0x89, 0xdc, 0x01, 0x43, 0xb3, 0x03, 0x9a, 0xc8, 0xd3, 0x1b,
+    0x8e, 0x6e, 0xaf, 0xd6, 0x78, 0x49, 0x72, 0x4b, 0xa6, 0xa7, 0x64, 0x4f, 0x7b, 0xf5, 0xf6, 0x54,
+    0xa0, 0x83, 0xf1, 0x8b, 0x72, 0xd7, 0x4a, 0xce, 0x7a, 0xf5, 0x72, 0x56, 0xa6, 0x3e, 0x07, 0x82,
+    0xfa, 0x96, 0x3c, 0x58, 0x20, 0xe0, 0xc0, 0xf1, 0x9f, 0x3c, 0x72, 0x61, 0x56, 0x6a, 0xa9, 0x93,
+    0x9a, 0x5c, 0x11, 0x80, 0x3e, 0xfe, 0x68, 0x67, 0x5d, 0x6b, 0x99, 0xf6, 0x34, 0x08, 0x99, 0x09,
+    0xae, 0x1a, 0xaa, 0xaa, 0x1e, 0x54, 0x84, 0x1e, 0x01, 0x28, 0x63, 0x5b, 0xe0, 0x93, 0xdd, 0xdf,
+    0xcc, 0x28, 0xd2, 0x60, 0x49, 0x59, 0x1a, 0x46, 0xba, 0x6a, 0x2e, 0x16, 0x4e, 0xe0, 0x26, 0x1f,
+    0xaa, 0x43, 0x3d, 0xa1, 0x2d, 0x92, 0x73, 0x92, 0xc2, 0xf1, 0x12, 0x78, 0x16, 0x7c, 0x78, 0xc8,
+    0x85, 0x86, 0x1e, 0x9c, 0xfc, 0x0c, 0x19, 0x06, 0x02, 0x67, 0x76, 0xb7, 0xfb, 0x2e, 0x9f, 0xb5,
+    0x81, 0xbf, 0x7c, 0xdb, 0xd9, 0x73, 0xe0, 0x61, 0x7b, 0xbc, 0xd7, 0x9b, 0xee, 0xb6, 0x32, 0x82,
+    0x6e, 0xe6, 0xe0, 0xf0, 0x72, 0xa5, 0x0a, 0xc2, 0x80, 0x97, 0x4e, 0x41, 0x1e, 0x5c, 0xdd, 0x51,
+    0x4c, 0x96, 0x71, 0x82, 0x40, 0xa2, 0xd0, 0x03, 0x01, 0x8f, 0x1f, 0xe6, 0xb1, 0xab, 0x4a, 0xda,
+    0x4b, 0x72, 0x9a, 0x33, 0xf5, 0xd4, 0xdc, 0x37, 0x3d, 0x22, 0xf3, 0x7e, 0x6f, 0x76, 0x40, 0xf0,
+    0x5b, 0x65, 0x25, 0xed, 0x4b, 0x24, 0x85, 0x9a, 0xf6, 0xf7, 0xdb, 0xdd, 0x6d, 0xd0, 0xd5, 0x9d,
+    0x5d, 0xd0, 0xd3, 0x9d, 0x96, 0x06, 0xda, 0x01, 0x7f, 0x71, 0x0d, 0x27, 0xce, 0xea, 0x61, 0xdb,
+    0x2d, 0x8c, 0x75, 0xad, 0x71, 0x1a, 0x74, 0x5c, 0x27, 0x98, 0x21, 0x16, 0xec, 0x41, 0xcc, 0xdd,
+    0xdf, 0xef, 0x8e, 0xbb, 0x63, 0x78, 0x70, 0x27, 0xbd, 0xdd, 0xde, 0x6e, 0x0e, 0x26, 0x59, 0x4e,
+    0x26, 0x3c, 0x49, 0x1e, 0x0a, 0x47, 0x78, 0xd0, 0xb6, 0x72, 0x9d, 0x04, 0xc7, 0x0b, 0xa2, 0x65,
+    0xfa, 0x6d, 0xba, 0x8a, 0x20, 0x23, 0x09, 0x96, 0x8b, 0x31, 0x8f, 0x9b, 0x6f, 0x3e, 0x22, 0x14,
+    0x57, 0xfa, 0x55, 0x63, 0x3c, 0xb7, 0x1d, 0xfc, 0x29, 0x49, 0x78, 0x26, 0x01, 0x7b, 0x35, 0x67,
+    0xbf, 0x8b, 0xef, 0x64, 0xd0, 0x0d, 0xf1, 0xf8, 0x2f, 0x6a, 0x14, 0xa2, 0x36, 0x40, 0x91, 0x2a,
+    0xd2, 0x41, 0xac, 0x22, 0x20, 0x82, 0x14, 0x43, 0xe8, 0x03, 0x99, 0xc6, 0x80, 0xf5, 0x06, 0xf7,
+    0x99, 0x85, 0xde, 0x06, 0xb3, 0x50, 0x84, 0xaf, 0xec, 0x43, 0xa6, 0x8d, 0x32, 0x00, 0x2a, 0x99,
+    0xa5, 0xbd, 0x4a, 0xb0, 0xb3, 0x5f, 0x1f, 0x61, 0xd5, 0x99, 0xca, 0x4a, 0xf0, 0x4b, 0x41, 0x55,
+    0xef, 0x6f, 0x12, 0x54, 0xf9, 0xa1, 0xe3, 0x8a, 0xf0, 0x87, 0xc2, 0x5d, 0xc7, 0xf7, 0x66, 0x98,
+    0xa8, 0x70, 0xa1, 0x89, 0x39, 0x46, 0x64, 0x48, 0x0b, 0x26, 0x71, 0xdd, 0xf8, 0xf5, 0x15, 0x5f,
+    0x4d, 0x63, 0x70, 0x13, 0x09, 0xf0, 0xdd, 0x43, 0x43, 0x93, 0x86, 0x45, 0xbd, 0x88, 0x43, 0xa0,
+    0x8d, 0x9b, 0xdb, 0xbb, 0x36, 0xc8, 0x26, 0x49, 0x22, 0xd2, 0x0b, 0x73, 0x4b, 0xd9, 0x59, 0x31,
+    0xb8, 0x94, 0x42, 0x21, 0xf6, 0x9c, 0x67, 0xdc, 0xd3, 0xdd, 0xf6, 0x4e, 0xd5, 0x73, 0x49, 0x56,
+    0x81, 0xf4, 0xd4, 0x78, 0xe3, 0x02, 0x17, 0xfb, 0x28, 0x6c, 0x4e, 0xe0, 0x2d, 0x1c, 0x61, 0x3f,
+    0x08, 0xf9, 0x6e, 0x22, 0x55, 0x0a, 0x90, 0x99, 0x62, 0x3a, 0xce, 0x89, 0x3f, 0x69, 0xe8, 0x24,
+    0xe8, 0x67, 0xa2, 0x50, 0x59, 0x9b, 0xa9, 0xf7, 0x9e, 0xbb, 0x08, 0x53, 0x9c, 0xbc, 0x08, 0xed,
+    0x62, 0xe5, 0x19, 0xee, 0xcc, 0x1d, 0xeb, 0x15, 0xa3, 0x0b, 0x5a, 0x50, 0xcc, 0x75, 0x0a, 0xe2,
+    0xb8, 0x21, 0x4a, 0x29, 0x1a, 0xaf, 0x1d, 0x09, 0x46, 0xc5, 0x18, 0xf4, 0x63, 0xf5, 0x5b, 0x0f,
+    0x8c, 0xfb, 0xbf, 0xef, 0x78, 0x81, 0x4b, 0x61, 0xac, 0x6d, 0xe3, 0x77, 0x9d, 0x39, 0xb0, 0x2b,
+    0x3f, 0x09, 0x28, 0x0a, 0x62, 0x1c, 0xb2, 0x9f, 0x4e, 0xb8, 0x4c, 0x41, 0xfe, 0x41, 0xf8, 0x55,
+    0xc6, 0xdc, 0x57, 0xb1, 0x19, 0x31, 0xcb, 0xd2, 0xec, 0x55, 0x31, 0x38, 0x92, 0x62, 0xc7, 0xea,
+    0x64, 0x93, 0x65, 0xcb, 0x79, 0x1c, 0x87, 0x71, 0x75, 0xb1, 0x0c, 0xe2, 0x59, 0x5d, 0xa4, 0xcf,
+    0x8a, 0xb2, 0x28, 0x31, 0x06, 0xfb, 0x16, 0x87, 0x8b, 0x3b, 0x0c, 0xf5, 0xef, 0x4c, 0x20, 0x1c,
+    0xbd, 0x00, 0x0b, 0x31, 0x89, 0x4b, 0x57, 0x54, 0xbc, 0x58, 0x57, 0x24, 0x58, 0x5b, 0x60, 0xeb,
+    0x93, 0xbb, 0x42, 0x98, 0xcb, 0xdb, 0x9e, 0x2d, 0xd3, 0xfb, 0xf6, 0xad, 0x82, 0xd9, 0xb0, 0x67,
+    0x3d, 0x92, 0xeb, 0xc6, 0xe1, 0x96, 0xac, 0xc4, 0x1c, 0x6e, 0xc9, 0x52, 0x14, 0x56, 0x57, 0xe0,
+    0xc3, 0xf5, 0xae, 0xd9, 0xc4, 0x77, 0x92, 0x64, 0xd8, 0x2c, 0xd4, 0x42, 0x9a, 0xc5, 0x31, 0x99,
+    0xc8, 0xd7, 0xbf, 0x95, 0x91, 0x28, 0x0e, 0xce, 0xbb, 0xa3, 0x9f, 0x7e, 0xfc, 0xe1, 0x5f, 0x98,
+    0x5e, 0x84, 0x82, 0x2d, 0xbb, 0xa5, 0x75, 0xb2, 0x0c, 0xd0, 0x1c, 0x51, 0x7d, 0x8a, 0x3d, 0x73,
+    0x92, 0xf9, 0x38, 0x84, 0x30, 0xf9, 0x70, 0x0b, 0x66, 0x21, 0x92, 0xe2, 0x43, 0x5b, 0x52, 0xcc,
+    0xfc, 0xcb, 0x78, 0x68, 0x19, 0x7d, 0x73, 0xa4, 0x6a, 0x5f, 0x17, 0xf4, 0xb6, 0x06, 0x96, 0x96,
+    0x73, 0xd7, 0x03, 0x22, 0x23, 0xde, 0x1c, 0x5d, 0xac, 0x12, 0x98, 0x72, 0x37, 0x00, 0x0a, 0xe5,
+    0xa8, 0xca, 0x85, 0x5e, 0xa4, 0x38, 0x46, 0x19, 0x63, 0x73, 0xf4, 0xd7, 0xbf, 0xfc, 0x89, 0x9d,
+    0x9d, 0xbe, 0x38, 0x39, 0x3d, 0x86, 0x13, 0x80, 0x59, 0x39, 0x6d, 0x1f, 0x8f, 0xd6, 0xc9, 0x2b,
+    0xf6, 0xc4, 0x75, 0x63, 0x50, 0x99, 0xfb, 0x50, 0x63, 0x9e, 0x9b, 0x73, 0xce, 0x8b, 0x9a, 0xa3,
+    0x17, 0xc2, 0x7a, 0x5b, 0x96, 0xf5, 0xf3, 0xd1, 0xf8, 0xc6, 0x7b, 0xee, 0xb1, 0x0b, 0x30, 0xff,
+    0x8e, 0xff, 0x20, 0x3c, 0x6e, 0xbc, 0xa9, 0xd7, 0x89, 0x93, 0xc4, 0xfb, 0xb4, 0x68, 0xbc, 0x86,
+    0x3c, 0x74, 0xc1, 0x1f, 0x84, 0xc1, 0x92, 0xa6, 0x7e, 0xda, 0xed, 0x9f, 0xc7, 0x9c, 0xb3, 0x97,
+    0x7c, 0x11, 0xc6, 0xab, 0x07, 0xe1, 0x30, 0x85, 0xf9, 0x9d, 0x05, 0x02, 0xfd, 0x94, 0x58, 0x3c,
+    0x73, 0x52, 0x67, 0x0c, 0xb6, 0xf6, 0xe7, 0xc8, 0x2a, 0xa1, 0xe7, 0x8e, 0x33, 0x0d, 0x43, 0xd1,
+    0x3d, 0xfa, 0xea, 0xf8, 0xe8, 0xeb, 0x93, 0xd3, 0xdf, 0x7c, 0x3a, 0xe1, 0x25, 0xc3, 0x00, 0x4c,
+    0xfb, 0x87, 0x25, 0x0f, 0x26, 0xf7, 0xb2, 0x6c, 0xb4, 0xdf, 0xed, 0xb3, 0x97, 0x5f, 0x7d, 0xff,
+    0xf3, 0xf7, 0x7d, 0x22, 0xa2, 0xf0, 0x0b, 0x51, 0x77, 0x78, 0xd0, 0x51, 0xa9, 0xf4, 0x1d, 0x7c,
+    0x47, 0xda, 0x1c, 0xd9, 0x25, 0x1c, 0xee, 0xc4, 0x48, 0x2f, 0xf7, 0x94, 0x50, 0x2a, 0x16, 0x52,
+    0xc8, 0x5e, 0xf6, 0x46, 0x47, 0x59, 0x59, 0x2a, 0x43, 0x0e, 0xde, 0x16, 0xd6, 0x69, 0x05, 0x97,
+    0xe6, 0xe8, 0x65, 0x08, 0xc1, 0x06, 0x78, 0x3c, 0x88, 0x39, 0xa9, 0x47, 0x10, 0x87, 0x3e, 0x5b,
+    0x85, 0xcb, 0x58, 0xd8, 0x5c, 0x81, 0x34, 0x0b, 0x20, 0xd9, 0x0f, 0xe3, 0xab, 0x1a, 0x2c, 0x73,
+    0xca, 0x92, 0x66, 0x46, 0xbb, 0x56, 0x8d, 0x29, 0xa1, 0x2c, 0xe3, 0xbd, 0x32, 0x6f, 0x45, 0x48,
+    0xd6, 0x1c, 0x29, 0xc8, 0x91, 0x12, 0x67, 0x89, 0x40, 0x42, 0x62, 0x1d, 0x6d, 0xe2, 0x53, 0x89,
+    0x19, 0x8c, 0x1c, 0x14, 0xb2, 0x2f, 0x0f, 0xea, 0x29, 0x86, 0x93, 0x6c, 0x3a, 0xe7, 0x18, 0x64,
+    0xb2, 0xe3, 0x6b, 0xf8, 0x7d, 0x1f, 0x8b, 0x84, 0xe1, 0x26, 0x0e, 0x89, 0xb6, 0x09, 0xe3, 0xb8,
+    0x8c, 0xf9, 0xe1, 0x2c, 0x61, 0xe4, 0x6c, 0xdd, 0x92, 0xc2, 0x94, 0x18, 0x44, 0xd3, 0x93, 0x0c,
+    0xa7, 0xba, 0x00, 0x8d, 0xd5, 0x85, 0xda, 0xac, 0x58, 0x35, 0x62, 0x3a, 0x31, 0x3d, 0x45, 0xcc,
+    0xcf, 0xe1, 0xae, 0x40, 0xec, 0x0e, 0xe6, 0x16, 0x3f, 0x04, 0x3f, 0x46, 0x8d, 0xe9, 0x32, 0xa0,
+    0x76, 0x02, 0xc3, 0x60, 0xc1, 0x49, 0x2f, 0xc1, 0x04, 0x9a, 0x09, 0x56, 0x32, 0xdd, 0xa4, 0x05,
+    0xb1, 0x87, 0x37, 0x65, 0xea, 0x2b, 0x3b, 0x64, 0xbb, 0x76, 0x8b, 0xc5, 0x3c, 0x5d, 0xc6, 0x01,
+    0x53, 0x2f, 0xbf, 0x64, 0x46, 0xc2, 0x9c, 0x59, 0x68, 0x60, 0x4c, 0x1a, 0x40, 0x70, 0x8b, 0x1e,
+    0x7b, 0xc8, 0x5e, 0x3a, 0xe9, 0xdc, 0x9a, 0xfa, 0x61, 0x18, 0x67, 0xcb, 0xb7, 0x70, 0xf9, 0x80,
+    0x20, 0xe2, 0x9c, 0x02, 0x34, 0x7c, 0x01, 0x90, 0x16, 0x05, 0x48, 0xf3, 0xb8, 0x08, 0x08, 0x27,
+    0x69, 0x40, 0x60, 0xf8, 0x90, 0xf5, 0x76, 0x32, 0x18, 0xf0, 0x1d, 0x40, 0xcc, 0x0b, 0x20, 0x5c,
+    0x67, 0x95, 0x14, 0x81, 0xc0, 0xac, 0x2d, 0x5c, 0x05, 0x41, 0xb6, 0x58, 0x46, 0x53, 0x60, 0xa1,
+    0x2b, 0x17, 0xae, 0xb1, 0x1c, 0xcf, 0x84, 0x33, 0x78, 0x0a, 0x32, 0x00, 0xcb, 0x83, 0xa5, 0xef,
+    0x0f, 0xca, 0x9c, 0xba, 0xe0, 0x3c, 0x30, 0xe1, 0x44, 0xe8, 0xa1, 0x45, 0x95, 0x4e, 0xdc, 0xd1,
+    0x99, 0xe1, 0x0a, 0xb0, 0xb8, 0xdc, 0x0a, 0xc2, 0x1b, 0xb3, 0xc5, 0x3a, 0x3a, 0xac, 0x0e, 0x53,
+    0x2b, 0x04, 0x0d, 0xfa, 0x36, 0x43, 0xb1, 0x11, 0xfb, 0xc3, 0x1f, 0x08, 0xc8, 0x21, 0xcb, 0xd9,
+    0x63, 0xbc, 0x0e, 0xae, 0x00, 0x5a, 0x60, 0x0c, 0x18, 0xdb, 0xda, 0x62, 0xa7, 0x61, 0xca, 0x56,
+    0x80, 0x64, 0xb2, 0x0a, 0x26, 0xdc, 0x6d, 0x33, 0xd0, 0xe8, 0x31, 0x07, 0xac, 0x38, 0xcc, 0x1f,
+    0x87, 0x61, 0xaa, 0x48, 0xd3, 0x8e, 0x54, 0xe3, 0x00, 0x02, 0xdf, 0xa2, 0xd0, 0xbc, 0x45, 0x85,
+    0x88, 0x12, 0x5d, 0xc2, 0x63, 0x9a, 0x8b, 0x24, 0xa7, 0x09, 0x4e, 0xb0, 0x74, 0x12, 0x89, 0x82,
+    0x70, 0x37, 0xa3, 0x71, 0xd1, 0x16, 0xdb, 0xdb, 0xdd, 0xd1, 0x66, 0xcd, 0xe3, 0xd2, 0x24, 0x9a,
+    0xf5, 0x0b, 0x39, 0x0b, 0xa6, 0x43, 0x6a, 0x97, 0xcf, 0x86, 0xf3, 0xae, 0x9f, 0x4e, 0xb3, 0x94,
+    0x28, 0x64, 0x28, 0xe2, 0x5c, 0x31, 0xbe, 0x6b, 0x0b, 0xee, 0x12, 0x52, 0x23, 0xe4, 0xe3, 0xad,
+    0x62, 0xc9, 0xbb, 0x47, 0xb7, 0xf8, 0x76, 0xed, 0xb2, 0x47, 0xb7, 0x80, 0xcd, 0x7a, 0x0e, 0x9f,
+    0xb8, 0xcf, 0x7a, 0xf1, 0x0e, 0x79, 0x91, 0xcf, 0x2a, 0x0e, 0xc2, 0x03, 0xee, 0xb0, 0x4e, 0xde,
+    0x15, 0x38, 0x16, 0x73, 0xc8, 0x73, 0x62, 0x19, 0x51, 0x9a, 0x68, 0x35, 0x94, 0xce, 0xe0, 0xb3,
+    0x25, 0x4e, 0x37, 0xe7, 0xe3, 0xd4, 0x8b, 0xe1, 0xf7, 0x90, 0xd5, 0x9c, 0xfa, 0xa0, 0x51, 0x90,
+    0xb8, 0x82, 0xfc, 0x68, 0xb0, 0x04, 0x5d, 0x04, 0xa7, 0x25, 0x77, 0x97, 0x6e, 0xc1, 0xa4, 0xb3,
+    0x74, 0xc3, 0xc9, 0x72, 0x01, 0x36, 0xc0, 0x9a, 0xf1, 0xf4, 0xd8, 0xe7, 0xf8, 0xf8, 0x74, 0x75,
+    0xe2, 0x9a, 0x46, 0x1e, 0xe6, 0x19, 0x2d, 0x0b, 0x73, 0xf3, 0x23, 0xd9, 0x71, 0x18, 0x0a, 0xf0,
+    0x5e, 0x84, 0x72, 0x97, 0xcb, 0xd9, 0xdd, 0x90, 0xb2, 0x40, 0xad, 0x1e, 0x10, 0x0e, 0xbf, 0xc5,
+    0x61, 0xf6, 0xb8, 0xfc, 0x02, 0x94, 0x8c, 0xb9, 0x4f, 0x17, 0x06, 0x3b, 0x78, 0xd0, 0x46, 0x2a,
+    0x16, 0xaa, 0xdf, 0x07, 0x47, 0xdf, 0x82, 0x73, 0x88, 0x60, 0x1f, 0x92, 0x10, 0x32, 0xc0, 0x66,
+    0x69, 0x0c, 0xa5, 0x14, 0x4d, 0x04, 0x6e, 0xfd, 0xf5, 0xd3, 0x87, 0xee, 0x2c, 0x78, 0x5d, 0xbf,
+    0xaf, 0x18, 0x83, 0x4d, 0x0b, 0xda, 0x52, 0x38, 0xee, 0xc2, 0x26, 0x52, 0x3d, 0xc6, 0x4f, 0xa9,
+    0x03, 0x06, 0x40, 0xee, 0xda, 0x34, 0x8b, 0xad, 0x8c, 0xd6, 0x20, 0x17, 0x21, 0x77, 0xfc, 0x56,
+    0x16, 0x74, 0x50, 0x52, 0x8c, 0xac, 0x49, 0x65, 0xa0, 0x54, 0x49, 0xa8, 0x25, 0x34, 0x0d, 0x0a,
+    0xcd, 0xce, 0x4e, 0x4f, 0x8f, 0x8f, 0x2e, 0x8f, 0x9f, 0x21, 0x9d, 0x72, 0x1a, 0xf9, 0x8f, 0x53,
+    0xac, 0xc3, 0xc3, 0x24, 0x3d, 0xb8, 0x43, 0xab, 0xc7, 0xb8, 0x0f, 0x92, 0x77, 0xd7, 0xbe, 0x7a,
+    0x6f, 0xeb, 0xbe, 0xad, 0xcf, 0x8f, 0xe5, 0xe6, 0x10, 0x19, 0x3e, 0x64, 0x77, 0x56, 0x00, 0x9e,
+    0xa1, 0xb2, 0x71, 0x8f, 0x67, 0x27, 0x17, 0x1f, 0x44, 0x21, 0xd3, 0x1b, 0x7c, 0x64, 0xe4, 0x85,
+    0x99, 0x77, 0x22, 0xef, 0x9c, 0xa7, 0xf1, 0xea, 0x09, 0x42, 0xb6, 0x35, 0x1b, 0x0f, 0x03, 0xcf,
+    0x79, 0x3a, 0x99, 0x9b, 0xcb, 0xd8, 0x07, 0x03, 0x4b, 0x91, 0x43, 0xe6, 0x10, 0x35, 0xed, 0x3c,
+    0xd4, 0x40, 0x68, 0x66, 0xe6, 0x15, 0x44, 0x11, 0x5e, 0x82, 0x3d, 0xc1, 0x24, 0xf4, 0xaf, 0xb9,
+    0x89, 0x2a, 0xde, 0xd2, 0x0c, 0xcc, 0xb4, 0x0a, 0xdb, 0x4a, 0xe7, 0xe0, 0x50, 0xc0, 0xe5, 0x8d,
+    0xe4, 0x2e, 0xb1, 0xa5, 0x9d, 0xc0, 0x4e, 0x6f, 0x1f, 0x15, 0xb4, 0xf0, 0xae, 0x6f, 0x6f, 0xe7,
+    0xb6, 0xe5, 0xc6, 0xf1, 0x90, 0x86, 0x08, 0x2f, 0x8f, 0x9c, 0x04, 0x29, 0xac, 0x16, 0x91, 0x53,
+    0x82, 0x82, 0x66, 0x1a, 0x84, 0x62, 0xe7, 0xc9, 0x34, 0xe5, 0xb1, 0xd1, 0x6a, 0x83, 0x56, 0x00,
+    0x36, 0x05, 0xe2, 0x35, 0x9a, 0xbe, 0x64, 0xa6, 0x07, 0x5c, 0x3c, 0x35, 0x11, 0x66, 0x0b, 0x44,
+    0xbd, 0x0b, 0x22, 0x2d, 0x9e, 0x7f, 0x49, 0x56, 0x3f, 0xf3, 0x9d, 0xc2, 0x72, 0xad, 0x09, 0xdd,
+    0xcf, 0x62, 0x2b, 0xbc, 0x62, 0x5f, 0x7c, 0x91, 0xe3, 0xf8, 0x19, 0xe0, 0xb8, 0x6d, 0xef, 0x20,
+    0x8e, 0xe9, 0x3c, 0x0e, 0x6f, 0x20, 0xec, 0xbc, 0x61, 0xc7, 0x58, 0x8f, 0x31, 0x8d, 0xaf, 0x2e,
+    0x2f, 0x5f, 0x81, 0x4e, 0x7e, 0x99, 0xcd, 0xd6, 0xb9, 0x13, 0xc3, 0x73, 0xd1, 0x35, 0x2d, 0x23,
+    0x90, 0x4a, 0x2e, 0x0d, 0xad, 0xc8, 0xdc, 0x4d, 0x84, 0x9b, 0x1d, 0x93, 0xb1, 0x05, 0x8f, 0x5b,
+    0xd2, 0xca, 0x19, 0xad, 0x86, 0xc6, 0xcd, 0x18, 0x28, 0x88, 0xad, 0xef, 0x92, 0x30, 0x30, 0x51,
+    0x37, 0xe9, 0x28, 0xe4, 0x38, 0x8a, 0x3a, 0x31, 0x3c, 0x13, 0xfc, 0x56, 0x9d, 0x4d, 0x1f, 0xb0,
+    0x35, 0xac, 0x98, 0x38, 0xb8, 0x11, 0xc7, 0xf9, 0xc8, 0xf2, 0xd0, 0xe7, 0xa2, 0xb8, 0x64, 0x1a,
+    0xaa, 0xa4, 0x20, 0xda, 0x53, 0xf4, 0xf2, 0xc0, 0x68, 0x33, 0x5e, 0xf2, 0xaf, 0xc9, 0x3c, 0xbc,
+    0xb9, 0xc4, 0xa2, 0x94, 0xb9, 0x80, 0xec, 0x1c, 0xdc, 0x70, 0x9b, 0x61, 0x0d, 0x9d, 0x64, 0x55,
+    0x14, 0xb9, 0x8c, 0xfc, 0x3c, 0x45, 0xa5, 0x50, 0xb3, 0x17, 0x93, 0x98, 0xc3, 0x36, 0xd2, 0x64,
+    0x80, 0xb9, 0xf0, 0xae, 0xd1, 0x50, 0x88, 0x22, 0x57, 0x41, 0xee, 0xc5, 0x4a, 0xe4, 0x2d, 0x42,
+    0x57, 0x53, 0x8a, 0x4a, 0x24, 0x11, 0xd0, 0x6c, 0x20, 0x16, 0x7c, 0xf0, 0xbe, 0x0b, 0x50, 0x7f,
+    0x34, 0xf7, 0x7c, 0xd7, 0xa4, 0x65, 0xb0, 0x43, 0xc2, 0x29, 0x82, 0x08, 0x97, 0xa9, 0x09, 0xfc,
+    0x23, 0xe9, 0x94, 0x85, 0x39, 0x8c, 0x7e, 0xad, 0xac, 0xb6, 0x47, 0x64, 0xa8, 0xa2, 0x55, 0xa1,
+    0xbc, 0x67, 0xd4, 0x00, 0x11, 0x20, 0x62, 0xc8, 0x8c, 0x41, 0x3b, 0x40, 0x20, 0xb7, 0xc9, 0xef,
+    0xaf, 0xe9, 0xc1, 0x2e, 0xb1, 0x0d, 0x51, 0x12, 0x55, 0x74, 0x53, 0xc4, 0xeb, 0x27, 0x10, 0xf3,
+    0x38, 0x34, 0xd8, 0x66, 0xa2, 0x61, 0x26, 0x9c, 0x68, 0xce, 0xbd, 0xc8, 0x59, 0x61, 0xf0, 0x0c,
+    0xef, 0x6f, 0x65, 0x8c, 0xff, 0xd6, 0x83, 0xe8, 0xbc, 0xbc, 0xfc, 0x40, 0x7e, 0xb2, 0xb5, 0x30,
+    0xb9, 0x02, 0xd8, 0x67, 0x43, 0x05, 0x4e, 0x82, 0xb1, 0xd4, 0x26, 0x99, 0x76, 0xd1, 0x0b, 0x2c,
+    0x87, 0x6a, 0xc2, 0x27, 0x2b, 0xfd, 0x70, 0xf0, 0xb7, 0x8d, 0x05, 0x4f, 0xe7, 0x21, 0x6c, 0x68,
+    0xbc, 0x3a, 0xbb, 0xb8, 0x34, 0xda, 0x0d, 0xa9, 0x8b, 0x07, 0x80, 0x8e, 0x21, 0x4f, 0xa1, 0x73,
+    0x09, 0xa7, 0x63, 0xc0, 0x14, 0x60, 0xba, 0xef, 0x4d, 0x88, 0x87, 0x5b, 0x28, 0xa5, 0x06, 0x5b,
+    0xb7, 0xe9, 0x76, 0xd3, 0x01, 0xfb, 0xed, 0xc5, 0xd9, 0x29, 0xf0, 0x39, 0x06, 0xc3, 0xe8, 0x4d,
+    0x57, 0xa6, 0x44, 0xa7, 0xd5, 0x58, 0x17, 0x05, 0x5c, 0x0a, 0x77, 0x45, 0xaa, 0x73, 0x37, 0x22,
+    0xe5, 0x0b, 0x19, 0x94, 0x4b, 0xa1, 0xf1, 0xd7, 0x7f, 0xff, 0x47, 0x26, 0x39, 0xcb, 0x20, 0xe3,
+    0x5e, 0x72, 0xc4, 0x18, 0xe4, 0x46, 0xf1, 0x36, 0x17, 0x4b, 0xcd, 0x2a, 0xeb, 0xeb, 0xff, 0xe3,
+    0x07, 0xf6, 0xdc, 0xf1, 0x7c, 0xb5, 0x4e, 0xec, 0x25, 0x2a, 0xae, 0x5a, 0x34, 0x21, 0x34, 0x02,
+    0xcd, 0x8e, 0x21, 0x9f, 0xc8, 0x00, 0x17, 0x55, 0xaa, 0x04, 0x96, 0xcc, 0x84, 0x80, 0xca, 0xad,
+    0x4c, 0x5d, 0xd4, 0x7a, 0x02, 0x20, 0x3d, 0x2b, 0x1d, 0xe9, 0x4b, 0xf0, 0xf5, 0x43, 0xb2, 0x2f,
+    0xf0, 0x84, 0xa1, 0x10, 0x1a, 0x77, 0xa1, 0xc9, 0xaf, 0xe0, 0x37, 0xe6, 0x46, 0x43, 0x36, 0x75,
+    0x7c, 0xbc, 0x6d, 0xa3, 0xd9, 0xf8, 0xc8, 0x5f, 0x3d, 0xa3, 0xf5, 0x89, 0xe9, 0x7b, 0x49, 0xda,
+    0xc6, 0xfe, 0xa7, 0xef, 0x4c, 0xb8, 0x32, 0xf4, 0xda, 0xd7, 0x6c, 0x1f, 0x50, 0x36, 0xee, 0xc4,
+    0x22, 0xdc, 0xc2, 0x45, 0x16, 0x04, 0x02, 0xc7, 0x0e, 0x90, 0xe1, 0x22, 0x19, 0xf9, 0x34, 0x10,
+    0x79, 0xd3, 0xb5, 0x3c, 0x90, 0x35, 0xb7, 0x45, 0xd9, 0x46, 0x25, 0x58, 0x2b, 0x85, 0x91, 0xd9,
+    0x58, 0x9e, 0x4b, 0x50, 0x55, 0xe2, 0xd8, 0xd7, 0xcd, 0x80, 0x7a, 0x47, 0x66, 0x40, 0x48, 0x6d,
+    0x36, 0x0d, 0x8c, 0xaf, 0x7a, 0xb6, 0x52, 0x67, 0x26, 0x0c, 0x02, 0xba, 0xef, 0x93, 0xd3, 0x57,
+    0xaf, 0x2f, 0x0d, 0xe1, 0x9f, 0x8a, 0x3c, 0x49, 0xe3, 0x25, 0x57, 0xe6, 0x5c, 0x58, 0xe0, 0x5a,
+    0x9e, 0xe9, 0xbc, 0xc6, 0x38, 0xfb, 0x49, 0x1c, 0x3b, 0x2b, 0x0b, 0x73, 0x65, 0x33, 0xa7, 0x98,
+    0x94, 0x02, 0xf0, 0xcf, 0x82, 0xf2, 0xfc, 0xea, 0xdc, 0x86, 0xb8, 0x47, 0x56, 0x04, 0x50, 0x28,
+    0xee, 0x99, 0x23, 0x6a, 0x2d, 0xd5, 0xb0, 0x4c, 0x60, 0x65, 0xf9, 0x3c, 0x98, 0xa5, 0x73, 0x19,
+    0x3b, 0x15, 0xde, 0x11, 0x13, 0x6c, 0xc9, 0x57, 0x81, 0x91, 0x45, 0x39, 0xf4, 0x57, 0x97, 0x2f,
+    0x5f, 0xa0, 0xdd, 0xaa, 0x4d, 0xba, 0x21, 0xaf, 0x3e, 0x0d, 0x55, 0xc1, 0x02, 0xce, 0x68, 0x06,
+    0x87, 0xcd, 0x63, 0xee, 0x62, 0xea, 0x85, 0xf9, 0xb5, 0xc8, 0xa4, 0x0d, 0x9d, 0x7b, 0x32, 0x17,
+    0x71, 0xae, 0xb9, 0xfb, 0xf7, 0xc4, 0x0c, 0x34, 0x40, 0x6b, 0x8d, 0x30, 0xd0, 0xb2, 0x78, 0x75,
+    0xc1, 0x7d, 0x88, 0x43, 0xc2, 0xf8, 0x89, 0xef, 0x9b, 0x46, 0x5d, 0x2f, 0x15, 0x48, 0x54, 0x42,
+    0x45, 0xc3, 0x42, 0x99, 0x35, 0xb0, 0xdf, 0xd2, 0x6b, 0x10, 0xae, 0x37, 0xb0, 0x81, 0x78, 0x26,
+    0xe6, 0x0b, 0xbf, 0x59, 0x4f, 0xa4, 0x62, 0xc9, 0x02, 0x14, 0xc4, 0x15, 0x10, 0x05, 0xba, 0x5e,
+    0xf2, 0xf4, 0xe5, 0x71, 0x6f, 0xcf, 0xc6, 0x39, 0xf2, 0xa2, 0xc5, 0x25, 0xb9, 0x25, 0x94, 0x1c,
+    0x31, 0x64, 0xe4, 0x69, 0x16, 0x0e, 0x67, 0xb1, 0x6c, 0x65, 0xfa, 0xb3, 0x8b, 0xee, 0xde, 0xd3,
+    0x9e, 0x6d, 0x80, 0xcb, 0x35, 0x7e, 0xfa, 0xf1, 0x87, 0xff, 0xfc, 0xdf, 0xff, 0xf9, 0x13, 0x06,
+    0xdd, 0x77, 0xc2, 0x95, 0xf3, 0xfe, 0x4b, 0xce, 0x03, 0xd5, 0xff, 0x73, 0xc6, 0x50, 0xf6, 0xae,
+    0x58, 0xf6, 0xc8, 0xaf, 0xcb, 0x94, 0x0b, 0x22, 0xfa, 0x85, 0x97, 0xfa, 0x31, 0xbc, 0x7d, 0xd2,
+    0x1c, 0x61, 0x12, 0x97, 0xe1, 0xbf, 0x86, 0x9c, 0xce, 0xb5, 0x70, 0x60, 0xad, 0xd7, 0x77, 0x64,
+    0x4d, 0x47, 0xf5, 0x12, 0xe9, 0xce, 0x0c, 0xde, 0x82, 0xc0, 0x06, 0x1a, 0xb5, 0x33, 0xa9, 0x98,
+    0x98, 0x1c, 0xc8, 0x9e, 0x66, 0x56, 0x33, 0x95, 0xeb, 0x44, 0x7f, 0x89, 0x5a, 0x9a, 0x79, 0xab,
+    0x4c, 0xb4, 0x55, 0x71, 0xff, 0x02, 0x23, 0xf4, 0x84, 0x6b, 0x9d, 0xd5, 0x50, 0x2b, 0x45, 0xc7,
+    0xe6, 0x48, 0xb5, 0x08, 0xee, 0x29, 0x2d, 0xea, 0x97, 0x64, 0x6a, 0xaa, 0x9d, 0x35, 0xaf, 0xb2,
+    0x02, 0xb1, 0x28, 0x83, 0x9d, 0x3c, 0xbb, 0xa3, 0xf2, 0xa9, 0xea, 0xad, 0x48, 0x80, 0xe7, 0xe2,
+    0x3d, 0x4d, 0xe1, 0x94, 0x4c, 0xbb, 0xdd, 0xed, 0xb5, 0xd6, 0xf7, 0x16, 0xa9, 0x37, 0x6c, 0xfd,
+    0x22, 0x14, 0xae, 0xef, 0x01, 0x3b, 0xfb, 0x72, 0xea, 0xfa, 0xe3, 0x37, 0xc3, 0xc8, 0x08, 0xab,
+    0x2f, 0x1b, 0x77, 0xa3, 0x1a, 0x4d, 0x27, 0x81, 0x69, 0x4d, 0xca, 0xf9, 0xe8, 0x71, 0xd8, 0x24,
+    0x14, 0x64, 0xf5, 0x66, 0x8d, 0x18, 0x69, 0x75, 0xa0, 0x7c, 0xa4, 0xf5, 0xf1, 0xd8, 0xbd, 0x72,
+    0x26, 0x57, 0x3c, 0x4d, 0x1e, 0xc0, 0x89, 0x88, 0x66, 0x1e, 0xa1, 0x39, 0xfc, 0xf8, 0xed, 0xce,
+    0x2f, 0x2e, 0x4e, 0x20, 0x41, 0xbe, 0x38, 0x3d, 0x7f, 0x08, 0xef, 0x81, 0xbc, 0x73, 0x48, 0xe2,
+    0xd7, 0x98, 0xc1, 0xc3, 0xaa, 0x8c, 0x19, 0x41, 0x8c, 0xaf, 0x3e, 0x1a, 0x89, 0x0b, 0x51, 0xea,
+    0xe7, 0xf7, 0xa0, 0xf0, 0x79, 0xce, 0x7c, 0x31, 0xff, 0x3e, 0xb2, 0x95, 0x3e, 0xd6, 0x5d, 0xe7,
+    0x20, 0xe4, 0x27, 0x0b, 0xf7, 0xef, 0x30, 0xe4, 0x21, 0x26, 0x62, 0x91, 0x08, 0x4d, 0x51, 0xb1,
+    0x92, 0xcb, 0xb7, 0x9d, 0xfe, 0x54, 0x55, 0x72, 0x8b, 0x5d, 0xf3, 0xfe, 0xee, 0x36, 0x1f, 0x0f,
+    0xc8, 0x64, 0x19, 0xeb, 0x0d, 0xe4, 0xa9, 0xe8, 0x8a, 0xb6, 0xba, 0x87, 0xc6, 0x46, 0x2d, 0x5a,
+    0x8d, 0xc7, 0xac, 0xfc, 0x16, 0x8b, 0x19, 0x91, 0xf0, 0xd0, 0x22, 0x42, 0xca, 0x27, 0x90, 0x75,
+    0x9f, 0x50, 0x8a, 0x62, 0x51, 0x6e, 0x01, 0x41, 0xd9, 0x04, 0xc2, 0x6c, 0xd0, 0x56, 0x9e, 0x28,
+    0x2a, 0x31, 0xae, 0x81, 0xb4, 0x8f, 0x96, 0xe6, 0x83, 0x00, 0xb5, 0x25, 0x08, 0x6a, 0xb5, 0xac,
+    0xef, 0x42, 0x2f, 0x30, 0x21, 0x92, 0x85, 0x4c, 0x0a, 0xde, 0x1c, 0x2f, 0xa2, 0x74, 0x65, 0xac,
+    0xef, 0x6f, 0x6e, 0xa8, 0xfb, 0x66, 0xc8, 0x11, 0x79, 0x5d, 0x2c, 0x0c, 0x26, 0x10, 0xdd, 0x5e,
+    0x91, 0x75, 0xca, 0xc2, 0x78, 0x43, 0x18, 0x92, 0x35, 0xee, 0xa0, 0x8a, 0x1e, 0xcd, 0xd1, 0x4f,
+    0x3f, 0xfe, 0xf9, 0x9f, 0xb2, 0xb6, 0xac, 0x58, 0x9e, 0xc3, 0x91, 0x3b, 0xe4, 0x17, 0xa1, 0x9a,
+    0xf7, 0x83, 0x86, 0xec, 0x3b, 0x75, 0xe2, 0x54, 0xc0, 0xfe, 0xb7, 0x3f, 0xb2, 0x73, 0xf1, 0x3d,
+    0x07, 0xfe, 0xe8, 0x36, 0x73, 0x7e, 0x8f, 0xd9, 0xbb, 0x07, 0xa3, 0x3c, 0x01, 0x47, 0x30, 0x8e,
+    0x21, 0x1b, 0x13, 0x90, 0xff, 0xf9, 0xbf, 0xd9, 0x91, 0x7a, 0x93, 0xc1, 0x7e, 0x27, 0x64, 0xe3,
+    0xa3, 0xb7, 0xc0, 0x20, 0xf3, 0x2d, 0xf6, 0x20, 0xf0, 0x1a, 0x89, 0xd8, 0xe7, 0x2f, 0xff, 0x0a,
+    0x6e, 0x92, 0x1d, 0xe1, 0x08, 0x7b, 0x2a, 0x47, 0x2a, 0xfb, 0xd5, 0x1c, 0x87, 0xb8, 0x7b, 0x84,
+    0x67, 0x42, 0x52, 0x39, 0xba, 0xf0, 0x39, 0x8f, 0xd8, 0x09, 0xfa, 0x2f, 0x10, 0xbd, 0xac, 0xbe,
+    0xdf, 0x3a, 0xdc, 0x12, 0xe3, 0x8d, 0x43, 0x11, 0x75, 0x14, 0x82, 0x12, 0xd1, 0x19, 0xc2, 0x95,
+    0x6f, 0x25, 0x9a, 0x4d, 0x91, 0x7b, 0x09, 0xc3, 0xe8, 0xc2, 0x00, 0xc1, 0xbd, 0xe0, 0x13, 0x18,
+    0x59, 0x78, 0x60, 0x30, 0xbb, 0x36, 0x3c, 0x38, 0xef, 0x87, 0x4d, 0xac, 0xd7, 0x36, 0x6b, 0x8f,
+    0x52, 0x26, 0x18, 0x75, 0xed, 0x1d, 0x70, 0xb8, 0x0f, 0x38, 0x62, 0x88, 0xb2, 0xdf, 0x12, 0x56,
+    0xf0, 0xe5, 0xee, 0xf0, 0x51, 0x47, 0x1b, 0x82, 0x2b, 0x91, 0xbd, 0xa1, 0xf1, 0x01, 0x6f, 0x80,
+    0x63, 0x9a, 0xb8, 0xdd, 0x29, 0xd4, 0x15, 0x2e, 0x8a, 0x56, 0xda, 0xc7, 0xb0, 0xd1, 0x93, 0x6b,
+    0x6a, 0x39, 0x29, 0xbc, 0xb8, 0x02, 0xfb, 0xb7, 0xe6, 0xa5, 0x42, 0x6d, 0x13, 0x3b, 0xcb, 0xe8,
+    0x97, 0x38, 0xaa, 0x50, 0xaf, 0x32, 0xb5, 0xf0, 0xf1, 0x6e, 0xad, 0xcc, 0x0c, 0x86, 0xfe, 0x67,
+    0xe3, 0xef, 0x20, 0x26, 0xb6, 0xae, 0xf8, 0x2a, 0x31, 0xb5, 0x40, 0x57, 0x0b, 0x84, 0x8b, 0x31,
+    0xab, 0x08, 0x8b, 0xef, 0xc4, 0xd1, 0x73, 0x65, 0x11, 0x55, 0x4c, 0x84, 0xc4, 0xa8, 0x3e, 0x81,
+    0xa2, 0x5c, 0x9f, 0xe6, 0x50, 0xca, 0x97, 0x47, 0xd2, 0xd8, 0x4b, 0xd0, 0xe3, 0x6d, 0xf7, 0x8d,
+    0xc8, 0x59, 0x55, 0x7f, 0x48, 0x46, 0xd3, 0xc7, 0x97, 0xce, 0xac, 0xda, 0x20, 0xc2, 0x14, 0xa2,
+    0x9a, 0xcd, 0xc9, 0x1a, 0x40, 0x1e, 0x8a, 0xd3, 0xe2, 0xc7, 0x58, 0x12, 0x38, 0x99, 0x76, 0x4e,
+    0xc3, 0x80, 0x77, 0x5e, 0x62, 0x3e, 0x6c, 0x1c, 0x14, 0x26, 0xac, 0x41, 0xb1, 0x31, 0x87, 0x28,
+    0x95, 0xba, 0xe4, 0x14, 0xac, 0x36, 0xb0, 0xac, 0xba, 0x20, 0x1f, 0xda, 0x6c, 0x02, 0x2c, 0xe3,
+    0x60, 0x10, 0x82, 0x10, 0xc2, 0xc1, 0x30, 0xe6, 0x06, 0x2b, 0x96, 0x0c, 0x6e, 0x65, 0xc9, 0xae,
+    0x52, 0x53, 0xa4, 0x7a, 0x5d, 0xa1, 0xba, 0x57, 0xa4, 0xb4, 0x54, 0x56, 0xc4, 0xb7, 0x46, 0xde,
+    0x4b, 0x53, 0x95, 0x88, 0x41, 0x5e, 0xa1, 0xc8, 0x72, 0x46, 0x55, 0x65, 0x13, 0xa9, 0xa3, 0x97,
+    0xd0, 0xa7, 0x1a, 0x6e, 0xb5, 0x8a, 0xd9, 0xb8, 0x7c, 0xdd, 0xa6, 0xfc, 0xb4, 0x5a, 0x7f, 0xbb,
+    0xd5, 0x92, 0x3c, 0xca, 0xb5, 0x21, 0xca, 0x56, 0x8d, 0x9e, 0x52, 0x6d, 0x4e, 0x86, 0xb6, 0x98,
+    0xa9, 0xeb, 0x95, 0x39, 0x3d, 0x6b, 0xbb, 0x3f, 0x35, 0xd5, 0x13, 0xa9, 0xc6, 0x9d, 0xd9, 0x22,
+    0xd5, 0x2c, 0x98, 0x5f, 0xec, 0x74, 0x97, 0x6a, 0x18, 0xe8, 0x66, 0x0b, 0xc9, 0x63, 0x2e, 0x52,
+    0xd4, 0xbc, 0x7d, 0xe1, 0x51, 0xd5, 0xef, 0xdb, 0x37, 0x83, 0xfc, 0xdd, 0x11, 0xdd, 0x68, 0xae,
+    0x17, 0x33, 0xd1, 0xf0, 0xae, 0xab, 0x85, 0x8a, 0x5e, 0xf0, 0x63, 0xdf, 0x5b, 0x78, 0xe9, 0x10,
+    0x53, 0x32, 0x08, 0x05, 0x74, 0x70, 0x10, 0x08, 0x7c, 0x91, 0x78, 0x10, 0x4a, 0x0d, 0x09, 0xc1,
+    0x60, 0x12, 0xba, 0xfc, 0xf5, 0xf9, 0x09, 0x18, 0x86, 0x08, 0x44, 0x31, 0x48, 0xf5, 0xc9, 0x2d,
+    0x19, 0x17, 0xd4, 0x89, 0x50, 0x49, 0x5c, 0x44, 0xe5, 0xba, 0x20, 0x24, 0xbf, 0xeb, 0x10, 0x96,
+    0x1d, 0x70, 0xbf, 0x1c, 0x9c, 0xb1, 0x48, 0x00, 0xbb, 0xf0, 0x50, 0xa6, 0xb8, 0x48, 0xed, 0x1d,
+    0x50, 0xc4, 0x38, 0xac, 0x06, 0xd1, 0xd5, 0x16, 0x6c, 0x92, 0xc1, 0x29, 0x04, 0x02, 0x73, 0x0d,
+    0xe7, 0xa2, 0x08, 0xd2, 0x68, 0x4b, 0x91, 0x21, 0x3b, 0x6c, 0xf8, 0x4e, 0x55, 0x0f, 0xa4, 0x60,
+    0xe9, 0xd8, 0x8a, 0xf1, 0x18, 0x5e, 0xc5, 0x09, 0x37, 0x5b, 0xf8, 0x37, 0x30, 0x20, 0x9e, 0x66,
+    0x36, 0xa5, 0x65, 0x25, 0x60, 0x6b, 0x39, 0xe4, 0x47, 0xac, 0x67, 0xeb, 0xd5, 0x2a, 0x2a, 0xcd,
+    0xe5, 0x84, 0x6b, 0x9d, 0x9e, 0x72, 0xa9, 0xe2, 0x4e, 0xa9, 0x14, 0x07, 0x5b, 0x14, 0x4a, 0x10,
+    0xaa, 0xa8, 0x26, 0x05, 0xd5, 0x2e, 0xe1, 0x66, 0xf9, 0xea, 0x69, 0x28, 0xaf, 0x09, 0xa8, 0x3a,
+    0x46, 0x5d, 0x05, 0x03, 0x09, 0xf3, 0xd2, 0xd5, 0x11, 0x82, 0xa2, 0x22, 0x06, 0xb3, 0x41, 0x02,
+    0xe4, 0x95, 0x4b, 0x50, 0xa0, 0x2e, 0x7e, 0x13, 0x7f, 0xc4, 0x04, 0xdf, 0x7a, 0xf8, 0x4d, 0xdc,
+    0xa8, 0x34, 0xb0, 0x94, 0x5a, 0x04, 0xf2, 0x02, 0xbd, 0x61, 0x0e, 0xe4, 0xe4, 0xf4, 0xf9, 0x99,
+    0x84, 0xf0, 0xcd, 0x93, 0xf3, 0x53, 0x6c, 0x12, 0x09, 0x08, 0xc7, 0xe7, 0xe7, 0x67, 0xe7, 0xb4,
+    0xfe, 0x43, 0x49, 0x4f, 0x9d, 0xb1, 0xcf, 0x15, 0xf9, 0xe2, 0x1a, 0x29, 0x5d, 0x01, 0xcf, 0xef,
+    0x7c, 0xfa, 0x4e, 0x94, 0xf0, 0x03, 0xf5, 0x00, 0x5c, 0x00, 0x99, 0x07, 0x45, 0x4e, 0xe9, 0xb6,
+    0xe3, 0x61, 0x1a, 0x67, 0x57, 0x39, 0x0a, 0x7f, 0xd1, 0x52, 0xbd, 0x27, 0x0b, 0x7a, 0x0e, 0x67,
+    0x24, 0x27, 0x6b, 0xdc, 0xf5, 0xf9, 0x34, 0x1d, 0xa8, 0xdb, 0x1d, 0x74, 0xd7, 0x43, 0x9e, 0x82,
+    0xbc, 0x33, 0xac, 0xdf, 0x91, 0xc5, 0x0b, 0xd5, 0xcd, 0xd1, 0x25, 0x5d, 0x4b, 0x4b, 0xe7, 0x19,
+    0x26, 0x9f, 0x04, 0xaa, 0xb0, 0x76, 0x9f, 0x1e, 0xee, 0x85, 0x3c, 0xcb, 0x4f, 0x0f, 0xf9, 0xa5,
+    0xb0, 0x8b, 0x04, 0x18, 0x7e, 0xc5, 0xf8, 0x4b, 0x9e, 0x0a, 0xdd, 0x41, 0xc5, 0xcd, 0x48, 0x3f,
+    0x30, 0xb3, 0xe1, 0x7a, 0x0c, 0x40, 0x90, 0xa9, 0xe7, 0xaf, 0x0b, 0xeb, 0xb7, 0xdc, 0x52, 0x2f,
+    0xde, 0x50, 0x85, 0x05, 0x15, 0x21, 0xab, 0x5f, 0x89, 0xfb, 0xf7, 0xc3, 0x92, 0x6c, 0x56, 0xd6,
+    0xbc, 0x3e, 0xfd, 0xfa, 0xf4, 0xec, 0x9b, 0xd3, 0x6c, 0x19, 0xb5, 0x7c, 0x6b, 0xfb, 0xf6, 0x68,
+    0x46, 0x3b, 0x98, 0x36, 0x61, 0xed, 0x19, 0x7b, 0x68, 0xfa, 0x95, 0x0e, 0xb4, 0xfb, 0xf8, 0x05,
+    0xfc, 0xeb, 0x22, 0x6a, 0x59, 0x69, 0x88, 0xc5, 0x0e, 0x9f, 0x5f, 0x88, 0xda, 0x49, 0xee, 0x36,
+    0xdf, 0x7d, 0x90, 0x04, 0x36, 0x0e, 0x53, 0x57, 0xcd, 0xae, 0x63, 0x75, 0xa5, 0xf6, 0xd4, 0x97,
+    0xc5, 0x27, 0x44, 0x05, 0xf2, 0xe6, 0xd4, 0xbd, 0x17, 0x04, 0xde, 0x2a, 0xc7, 0x15, 0xdc, 0x92,
+    0xcd, 0x13, 0x59, 0x26, 0xdb, 0xb4, 0x14, 0x54, 0x43, 0x2f, 0x84, 0x69, 0xa9, 0xf4, 0xa3, 0x5b,
+    0x02, 0xbb, 0xee, 0xf5, 0x24, 0x7c, 0xf5, 0x22, 0x93, 0x14, 0xbc, 0x6f, 0x8e, 0x05, 0xb6, 0xe2,
+    0xa5, 0x29, 0xfc, 0x3b, 0xd4, 0x72, 0x11, 0xad, 0x2a, 0x40, 0x8f, 0x6e, 0xe9, 0x50, 0x55, 0x01,
+    0xed, 0x41, 0xf4, 0xc9, 0x3f, 0xfa, 0x16, 0x24, 0x4a, 0xcf, 0xac, 0xc8, 0x43, 0x19, 0xc4, 0x5b,
+    0x1e, 0x79, 0x74, 0x4a, 0xe2, 0xbe, 0x25, 0xc4, 0x11, 0x3e, 0xd1, 0xd8, 0x08, 0xcf, 0x5d, 0x13,
+    0x93, 0x64, 0x96, 0xbd, 0xe0, 0x3c, 0x94, 0x7d, 0xfd, 0xff, 0xb2, 0xe9, 0x22, 0x0a, 0x60, 0x41,
+    0x98, 0x32, 0xe7, 0xda, 0xf1, 0x7c, 0x44, 0x51, 0x9a, 0xf6, 0x3c, 0xbe, 0x88, 0xc0, 0xfa, 0xa1,
+    0xd5, 0x21, 0x83, 0x8e, 0xee, 0x36, 0xef, 0xb0, 0x61, 0x56, 0xfc, 0x0a, 0x86, 0x49, 0x2c, 0x25,
+    0x25, 0xf9, 0xf4, 0x5a, 0x52, 0x0a, 0x31, 0x2e, 0xde, 0x5e, 0xa9, 0x69, 0xd0, 0x0e, 0x1a, 0xc5,
+    0x3d, 0xb1, 0x0d, 0xa8, 0xb2, 0x03, 0x53, 0x03, 0xd0, 0xc6, 0x3f, 0x32, 0xb1, 0x5b, 0xed, 0xc2,
+    0x78, 0x0d, 0x44, 0x74, 0xa6, 0x30, 0xaf, 0xf1, 0xa6, 0xd8, 0x1f, 0x84, 0x0c, 0x47, 0x47, 0x5e,
+    0x43, 0x5c, 0x25, 0x0f, 0x94, 0x4d, 0x2b, 0xc8, 0x15, 0xb4, 0x8a, 0xe0, 0xe4, 0x35, 0x01, 0x50,
+    0x52, 0xee, 0x2c, 0x32, 0x6e, 0x7c, 0x76, 0xe3, 0x05, 0x6e, 0x78, 0x63, 0x11, 0xa7, 0x2f, 0xc2,
+    0x65, 0x2c, 0xba, 0x42, 0x45, 0xce, 0xd5, 0x38, 0x52, 0x82, 0x22, 0x5b, 0x53, 0xda, 0x5a, 0x19,
+    0xa3, 0x89, 0x61, 0x0c, 0xa0, 0xc5, 0x93, 0x05, 0xb2, 0x7a, 0xac, 0x24, 0x88, 0x83, 0x24, 0x98,
+    0x46, 0x18, 0xf1, 0x00, 0x1c, 0xa4, 0xe8, 0x9a, 0x16, 0x48, 0xdd, 0xb4, 0x4a, 0xf4, 0xc9, 0xf2,
+    0x65, 0x3a, 0x96, 0x9b, 0xd6, 0x25, 0x01, 0xf8, 0xc7, 0x79, 0x98, 0x62, 0x8c, 0x8c, 0x2b, 0x0b,
+    0x41, 0x39, 0x75, 0x23, 0xa9, 0x05, 0x6a, 0x82, 0x61, 0xc0, 0xc6, 0xb8, 0x8c, 0xcf, 0x37, 0x41,
+    0xcc, 0xf3, 0x94, 0x87, 0x01, 0xa4, 0x86, 0xd3, 0x46, 0x88, 0xaa, 0xc9, 0x2f, 0x21, 0x16, 0xfb,
+    0xf5, 0x55, 0x90, 0xa2, 0x59, 0xa8, 0x4b, 0x96, 0x6a, 0x63, 0x8b, 0x0e, 0x9f, 0xd6, 0xef, 0xca,
+    0x1b, 0x64, 0xf5, 0x97, 0xaa, 0xaa, 0xdd, 0x1b, 0x2b, 0x2b, 0x15, 0x6b, 0x3d, 0x1b, 0xf4, 0x30,
+    0x08, 0x9f, 0xfb, 0xa5, 0x4e, 0x95, 0x56, 0x30, 0x3e, 0xa5, 0x72, 0x00, 0x4c, 0x25, 0x24, 0x01,
+    0x3b, 0x0b, 0x81, 0x10, 0xae, 0xa2, 0x0f, 0x2e, 0x6f, 0xd7, 0xe9, 0x31, 0xfe, 0xa0, 0xa2, 0x3f,
+    0x62, 0x44, 0x4c, 0xc6, 0x3f, 0x04, 0xc1, 0xcb, 0x81, 0x47, 0x78, 0xf1, 0xe9, 0x00, 0xb2, 0x7d,
+    0x7f, 0x45, 0x52, 0x27, 0x83, 0xbd, 0x49, 0x08, 0x2e, 0x0c, 0x8d, 0x72, 0xa3, 0x24, 0xe0, 0x03,
+    0xfc, 0xeb, 0x0f, 0x79, 0x19, 0x14, 0x52, 0x76, 0xf1, 0x77, 0x1f, 0x5b, 0xf4, 0x3f, 0x26, 0xf9,
+    0x3f, 0x77, 0x34, 0xbe, 0xf5, 0xaf, 0x44, 0x00, 0x00,
+};
+
+#endif // DASHBOARD_HTML_H
@@ -1,7 +1,20 @@
 #include "database_manager.h"
+#include "db_spill.h"
+#include "metrics.h"
 
 DatabaseManager dbManager;
 
+#define LOCK_WRITES() xSemaphoreTake(queueMutex, portMAX_DELAY)
+#define UNLOCK_WRITES() xSemaphoreGive(queueMutex)
+
+#if (DB_PACKET_RING_CAPACITY & (DB_PACKET_RING_CAPACITY - 1)) != 0
+#error "DB_PACKET_RING_CAPACITY must be a power of two"
+#endif
+
+// Packet ring lock: writers only copy one row, so a spinlock is cheaper
+// than the write queue mutex (which is held while batches are serialized)
+static portMUX_TYPE packetMux = portMUX_INITIALIZER_UNLOCKED;
+
 // REST API base URL - will be set from environment or use direct PostgreSQL REST wrapper
 // ✅ Enabled by default - API service running on 192.168.0.167:3000
 #define DB_API_ENABLED true
@@ -9,12 +22,95 @@ DatabaseManager dbManager;
 #define DB_API_URL "http://192.168.0.167:3000/api"
 #endif
 
+#if DB_BACKEND_POSTGRES
+#ifndef PG_PORT
+#define PG_PORT 5432
+#endif
+
+// Device upserts: COPY into a session-local staging table, then one prepared
+// statement moves the rows into devices (COPY itself cannot upsert)
+static const char* PG_DEVICE_STAGE_SQL =
+    "CREATE TEMP TABLE IF NOT EXISTS gw_device_stage ("
+    "device_id BIGINT, name TEXT, location TEXT, sensor_type TEXT, "
+    "last_rssi SMALLINT, last_snr SMALLINT, packet_count INTEGER, "
+    "last_sequence INTEGER, sensor_interval SMALLINT, deep_sleep_sec SMALLINT)";
+static const char* PG_DEVICE_MERGE_SQL =
+    "WITH staged AS (DELETE FROM gw_device_stage RETURNING *) "
+    "INSERT INTO devices (device_id, name, location, sensor_type, last_rssi, last_snr, "
+    "packet_count, last_sequence, sensor_interval, deep_sleep_sec, last_seen, updated_at) "
+    "SELECT DISTINCT ON (device_id) device_id, name, location, sensor_type, last_rssi, "
+    "last_snr, packet_count, last_sequence, sensor_interval, deep_sleep_sec, NOW(), NOW() "
+    "FROM staged "
+    "ON CONFLICT (device_id) DO UPDATE SET "
+    "name = EXCLUDED.name, location = EXCLUDED.location, sensor_type = EXCLUDED.sensor_type, "
+    "last_rssi = EXCLUDED.last_rssi, last_snr = EXCLUDED.last_snr, "
+    "packet_count = EXCLUDED.packet_count, last_sequence = EXCLUDED.last_sequence, "
+    "sensor_interval = EXCLUDED.sensor_interval, deep_sleep_sec = EXCLUDED.deep_sleep_sec, "
+    "last_seen = NOW(), updated_at = NOW()";
+static const char* PG_DEVICE_MERGE_STMT = "gw_merge_devices";
+
+static const char* PG_COPY_DEVICES_SQL =
+    "COPY gw_device_stage (device_id, name, location, sensor_type, last_rssi, last_snr, "
+    "packet_count, last_sequence, sensor_interval, deep_sleep_sec) FROM STDIN";
+static const char* PG_COPY_COMMANDS_SQL =
+    "COPY commands (device_id, command_type, parameters, status) FROM STDIN";
+static const char* PG_COPY_EVENTS_SQL =
+    "COPY events (device_id, event_type, severity, message) FROM STDIN";
+
+// Packet history: rows carry their age (no wall clock on the gateway), so
+// they are staged and inserted with received_at computed by the server
+static const char* PG_PACKET_STAGE_SQL =
+    "CREATE TEMP TABLE IF NOT EXISTS gw_packet_stage ("
+    "device_id BIGINT, age_ms BIGINT, sequence_num INTEGER, rssi SMALLINT, "
+    "snr SMALLINT, msg_type SMALLINT)";
+static const char* PG_PACKET_INSERT_SQL =
+    "WITH staged AS (DELETE FROM gw_packet_stage RETURNING *) "
+    "INSERT INTO packets (device_id, msg_type, sequence_num, rssi, snr, received_at) "
+    "SELECT device_id, msg_type, sequence_num, rssi, snr, "
+    "NOW() - age_ms * INTERVAL '1 millisecond' FROM staged";
+static const char* PG_PACKET_INSERT_STMT = "gw_insert_packets";
+static const char* PG_COPY_PACKETS_SQL =
+    "COPY gw_packet_stage (device_id, age_ms, sequence_num, rssi, snr, msg_type) FROM STDIN";
+
+// Monthly packets partitions are created ahead by ensure_packet_partitions()
+// (schema.sql); re-run periodically so a long-lived session crosses months
+#define PG_PARTITION_CHECK_MS (6UL * 60 * 60 * 1000)
+#endif
+
 DatabaseManager::DatabaseManager() 
     : status(DB_DISCONNECTED)
-    , lastReconnectAttempt(0)
     , failedWrites(0)
-    , reconnectAttempts(0)
-    , apiBaseUrl(DB_API_URL) {
+    , apiBaseUrl(DB_API_URL)
+    , gzipAccepted(false)
+    , bodyBytes(0)
+    , wireBytes(0)
+    , queueMutex(NULL)
+    , nextWriteSeq(0)
+    , coalescedWrites(0)
+    , droppedWrites(0)
+    , spillEnabled(false)
+    , lastSpillReplay(0)
+    , reportedDrops(0)
+    , spillStageCount{0, 0}
+    , spillStageActive(0)
+    , ringHead(0)
+    , ringCount(0)
+    , ringLive(0)
+    , packetHead(0)
+    , packetTail(0)
+    , sentPackets(0)
+    , droppedPackets(0)
+#if DB_BACKEND_POSTGRES
+    , lastPartitionCheck(0)
+#endif
+    , windowFailures(0)
+    , windowCount(0)
+    , consecutiveFailures(0)
+    , backoffLevel(0)
+    , breakerTrips(0)
+    , openedAt(0)
+    , backoffMs(0)
+    , lastRequestAt(0) {
 }
 
 DatabaseManager::~DatabaseManager() {
@@ -22,10 +118,32 @@ DatabaseManager::~DatabaseManager() {
 }
 
 void DatabaseManager::init() {
+    queueMutex = xSemaphoreCreateMutex();
+    
 #if DB_API_ENABLED
+#if DB_BACKEND_POSTGRES
+    Serial.println("[DB] Initializing database manager (PostgreSQL mode)");
+    Serial.printf("[DB] PostgreSQL: %s:%d/%s\n", PG_HOST, PG_PORT, PG_DATABASE);
+#else
     Serial.println("[DB] Initializing database manager (REST API mode)");
     Serial.printf("[DB] API URL: %s\n", apiBaseUrl.c_str());
-    attemptConnection();
+#endif
+    
+    // Writes left on flash by an outage before the last reboot are replayed
+    spillEnabled = initDbSpill();
+    
+    // Reuse one TCP connection for health checks and batches (keep-alive).
+    // Requests stay sequential: HTTPClient has one in flight per connection,
+    // and each response decides whether that batch's writes are released.
+    // The breaker starts open with no backoff, so dbTask probes right away
+    http.setReuse(true);
+    http.setConnectTimeout(DB_CONNECT_TIMEOUT_MS);
+    
+#if DB_COMPRESSION
+    if (!compressor.begin(DB_COMPRESS_MAX_BYTES)) {
+        Serial.println("⚠️  [DB] Not enough memory for the compressor, sending bodies uncompressed");
+    }
+#endif
 #else
     Serial.println("[DB] Database manager disabled (no API configured)");
     status = DB_DISCONNECTED;
@@ -34,8 +152,12 @@ void DatabaseManager::init() {
 
 void DatabaseManager::loop() {
 #if DB_API_ENABLED
+    // Ring overflow goes to flash here, never on a writer's task
+    flushSpill();
+    
     if (status == DB_DISCONNECTED) {
-        if (millis() - lastReconnectAttempt > RECONNECT_INTERVAL) {
+        // Open: wait out the backoff, then go half-open with a single probe
+        if (millis() - openedAt >= backoffMs) {
             attemptConnection();
         }
     } else if (status == DB_CONNECTED) {
@@ -45,114 +167,794 @@ void DatabaseManager::loop() {
 #endif
 }
 
+/**
+ * Half-open probe: one short-timeout health check decides whether the
+ * breaker closes or re-opens with a longer backoff
+ */
 void DatabaseManager::attemptConnection() {
-    lastReconnectAttempt = millis();
-    reconnectAttempts++;
+    status = DB_RECONNECTING;
+    Serial.printf("[DB] Probing API (trip %lu, backoff %lu ms)...\n",
+                  (unsigned long)breakerTrips, (unsigned long)backoffMs);
     
-    Serial.printf("[DB] Connection attempt %d...\n", reconnectAttempts);
+    bool healthy = probeBackend();
+    lastRequestAt = millis();
     
-    // Simple health check to API
-    http.begin(apiBaseUrl + "/health");
-    http.setTimeout(5000);
-    int httpCode = http.GET();
-    http.end();
-    
-    if (httpCode == 200) {
+    if (healthy) {
         Serial.println("✅ Database API connected");
         status = DB_CONNECTED;
-        reconnectAttempts = 0;
+        windowFailures = 0;
+        windowCount = 0;
+        consecutiveFailures = 0;
         
         // Process any queued writes
-        Serial.printf("[DB] Processing %d queued writes\n", writeQueue.size());
+        Serial.printf("[DB] Processing %d queued writes (%lu spilled to flash)\n",
+                      ringLive, (unsigned long)getDbSpillRecords());
     } else {
-        Serial.printf("⚠️  Database API unavailable (HTTP %d), continuing without persistence\n", httpCode);
-        status = DB_DISCONNECTED;
+        Serial.println("⚠️  Database unavailable, continuing without persistence");
+        tripBreaker();
+    }
+}
+
+/**
+ * Record the outcome of an API request in the success-rate window
+ * (closed state) and trip the breaker when the endpoint looks down
+ */
+void DatabaseManager::recordResult(bool ok) {
+    lastRequestAt = millis();
+    
+    windowFailures = (windowFailures << 1) | (ok ? 0 : 1);
+    if (DB_BREAKER_WINDOW < 32) {
+        windowFailures &= (1UL << DB_BREAKER_WINDOW) - 1;
+    }
+    if (windowCount < DB_BREAKER_WINDOW) {
+        windowCount++;
+    }
+    
+    if (ok) {
+        consecutiveFailures = 0;
+        // A full window without failures: the endpoint is healthy again
+        if (windowCount == DB_BREAKER_WINDOW && windowFailures == 0) {
+            backoffLevel = 0;
+        }
+        return;
+    }
+    
+    consecutiveFailures++;
+    uint8_t failures = __builtin_popcount(windowFailures);
+    if (consecutiveFailures >= DB_BREAKER_TRIP_FAILURES ||
+        (windowCount >= DB_BREAKER_MIN_SAMPLES &&
+         failures * 100 >= DB_BREAKER_FAILURE_PERCENT * windowCount)) {
+        Serial.printf("⚠️  Database API failing (%d of last %d requests), opening circuit\n",
+                      failures, windowCount);
+        tripBreaker();
     }
 }
 
+/**
+ * Open the breaker: exponential backoff with jitter (half to full delay)
+ * so a dead endpoint is not hammered and gateways do not probe in lockstep
+ */
+void DatabaseManager::tripBreaker() {
+    uint32_t delay = DB_BREAKER_BACKOFF_MIN_MS;
+    for (uint8_t i = 0; i < backoffLevel && delay < DB_BREAKER_BACKOFF_MAX_MS; i++) {
+        delay *= 2;
+    }
+    if (delay > DB_BREAKER_BACKOFF_MAX_MS) {
+        delay = DB_BREAKER_BACKOFF_MAX_MS;
+    }
+    
+    backoffMs = delay / 2 + random(delay / 2 + 1);
+    openedAt = millis();
+    if (backoffLevel < 16) {
+        backoffLevel++;
+    }
+    breakerTrips++;
+    status = DB_DISCONNECTED;
+}
+
 void DatabaseManager::processWriteQueue() {
-    if (writeQueue.empty() || status != DB_CONNECTED) {
+    if (status != DB_CONNECTED) {
         return;
     }
     
-    // Process up to 10 writes per loop iteration to avoid blocking
-    int processed = 0;
-    while (!writeQueue.empty() && processed < 10 && status == DB_CONNECTED) {
-        PendingWrite& write = writeQueue.front();
-        
-        if (postJson(write.endpoint, write.doc)) {
-            writeQueue.pop();
-            processed++;
-        } else {
-            // Connection likely failed
-            Serial.println("⚠️  Database write failed, marking disconnected");
-            status = DB_DISCONNECTED;
+    // Bring spilled history back at a bounded rate, ahead of the batches
+    if (spillEnabled && millis() - lastSpillReplay >= DB_SPILL_REPLAY_INTERVAL_MS) {
+        lastSpillReplay = millis();
+        replaySpill();
+    }
+    
+#if DB_BACKEND_POSTGRES
+    if (millis() - lastPartitionCheck >= PG_PARTITION_CHECK_MS) {
+        ensurePacketPartitions();
+    }
+#endif
+    
+    // Send every due batch back-to-back over the kept-alive connection
+    while (status == DB_CONNECTED && sendBatch()) {
+    }
+    while (status == DB_CONNECTED && sendPacketBatch()) {
+    }
+}
+
+/**
+ * Write staged ring overflow to flash (DB task)
+ * The buffers are swapped under the lock; the flash I/O runs without it,
+ * so writers and sendBatch never wait on LittleFS
+ */
+void DatabaseManager::flushSpill() {
+    LOCK_WRITES();
+    uint8_t full = spillStageActive;
+    if (spillStageCount[full] > 0) {
+        spillStageActive ^= 1;
+    }
+    uint32_t dropped = droppedWrites;
+    UNLOCK_WRITES();
+    
+    if (dropped != reportedDrops) {
+        Serial.printf("⚠️  Write queue full, dropped %lu writes\n",
+                      (unsigned long)(dropped - reportedDrops));
+        reportedDrops = dropped;
+    }
+    
+    uint16_t count = spillStageCount[full];
+    if (count == 0 || spillStageActive == full) {
+        return;
+    }
+    
+    const DbWriteRecord* writes[DB_SPILL_CHUNK];
+    for (uint16_t i = 0; i < count; i++) {
+        writes[i] = &spillStage[full][i];
+    }
+    size_t stored = spillDbWrites(writes, count);
+    
+    // The inactive buffer is only touched here until the next swap
+    LOCK_WRITES();
+    droppedWrites += count - stored;
+    spillStageCount[full] = 0;
+    UNLOCK_WRITES();
+}
+
+/**
+ * Move up to DB_SPILL_REPLAY_BATCH spilled writes back into the ring
+ * Skipped while the ring is over half full so live writes keep priority;
+ * records are read from flash before the lock is taken
+ */
+void DatabaseManager::replaySpill() {
+    DbWriteRecord replay[DB_SPILL_REPLAY_BATCH];
+    
+    LOCK_WRITES();
+    bool room = ringLive < DB_RING_CAPACITY / 2;
+    UNLOCK_WRITES();
+    if (!room || getDbSpillRecords() == 0) {
+        return;
+    }
+    
+    size_t count = readDbSpill(replay, DB_SPILL_REPLAY_BATCH);
+    if (count == 0) {
+        return;
+    }
+    
+    LOCK_WRITES();
+    for (size_t i = 0; i < count; i++) {
+        DbWriteRecord* write = allocWrite(replay[i].type, replay[i].deviceId);
+        uint32_t seq = write->seq;
+        uint32_t timestamp = write->timestamp;
+        *write = replay[i];
+        write->seq = seq;
+        write->timestamp = timestamp;
+    }
+    UNLOCK_WRITES();
+    
+    Serial.printf("[DB] Replayed %d spilled writes, %lu left on flash\n",
+                  count, (unsigned long)getDbSpillRecords());
+}
+
+/**
+ * Helper: Endpoint a write type is posted to
+ */
+static const char* writeEndpoint(DbWriteType type) {
+    switch (type) {
+        case DB_WRITE_DEVICE:  return "/devices";
+        case DB_WRITE_COMMAND: return "/commands";
+        case DB_WRITE_EVENT:   return "/events";
+        default:               return "";
+    }
+}
+
+/**
+ * Helper: Append one queued write to a batch body as a JSON object
+ */
+static void appendWriteJson(const DbWriteRecord& write, String& body) {
+    JsonDocument doc;
+    // Convert uint64_t to string to avoid truncation on 32-bit systems
+    char deviceIdStr[32];
+    snprintf(deviceIdStr, sizeof(deviceIdStr), "%llu", (unsigned long long)write.deviceId);
+    doc["device_id"] = deviceIdStr;
+    
+    switch (write.type) {
+        case DB_WRITE_DEVICE:
+            doc["name"] = write.device.name;
+            doc["location"] = write.device.location;
+            doc["sensor_type"] = write.device.sensorType;
+            doc["last_rssi"] = write.device.rssi;
+            doc["last_snr"] = write.device.snr;
+            doc["packet_count"] = write.device.packetCount;
+            doc["last_sequence"] = write.device.lastSequence;
+            doc["sensor_interval"] = write.device.sensorInterval;
+            doc["deep_sleep_sec"] = write.device.deepSleep;
+            break;
+        case DB_WRITE_COMMAND:
+            doc["command_type"] = write.command.commandType;
+            doc["parameters"] = write.command.params;
+            doc["status"] = write.command.status;
+            break;
+        case DB_WRITE_EVENT:
+            doc["event_type"] = write.event.eventType;
+            doc["severity"] = write.event.severity;
+            doc["message"] = write.event.message;
+            break;
+        default:
             break;
-        }
     }
     
-    if (processed > 0) {
-        Serial.printf("[DB] Processed %d queued writes, %d remaining\n", 
-                     processed, writeQueue.size());
+    // serializeJson into a String replaces its contents, so serialize the
+    // object on its own and append it to the batch
+    String item;
+    serializeJson(doc, item);
+    body += item;
+}
+
+#if DB_BACKEND_POSTGRES
+/**
+ * Helper: Append one queued write to a COPY batch as a text-format row
+ * (columns as in the PG_COPY_*_SQL statements)
+ */
+static void appendWriteCopyRow(const DbWriteRecord& write, String& body) {
+    char field[64];
+    snprintf(field, sizeof(field), "%llu\t", (unsigned long long)write.deviceId);
+    body += field;
+    
+    switch (write.type) {
+        case DB_WRITE_DEVICE:
+            pgCopyEscape(body, write.device.name);
+            body += '\t';
+            pgCopyEscape(body, write.device.location);
+            body += '\t';
+            pgCopyEscape(body, write.device.sensorType);
+            snprintf(field, sizeof(field), "\t%d\t%d\t%lu\t%u\t%u\t%u",
+                     write.device.rssi, write.device.snr,
+                     (unsigned long)write.device.packetCount, write.device.lastSequence,
+                     write.device.sensorInterval, write.device.deepSleep);
+            body += field;
+            break;
+        case DB_WRITE_COMMAND:
+            snprintf(field, sizeof(field), "%u\t", write.command.commandType);
+            body += field;
+            if (write.command.params[0] == '\0') {
+                body += "\\N";  // NULL (empty string is not valid JSONB)
+            } else {
+                pgCopyEscape(body, write.command.params);
+            }
+            body += '\t';
+            pgCopyEscape(body, write.command.status);
+            break;
+        case DB_WRITE_EVENT:
+            snprintf(field, sizeof(field), "%u\t%u\t", write.event.eventType, write.event.severity);
+            body += field;
+            pgCopyEscape(body, write.event.message);
+            break;
+        default:
+            break;
     }
+    
+    body += '\n';
 }
+#endif
 
-void DatabaseManager::checkConnectionHealth() {
-    // Simple health check every minute
-    static uint32_t lastCheck = 0;
-    if (millis() - lastCheck > 60000) {
-        lastCheck = millis();
-        
-        http.begin(apiBaseUrl + "/health");
-        http.setTimeout(2000);
-        int httpCode = http.GET();
-        http.end();
-        
-        if (httpCode != 200) {
-            Serial.println("⚠️  Database connection lost");
-            status = DB_DISCONNECTED;
+/**
+ * Helper: Count a batch outcome and its round-trip time for /metrics
+ */
+static void recordBatchMetrics(DbSendResult result, uint32_t startMs) {
+    metricsObserve(METRIC_STAGE_DB_BATCH, millis() - startMs);
+    metricsInc(result == DB_SEND_OK ? METRIC_DB_BATCH_OK : METRIC_DB_BATCH_FAIL);
+}
+
+/**
+ * Send the next batch if one is due
+ * Takes the oldest write's type and up to DB_BATCH_MAX_SIZE queued writes
+ * of that type (in order) as one JSON array POST to <endpoint>/batch
+ * Returns true if a batch was sent successfully
+ */
+bool DatabaseManager::sendBatch() {
+    LOCK_WRITES();
+    trimRing();
+    
+    // Wait for a full batch, or until the oldest write has lingered long enough
+    if (ringLive == 0 ||
+        (ringLive < DB_BATCH_MAX_SIZE &&
+         millis() - ring[ringHead].timestamp < DB_BATCH_LINGER_MS)) {
+        UNLOCK_WRITES();
+        return false;
+    }
+    
+    DbWriteType type = ring[ringHead].type;
+    uint32_t sentSeq[DB_BATCH_MAX_SIZE];
+    size_t count = 0;
+#if DB_BACKEND_POSTGRES
+    String body;
+    for (uint16_t i = 0; i < ringCount && count < DB_BATCH_MAX_SIZE; i++) {
+        const DbWriteRecord& write = ring[(ringHead + i) % DB_RING_CAPACITY];
+        if (write.type != type) {
+            continue;
+        }
+        appendWriteCopyRow(write, body);
+        sentSeq[count++] = write.seq;
+    }
+#else
+    String body = "[";
+    for (uint16_t i = 0; i < ringCount && count < DB_BATCH_MAX_SIZE; i++) {
+        const DbWriteRecord& write = ring[(ringHead + i) % DB_RING_CAPACITY];
+        if (write.type != type) {
+            continue;
         }
+        if (count > 0) {
+            body += ",";
+        }
+        appendWriteJson(write, body);
+        sentSeq[count++] = write.seq;
+    }
+    body += "]";
+#endif
+    UNLOCK_WRITES();
+    
+    const char* endpoint = writeEndpoint(type);
+    
+    // Send without holding the lock so writers never wait on the network
+    uint32_t sendStart = millis();
+    DbSendResult result = sendBody(type, body);
+    recordBatchMetrics(result, sendStart);
+    bool rejected = result == DB_SEND_REJECTED;
+    recordResult(result != DB_SEND_FAILED);
+    if (result == DB_SEND_FAILED) {
+        return false;  // Stays queued; retried next pass unless the breaker opened
+    }
+    
+    // Release the sent writes by seq: meanwhile some may have been dropped,
+    // moved by compaction, or updated by a newer device write (new seq, kept)
+    LOCK_WRITES();
+    for (uint16_t i = 0; i < ringCount; i++) {
+        DbWriteRecord* write = &ring[(ringHead + i) % DB_RING_CAPACITY];
+        if (write->type != type) {
+            continue;
+        }
+        for (size_t j = 0; j < count; j++) {
+            if (write->seq == sentSeq[j]) {
+                releaseWrite(write);
+                break;
+            }
+        }
+    }
+    trimRing();
+    size_t remaining = ringLive;
+    if (rejected) {
+        droppedWrites += count;
+    }
+    UNLOCK_WRITES();
+    
+    if (rejected) {
+        Serial.printf("⚠️  [DB] Backend rejected batch of %d writes to %s, dropped\n",
+                      count, endpoint);
+        return true;
     }
+    
+    Serial.printf("[DB] Sent batch of %d writes to %s, %d remaining\n",
+                  count, endpoint, remaining);
+    return true;
 }
 
-bool DatabaseManager::postJson(const String& endpoint, const JsonDocument& doc) {
-    if (status != DB_CONNECTED) {
+/**
+ * Send the next packet history batch if one is due
+ * Rows are copied into the send buffer (ages filled in) under the spinlock,
+ * and only removed from the ring once the backend has taken them
+ * Returns true if a batch was sent successfully
+ */
+bool DatabaseManager::sendPacketBatch() {
+    portENTER_CRITICAL(&packetMux);
+    uint32_t now = millis();
+    uint32_t first = packetHead;
+    size_t count = packetTail - packetHead;
+    bool due = count >= DB_PACKET_BATCH_SIZE ||
+               (count > 0 &&
+                now - packetRing[first % DB_PACKET_RING_CAPACITY].timestamp >= DB_PACKET_LINGER_MS);
+    if (count > DB_PACKET_BATCH_SIZE) {
+        count = DB_PACKET_BATCH_SIZE;
+    }
+    if (due) {
+        for (size_t i = 0; i < count; i++) {
+            packetBatch.rows[i] = packetRing[(first + i) % DB_PACKET_RING_CAPACITY];
+            packetBatch.rows[i].timestamp = now - packetBatch.rows[i].timestamp;
+        }
+    }
+    portEXIT_CRITICAL(&packetMux);
+    
+    if (!due) {
         return false;
     }
     
-    String url = apiBaseUrl + endpoint;
-    http.begin(url);
-    http.addHeader("Content-Type", "application/json");
-    http.setTimeout(5000);
+    uint32_t sendStart = millis();
+    DbSendResult result = sendPackets(count);
+    recordBatchMetrics(result, sendStart);
+    recordResult(result != DB_SEND_FAILED);
+    if (result == DB_SEND_FAILED) {
+        return false;  // Stays queued; retried next pass unless the breaker opened
+    }
     
-    String jsonStr;
-    serializeJson(doc, jsonStr);
+    // Rows overwritten while the batch was in flight already moved the head
+    portENTER_CRITICAL(&packetMux);
+    uint32_t end = first + count;
+    if ((int32_t)(end - packetHead) > 0) {
+        packetHead = end;
+    }
+    size_t remaining = packetTail - packetHead;
+    if (result == DB_SEND_REJECTED) {
+        droppedPackets += count;
+    }
+    portEXIT_CRITICAL(&packetMux);
+    
+    if (result == DB_SEND_REJECTED) {
+        Serial.printf("⚠️  [DB] Backend rejected %d packet rows, dropped\n", count);
+        return true;
+    }
     
-    int httpCode = http.POST(jsonStr);
+    sentPackets += count;
+    Serial.printf("[DB] Sent %d packet rows, %d remaining\n", count, remaining);
+    return true;
+}
+
+/**
+ * Idle health probe: while batches flow their results feed the breaker,
+ * so the backend is only probed after DB_IDLE_PROBE_MS without requests
+ */
+void DatabaseManager::checkConnectionHealth() {
+    if (millis() - lastRequestAt < DB_IDLE_PROBE_MS) {
+        return;
+    }
+    
+    bool healthy = probeBackend();
+    if (!healthy) {
+        Serial.println("⚠️  Database health check failed");
+    }
+    recordResult(healthy);
+}
+
+/**
+ * Check the backend is reachable: GET /health on the REST API, or a Sync
+ * round trip on the PostgreSQL connection (reconnecting if it dropped)
+ */
+bool DatabaseManager::probeBackend() {
+#if DB_BACKEND_POSTGRES
+    if (pg.connected() && pg.ping() == PG_OK) {
+        return true;
+    }
+    return connectPostgres();
+#else
+    static const char* headerKeys[] = { "Accept-Encoding" };
+    http.begin(tcpClient, apiBaseUrl + "/health");
+    http.setTimeout(DB_PROBE_TIMEOUT_MS);
+    http.collectHeaders(headerKeys, 1);
+    int httpCode = http.GET();
+    
+    if (httpCode == 200) {
+        // Content-Encoding negotiation: follow what the API currently accepts
+        bool accepted = http.header("Accept-Encoding").indexOf("gzip") >= 0;
+        if (accepted != gzipAccepted) {
+            Serial.printf("[DB] API %s gzip request bodies\n", accepted ? "accepts" : "does not accept");
+            gzipAccepted = accepted;
+        }
+    }
     http.end();
     
+    if (httpCode != 200) {
+        Serial.printf("⚠️  Database API health check: HTTP %d\n", httpCode);
+    }
+    return httpCode == 200;
+#endif
+}
+
+#if DB_BACKEND_POSTGRES
+/**
+ * Open the PostgreSQL session: authenticate, create the device staging
+ * table and prepare the device merge statement
+ */
+bool DatabaseManager::connectPostgres() {
+    if (!pg.connect(PG_HOST, PG_PORT, PG_USER, PG_PASSWORD, PG_DATABASE, DB_REQUEST_TIMEOUT_MS)) {
+        Serial.printf("⚠️  PostgreSQL connect failed: %s\n", pg.getLastError().c_str());
+        return false;
+    }
+    
+    if (pg.query(PG_DEVICE_STAGE_SQL) != PG_OK ||
+        pg.prepare(PG_DEVICE_MERGE_STMT, PG_DEVICE_MERGE_SQL) != PG_OK ||
+        pg.query(PG_PACKET_STAGE_SQL) != PG_OK ||
+        pg.prepare(PG_PACKET_INSERT_STMT, PG_PACKET_INSERT_SQL) != PG_OK) {
+        Serial.printf("⚠️  PostgreSQL session setup failed: %s\n", pg.getLastError().c_str());
+        pg.close();
+        return false;
+    }
+    
+    Serial.println("[DB] PostgreSQL session ready");
+    ensurePacketPartitions();
+    return true;
+}
+
+/**
+ * Create the current and next month's packets partitions if missing
+ * Failure is not fatal: rows outside any partition land in packets_default
+ */
+void DatabaseManager::ensurePacketPartitions() {
+    lastPartitionCheck = millis();
+    if (pg.query("SELECT ensure_packet_partitions()") != PG_OK) {
+        Serial.printf("⚠️  PostgreSQL packet partition check failed: %s\n",
+                      pg.getLastError().c_str());
+    }
+}
+
+/**
+ * Helper: SQLSTATE classes worth retrying (connection, resources,
+ * operator intervention, serialization); anything else is a bad batch
+ */
+static bool isTransientSqlError(const String& error) {
+    return error.startsWith("08") || error.startsWith("40") ||
+           error.startsWith("53") || error.startsWith("57");
+}
+
+/**
+ * Helper: Map a PostgreSQL batch outcome to a send result, logging failures
+ */
+DbSendResult DatabaseManager::pgSendResult(PgResult result, const char* what) {
+    if (result == PG_OK) {
+        return DB_SEND_OK;
+    }
+    Serial.printf("⚠️  PostgreSQL %s write failed: %s\n", what, pg.getLastError().c_str());
+    failedWrites++;
+    if (result == PG_SQL_ERROR && !isTransientSqlError(pg.getLastError())) {
+        return DB_SEND_REJECTED;
+    }
+    return DB_SEND_FAILED;
+}
+#else
+/**
+ * Helper: Map an API response to a send result
+ * 4xx: the API is up but rejects this batch; retrying it would block the queue
+ */
+static DbSendResult httpSendResult(int httpCode) {
     if (httpCode >= 200 && httpCode < 300) {
-        return true;
+        return DB_SEND_OK;
+    }
+    if (httpCode >= 400 && httpCode < 500) {
+        return DB_SEND_REJECTED;
+    }
+    return DB_SEND_FAILED;
+}
+#endif
+
+/**
+ * Send one serialized batch of writes of a single type
+ */
+DbSendResult DatabaseManager::sendBody(DbWriteType type, const String& body) {
+#if DB_BACKEND_POSTGRES
+    // Reconnect inline so a dropped session does not count as an outage
+    if (!pg.connected() && !connectPostgres()) {
+        return DB_SEND_FAILED;
+    }
+    
+    PgResult result;
+    if (type == DB_WRITE_DEVICE) {
+        result = pg.copyIn(PG_COPY_DEVICES_SQL, body);
+        if (result == PG_OK) {
+            result = pg.execute(PG_DEVICE_MERGE_STMT, NULL, 0);
+        }
+        if (result == PG_SQL_ERROR) {
+            pg.query("TRUNCATE gw_device_stage");  // Keep the bad rows out of the next merge
+        }
     } else {
+        result = pg.copyIn(type == DB_WRITE_COMMAND ? PG_COPY_COMMANDS_SQL : PG_COPY_EVENTS_SQL, body);
+    }
+    
+    return pgSendResult(result, writeEndpoint(type) + 1);
+#else
+    return httpSendResult(postBody(String(writeEndpoint(type)) + "/batch", "application/json",
+                                   (uint8_t*)body.c_str(), body.length()));
+#endif
+}
+
+/**
+ * Send the first count rows of the packet send buffer: one binary POST
+ * (DbPacketBatch) to the API, or COPY into the session staging table and
+ * the prepared insert into packets
+ */
+DbSendResult DatabaseManager::sendPackets(size_t count) {
+#if DB_BACKEND_POSTGRES
+    if (!pg.connected() && !connectPostgres()) {
+        return DB_SEND_FAILED;
+    }
+    
+    String body;
+    body.reserve(count * 40);
+    char row[80];
+    for (size_t i = 0; i < count; i++) {
+        const DbPacketRow& packet = packetBatch.rows[i];
+        snprintf(row, sizeof(row), "%llu\t%lu\t%u\t%d\t%d\t%u\n",
+                 (unsigned long long)packet.deviceId, (unsigned long)packet.timestamp,
+                 packet.sequenceNum, packet.rssi, packet.snr, packet.msgType);
+        body += row;
+    }
+    
+    PgResult result = pg.copyIn(PG_COPY_PACKETS_SQL, body);
+    if (result == PG_OK) {
+        result = pg.execute(PG_PACKET_INSERT_STMT, NULL, 0);
+    }
+    if (result == PG_SQL_ERROR) {
+        pg.query("TRUNCATE gw_packet_stage");
+    }
+    return pgSendResult(result, "packets");
+#else
+    packetBatch.magic = DB_PACKET_BATCH_MAGIC;
+    packetBatch.version = DB_PACKET_BATCH_VERSION;
+    packetBatch.rowSize = sizeof(DbPacketRow);
+    packetBatch.count = count;
+    size_t size = offsetof(DbPacketBatch, rows) + count * sizeof(DbPacketRow);
+    return httpSendResult(postBody("/packets/batch", "application/octet-stream",
+                                   (uint8_t*)&packetBatch, size));
+#endif
+}
+
+/**
+ * POST a body to the API, returns the HTTP status (negative on transport error)
+ * Gzipped when the API accepts it and that makes the body smaller
+ */
+int DatabaseManager::postBody(const String& endpoint, const char* contentType,
+                              uint8_t* data, size_t size) {
+    uint8_t* body = data;
+    size_t bodySize = size;
+    bool compressed = false;
+#if DB_COMPRESSION
+    if (gzipAccepted && size >= DB_COMPRESS_MIN_BYTES && compressor.ready()) {
+        size_t gzipSize = compressor.compress(data, size);
+        if (gzipSize > 0) {
+            body = compressor.output();
+            bodySize = gzipSize;
+            compressed = true;
+        }
+    }
+#endif
+    
+    String url = apiBaseUrl + endpoint;
+    http.begin(tcpClient, url);
+    http.addHeader("Content-Type", contentType);
+    if (compressed) {
+        http.addHeader("Content-Encoding", "gzip");
+    }
+    http.setTimeout(DB_REQUEST_TIMEOUT_MS);
+    
+    int httpCode = http.POST(body, bodySize);
+    http.end();
+    
+    // 415: the API no longer takes gzip (e.g. downgraded); resend as is
+    if (compressed && httpCode == 415) {
+        Serial.println("⚠️  [DB] API rejected gzip body, compression off until next health check");
+        gzipAccepted = false;
+        return postBody(endpoint, contentType, data, size);
+    }
+    
+    bodyBytes += size;
+    wireBytes += bodySize;
+    
+    if (httpCode < 200 || httpCode >= 300) {
         Serial.printf("⚠️  POST %s failed: HTTP %d\n", endpoint.c_str(), httpCode);
         failedWrites++;
-        return false;
     }
+    return httpCode;
 }
 
-void DatabaseManager::queueWrite(const String& endpoint, const JsonDocument& doc) {
-    if (writeQueue.size() >= MAX_QUEUE_SIZE) {
-        // Drop oldest to prevent memory overflow
-        Serial.println("⚠️  Write queue full, dropping oldest");
-        writeQueue.pop();
-        failedWrites++;
+/**
+ * Reserve a ring slot for a new write (queue lock held)
+ * Device writes are state upserts: a pending write for the same device is
+ * returned for update in place, so only the latest state per device is sent
+ * Every write (including an update) gets a fresh seq, so a batch already in
+ * flight with the old state leaves the updated write queued
+ */
+DbWriteRecord* DatabaseManager::allocWrite(DbWriteType type, uint64_t deviceId) {
+    if (type == DB_WRITE_DEVICE) {
+        for (uint16_t i = 0; i < ringCount; i++) {
+            DbWriteRecord* write = &ring[(ringHead + i) % DB_RING_CAPACITY];
+            if (write->type == DB_WRITE_DEVICE && write->deviceId == deviceId) {
+                write->seq = nextWriteSeq++;
+                coalescedWrites++;
+                return write;
+            }
+        }
+    }
+    
+    if (ringCount >= DB_RING_CAPACITY) {
+        if (ringLive < ringCount) {
+            compactRing();
+        } else {
+            evictOldest();
+        }
+    }
+    
+    DbWriteRecord* write = &ring[(ringHead + ringCount) % DB_RING_CAPACITY];
+    memset(write, 0, sizeof(*write));
+    write->seq = nextWriteSeq++;
+    write->timestamp = millis();
+    write->deviceId = deviceId;
+    write->type = type;
+    ringCount++;
+    ringLive++;
+    metricsHighWater(METRIC_DB_QUEUE_HWM, ringLive);
+    return write;
+}
+
+/**
+ * Make room in a full ring by evicting its oldest write (lock held)
+ * Commands and events are staged for flushSpill (dropped if spill is off
+ * or the stage is full). Device writes are simply discarded: a replayed
+ * device state could overwrite a newer one, and the device's next packet
+ * rewrites it anyway, so they are not counted as drops
+ */
+void DatabaseManager::evictOldest() {
+    DbWriteRecord* oldest = &ring[ringHead];    // trimRing keeps the head live
+    
+    if (oldest->type != DB_WRITE_DEVICE) {
+        uint16_t* staged = &spillStageCount[spillStageActive];
+        if (spillEnabled && *staged < DB_SPILL_CHUNK) {
+            spillStage[spillStageActive][(*staged)++] = *oldest;
+        } else {
+            droppedWrites++;
+        }
     }
     
-    PendingWrite write;
-    write.endpoint = endpoint;
-    write.doc = doc;
-    write.timestamp = millis();
-    writeQueue.push(write);
+    releaseWrite(oldest);
+    trimRing();
+}
+
+/**
+ * Remove a queued write, leaving a hole until the head passes it (lock held)
+ */
+void DatabaseManager::releaseWrite(DbWriteRecord* write) {
+    if (write->type != DB_WRITE_NONE) {
+        write->type = DB_WRITE_NONE;
+        ringLive--;
+    }
+}
+
+/**
+ * Advance the ring head past removed writes (lock held)
+ */
+void DatabaseManager::trimRing() {
+    while (ringCount > 0 && ring[ringHead].type == DB_WRITE_NONE) {
+        ringHead = (ringHead + 1) % DB_RING_CAPACITY;
+        ringCount--;
+    }
+}
+
+/**
+ * Close up holes left by removed writes, keeping queue order (lock held)
+ */
+void DatabaseManager::compactRing() {
+    uint16_t kept = 0;
+    for (uint16_t i = 0; i < ringCount; i++) {
+        DbWriteRecord* src = &ring[(ringHead + i) % DB_RING_CAPACITY];
+        if (src->type == DB_WRITE_NONE) {
+            continue;
+        }
+        if (kept != i) {
+            ring[(ringHead + kept) % DB_RING_CAPACITY] = *src;
+            src->type = DB_WRITE_NONE;
+        }
+        kept++;
+    }
+    ringCount = kept;
 }
 
 bool DatabaseManager::writeDevice(uint64_t deviceId, const String& name, const String& location,
@@ -161,36 +963,47 @@ bool DatabaseManager::writeDevice(uint64_t deviceId, const String& name, const S
 #if !DB_API_ENABLED
     return false;  // Silently skip if disabled
 #endif
-
-    JsonDocument doc;
-    // Convert uint64_t to string to avoid truncation on 32-bit systems
-    char deviceIdStr[32];
-    snprintf(deviceIdStr, sizeof(deviceIdStr), "%llu", (unsigned long long)deviceId);
-    doc["device_id"] = deviceIdStr;
-    doc["name"] = name;
-    doc["location"] = location;
-    doc["sensor_type"] = sensorType;
-    doc["last_rssi"] = rssi;
-    doc["last_snr"] = snr;
-    doc["packet_count"] = packetCount;
-    doc["last_sequence"] = lastSequence;
-    doc["sensor_interval"] = sensorInterval;
-    doc["deep_sleep_sec"] = deepSleep;
-    
-    if (status == DB_CONNECTED) {
-        return postJson("/devices", doc);
-    } else {
-        queueWrite("/devices", doc);
-        return false;
+    if (queueMutex == NULL) {
+        return false;  // init() not called yet
     }
+
+    LOCK_WRITES();
+    DbWriteRecord* write = allocWrite(DB_WRITE_DEVICE, deviceId);
+    strlcpy(write->device.name, name.c_str(), sizeof(write->device.name));
+    strlcpy(write->device.location, location.c_str(), sizeof(write->device.location));
+    strlcpy(write->device.sensorType, sensorType.c_str(), sizeof(write->device.sensorType));
+    write->device.rssi = rssi;
+    write->device.snr = snr;
+    write->device.packetCount = packetCount;
+    write->device.lastSequence = lastSequence;
+    write->device.sensorInterval = sensorInterval;
+    write->device.deepSleep = deepSleep;
+    UNLOCK_WRITES();
+    
+    return true;
 }
 
-bool DatabaseManager::writePacket(uint64_t deviceId, const String& gatewayId, uint8_t msgType,
-                                  uint16_t sequenceNum, int16_t rssi, int16_t snr,
-                                  const JsonDocument& payload) {
-    // Packets go to MQTT → timeseries DB, not PostgreSQL
-    // This database is for device registry only
+/**
+ * Append a packet history row; a full ring overwrites its oldest row
+ * (packet history is best effort, unlike commands and events)
+ */
+bool DatabaseManager::writePacket(uint64_t deviceId, uint8_t msgType, uint16_t sequenceNum,
+                                  int16_t rssi, int8_t snr, uint32_t receivedAt) {
+#if !DB_API_ENABLED
     return false;
+#endif
+    DbPacketRow row = { deviceId, receivedAt, sequenceNum, rssi, snr, msgType };
+    
+    portENTER_CRITICAL(&packetMux);
+    if (packetTail - packetHead >= DB_PACKET_RING_CAPACITY) {
+        packetHead++;
+        droppedPackets++;
+    }
+    packetRing[packetTail % DB_PACKET_RING_CAPACITY] = row;
+    packetTail++;
+    portEXIT_CRITICAL(&packetMux);
+    
+    return true;
 }
 
 bool DatabaseManager::writeCommand(uint64_t deviceId, uint8_t commandType, const String& params,
@@ -198,22 +1011,18 @@ bool DatabaseManager::writeCommand(uint64_t deviceId, uint8_t commandType, const
 #if !DB_API_ENABLED
     return false;
 #endif
-    
-    JsonDocument doc;
-    // Convert uint64_t to string to avoid truncation on 32-bit systems
-    char deviceIdStr[32];
-    snprintf(deviceIdStr, sizeof(deviceIdStr), "%llu", (unsigned long long)deviceId);
-    doc["device_id"] = deviceIdStr;
-    doc["command_type"] = commandType;
-    doc["parameters"] = params;
-    doc["status"] = statusStr;
-    
-    if (status == DB_CONNECTED) {
-        return postJson("/commands", doc);
-    } else {
-        queueWrite("/commands", doc);
+    if (queueMutex == NULL) {
         return false;
     }
+    
+    LOCK_WRITES();
+    DbWriteRecord* write = allocWrite(DB_WRITE_COMMAND, deviceId);
+    write->command.commandType = commandType;
+    strlcpy(write->command.params, params.c_str(), sizeof(write->command.params));
+    strlcpy(write->command.status, statusStr.c_str(), sizeof(write->command.status));
+    UNLOCK_WRITES();
+    
+    return true;
 }
 
 bool DatabaseManager::writeEvent(uint64_t deviceId, uint8_t eventType, uint8_t severity,
@@ -221,20 +1030,42 @@ bool DatabaseManager::writeEvent(uint64_t deviceId, uint8_t eventType, uint8_t s
 #if !DB_API_ENABLED
     return false;
 #endif
+    if (queueMutex == NULL) {
+        return false;
+    }
     
-    JsonDocument doc;
-    // Convert uint64_t to string to avoid truncation on 32-bit systems
-    char deviceIdStr[32];
-    snprintf(deviceIdStr, sizeof(deviceIdStr), "%llu", (unsigned long long)deviceId);
-    doc["device_id"] = deviceIdStr;
-    doc["event_type"] = eventType;
-    doc["severity"] = severity;
-    doc["message"] = message;
+    LOCK_WRITES();
+    DbWriteRecord* write = allocWrite(DB_WRITE_EVENT, deviceId);
+    write->event.eventType = eventType;
+    write->event.severity = severity;
+    strlcpy(write->event.message, message.c_str(), sizeof(write->event.message));
+    UNLOCK_WRITES();
     
-    if (status == DB_CONNECTED) {
-        return postJson("/events", doc);
-    } else {
-        queueWrite("/events", doc);
-        return false;
+    return true;
+}
+
+uint32_t DatabaseManager::getDroppedWrites() const {
+    return droppedWrites + getDbSpillDropped();
+}
+
+uint32_t DatabaseManager::getSpilledWrites() const {
+    return getDbSpillRecords();
+}
+
+size_t DatabaseManager::getPacketQueueDepth() const {
+    return packetTail - packetHead;
+}
+
+/**
+ * Database worker task (runs on Core 1)
+ * HTTP requests block for up to their timeout; doing them here keeps
+ * OTA, serial commands and the display in loop() responsive
+ */
+void dbTask(void* parameter) {
+    Serial.println("[DB Task] Started on Core 1");
+    
+    while (true) {
+        dbManager.loop();
+        vTaskDelay(pdMS_TO_TICKS(DB_TASK_INTERVAL_MS));
     }
 }
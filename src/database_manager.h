@@ -4,8 +4,114 @@
 #include <Arduino.h>
 #include <ArduinoJson.h>
 #include <HTTPClient.h>
-#include <queue>
-#include <vector>
+#include <WiFiClient.h>
+
+// Backend: the REST API service (default) or, with DB_BACKEND_POSTGRES=1,
+// PostgreSQL directly over its wire protocol using the PG_* build flags
+// (one persistent connection, COPY for batches, prepared device merge)
+#ifndef DB_BACKEND_POSTGRES
+#define DB_BACKEND_POSTGRES 0
+#endif
+
+#if DB_BACKEND_POSTGRES
+#include "pg_client.h"
+#endif
+
+// Request body compression (REST mode): bodies of at least
+// DB_COMPRESS_MIN_BYTES are sent gzipped (Content-Encoding: gzip) once the
+// API lists gzip in the Accept-Encoding header of its /health response
+// (RFC 7694); a 415 reply turns it off again. Compressed bodies larger than
+// DB_COMPRESS_MAX_BYTES (the preallocated output buffer) are sent as is
+#ifndef DB_COMPRESSION
+#define DB_COMPRESSION !DB_BACKEND_POSTGRES
+#endif
+#define DB_COMPRESS_MIN_BYTES 256
+#define DB_COMPRESS_MAX_BYTES 16384
+
+#if DB_COMPRESSION
+#include "gzip_compressor.h"
+#endif
+
+// Pending writes are coalesced into one JSON-array POST per endpoint
+// (<endpoint>/batch); a batch is sent when DB_BATCH_MAX_SIZE writes are
+// waiting or the oldest has waited DB_BATCH_LINGER_MS
+#ifndef DB_BATCH_MAX_SIZE
+#define DB_BATCH_MAX_SIZE 50
+#endif
+#ifndef DB_BATCH_LINGER_MS
+#define DB_BATCH_LINGER_MS 2000
+#endif
+
+// Preallocated write ring (compact fixed-size records, no per-write heap);
+// when it is full the oldest writes are staged and spilled to flash by the
+// DB task (see db_spill.h)
+#ifndef DB_RING_CAPACITY
+#define DB_RING_CAPACITY 256
+#endif
+// Ring overflow staged in RAM between two DB task passes; overflow beyond
+// this before the DB task runs again is dropped
+#ifndef DB_SPILL_CHUNK
+#define DB_SPILL_CHUNK 16
+#endif
+
+// Fixed field sizes of queued writes (longer strings are truncated)
+#define DB_NAME_MAX 32            // Matches LoRa status deviceName/location
+#define DB_SENSOR_TYPE_MAX 16
+#define DB_COMMAND_PARAMS_MAX 64
+#define DB_COMMAND_STATUS_MAX 12
+#define DB_EVENT_MESSAGE_MAX 96
+
+// Packet history: every received packet is appended as a compact 18-byte
+// row to its own preallocated ring (no JSON, no heap, spinlock only) and
+// flushed as one binary POST to /packets/batch (or one COPY in PostgreSQL
+// mode) when DB_PACKET_BATCH_SIZE rows are waiting or the oldest has waited
+// DB_PACKET_LINGER_MS. While the API is down the oldest rows are overwritten
+#ifndef DB_PACKET_RING_CAPACITY
+#define DB_PACKET_RING_CAPACITY 512          // Power of two (~9 KB)
+#endif
+#ifndef DB_PACKET_BATCH_SIZE
+#define DB_PACKET_BATCH_SIZE 128
+#endif
+#ifndef DB_PACKET_LINGER_MS
+#define DB_PACKET_LINGER_MS 10000
+#endif
+#define DB_PACKET_BATCH_MAGIC 0x544B504C     // "LPKT"
+#define DB_PACKET_BATCH_VERSION 1
+
+// Circuit breaker around the API: DB_CONNECTED = closed, DB_DISCONNECTED =
+// open (backing off), DB_RECONNECTING = half-open (probe in flight)
+// Trips on DB_BREAKER_TRIP_FAILURES failures in a row, or when at least
+// DB_BREAKER_FAILURE_PERCENT of the last DB_BREAKER_WINDOW requests failed
+#ifndef DB_BREAKER_WINDOW
+#define DB_BREAKER_WINDOW 16                 // Requests tracked (max 32)
+#endif
+#ifndef DB_BREAKER_MIN_SAMPLES
+#define DB_BREAKER_MIN_SAMPLES 4
+#endif
+#ifndef DB_BREAKER_FAILURE_PERCENT
+#define DB_BREAKER_FAILURE_PERCENT 50
+#endif
+#ifndef DB_BREAKER_TRIP_FAILURES
+#define DB_BREAKER_TRIP_FAILURES 3
+#endif
+// Open-state backoff doubles per consecutive trip (with jitter) up to the max
+#ifndef DB_BREAKER_BACKOFF_MIN_MS
+#define DB_BREAKER_BACKOFF_MIN_MS 1000
+#endif
+#ifndef DB_BREAKER_BACKOFF_MAX_MS
+#define DB_BREAKER_BACKOFF_MAX_MS 60000
+#endif
+// Health probes use short timeouts so a dead endpoint fails fast
+#define DB_PROBE_TIMEOUT_MS 1500
+#define DB_CONNECT_TIMEOUT_MS 2000
+#define DB_REQUEST_TIMEOUT_MS 5000
+#define DB_IDLE_PROBE_MS 60000               // Probe when closed but idle
+
+// Database worker task: runs all persistence (and its network waits) off
+// loop(), at the lowest application priority
+#define DB_TASK_STACK_SIZE 8192
+#define DB_TASK_PRIORITY 1
+#define DB_TASK_INTERVAL_MS 100
 
 enum DatabaseStatus {
     DB_CONNECTED,
@@ -13,12 +119,72 @@ enum DatabaseStatus {
     DB_RECONNECTING
 };
 
-struct PendingWrite {
-    String endpoint;
-    JsonDocument doc;
-    uint32_t timestamp;
+enum DbWriteType : uint8_t {
+    DB_WRITE_NONE = 0,        // Free slot or removed write
+    DB_WRITE_DEVICE,
+    DB_WRITE_COMMAND,
+    DB_WRITE_EVENT
 };
 
+// Outcome of sending one batch to the backend
+enum DbSendResult {
+    DB_SEND_OK,
+    DB_SEND_REJECTED,         // Backend up but refused the batch (dropped, not retried)
+    DB_SEND_FAILED            // Backend unreachable or transient error (retried)
+};
+
+// One queued write; serialized (JSON or COPY row) only when its batch is sent
+struct DbWriteRecord {
+    uint32_t seq;             // Unique per write; changes when a device write is coalesced
+    uint32_t timestamp;       // When first queued (batch linger)
+    uint64_t deviceId;
+    DbWriteType type;
+    union {
+        struct {
+            char name[DB_NAME_MAX];
+            char location[DB_NAME_MAX];
+            char sensorType[DB_SENSOR_TYPE_MAX];
+            int16_t rssi;
+            int16_t snr;
+            uint32_t packetCount;
+            uint16_t lastSequence;
+            uint16_t sensorInterval;
+            uint16_t deepSleep;
+        } device;
+        struct {
+            uint8_t commandType;
+            char status[DB_COMMAND_STATUS_MAX];
+            char params[DB_COMMAND_PARAMS_MAX];
+        } command;
+        struct {
+            uint8_t eventType;
+            uint8_t severity;
+            char message[DB_EVENT_MESSAGE_MAX];
+        } event;
+    };
+};
+
+// One packet history row; also the wire format of /packets/batch rows
+// (little-endian), where timestamp is sent as the row's age in ms because
+// the gateway has no wall clock (the server derives received_at from it)
+struct DbPacketRow {
+    uint64_t deviceId;
+    uint32_t timestamp;       // millis() when received; age in ms on the wire
+    uint16_t sequenceNum;
+    int16_t rssi;
+    int8_t snr;
+    uint8_t msgType;
+} __attribute__((packed));
+
+// Binary body of POST /packets/batch
+struct DbPacketBatch {
+    uint32_t magic;           // DB_PACKET_BATCH_MAGIC
+    uint8_t version;          // DB_PACKET_BATCH_VERSION
+    uint8_t rowSize;          // sizeof(DbPacketRow)
+    uint16_t count;
+    DbPacketRow rows[DB_PACKET_BATCH_SIZE];
+} __attribute__((packed));
+
 class DatabaseManager {
 public:
     DatabaseManager();
@@ -27,17 +193,17 @@ public:
     // Initialize and connect to database API
     void init();
     
-    // Main loop - call from main loop
+    // Worker step - called repeatedly by dbTask
     void loop();
     
-    // Write operations (async)
+    // Write operations (async, always queued and sent in batches)
     bool writeDevice(uint64_t deviceId, const String& name, const String& location,
                     const String& sensorType, int16_t rssi, int16_t snr, uint32_t packetCount,
                     uint16_t lastSequence, uint16_t sensorInterval, uint16_t deepSleep);
     
-    bool writePacket(uint64_t deviceId, const String& gatewayId, uint8_t msgType,
-                    uint16_t sequenceNum, int16_t rssi, int16_t snr, 
-                    const JsonDocument& payload);
+    // Packet history row (called per received packet; never blocks)
+    bool writePacket(uint64_t deviceId, uint8_t msgType, uint16_t sequenceNum,
+                    int16_t rssi, int8_t snr, uint32_t receivedAt);
     
     bool writeCommand(uint64_t deviceId, uint8_t commandType, const String& params,
                      const String& status);
@@ -47,28 +213,105 @@ public:
     
     // Status
     DatabaseStatus getStatus() const { return status; }
-    size_t getQueueDepth() const { return writeQueue.size(); }
+    size_t getQueueDepth() const { return ringLive; }
     uint32_t getFailedWrites() const { return failedWrites; }
+    uint32_t getBreakerTrips() const { return breakerTrips; }
+    uint32_t getCoalescedWrites() const { return coalescedWrites; }
+    uint32_t getDroppedWrites() const;      // RAM ring overflow plus flash spill cap
+    uint32_t getSpilledWrites() const;      // Writes on flash awaiting replay
+    size_t getPacketQueueDepth() const;
+    uint32_t getSentPackets() const { return sentPackets; }
+    uint32_t getDroppedPackets() const { return droppedPackets; }
+    uint32_t getBodyBytes() const { return bodyBytes; }     // Request bodies before compression
+    uint32_t getWireBytes() const { return wireBytes; }     // As sent
     
 private:
     HTTPClient http;
+    WiFiClient tcpClient;     // Kept open between requests (HTTP keep-alive)
+#if DB_BACKEND_POSTGRES
+    PgClient pg;
+#endif
     DatabaseStatus status;
-    std::queue<PendingWrite> writeQueue;
-    uint32_t lastReconnectAttempt;
     uint32_t failedWrites;
-    uint32_t reconnectAttempts;
     String apiBaseUrl;
+#if DB_COMPRESSION
+    GzipCompressor compressor;      // Context allocated once in init()
+#endif
+    bool gzipAccepted;              // API advertised gzip request bodies
+    uint32_t bodyBytes;
+    uint32_t wireBytes;
+    SemaphoreHandle_t queueMutex;   // Writers run on the MQTT task, sender on loop()
+    uint32_t nextWriteSeq;
+    uint32_t coalescedWrites;       // Device writes that replaced a pending one
+    uint32_t droppedWrites;         // Unsent writes lost because the ring was full
+    bool spillEnabled;              // Ring overflow goes to flash (db_spill)
+    uint32_t lastSpillReplay;
+    uint32_t reportedDrops;         // droppedWrites already logged by flushSpill
+    
+    // Ring overflow waiting for flushSpill: writers fill the active buffer
+    // under the queue lock (a memcpy, no flash I/O); the DB task swaps
+    // buffers and writes the full one to flash outside the lock
+    DbWriteRecord spillStage[2][DB_SPILL_CHUNK];
+    uint16_t spillStageCount[2];
+    uint8_t spillStageActive;
+    
+    // Write ring: slots [ringHead, ringHead + ringCount) in queue order;
+    // removed writes leave DB_WRITE_NONE holes until head passes them
+    DbWriteRecord ring[DB_RING_CAPACITY];
+    uint16_t ringHead;
+    uint16_t ringCount;
+    uint16_t ringLive;              // Slots in use that hold a write
     
-    static const size_t MAX_QUEUE_SIZE = 1000;
-    static const uint32_t RECONNECT_INTERVAL = 30000;  // 30 seconds
+    // Packet ring: rows [packetHead, packetTail) as absolute counts, indexed
+    // modulo DB_PACKET_RING_CAPACITY; guarded by a spinlock, not queueMutex
+    DbPacketRow packetRing[DB_PACKET_RING_CAPACITY];
+    uint32_t packetHead;
+    uint32_t packetTail;
+    uint32_t sentPackets;
+    uint32_t droppedPackets;        // Overwritten while queued, or rejected by the backend
+    DbPacketBatch packetBatch;      // Send buffer (kept off the DB task stack)
+#if DB_BACKEND_POSTGRES
+    uint32_t lastPartitionCheck;
+#endif
+    
+    // Circuit breaker
+    uint32_t windowFailures;        // Bit per recent request, 1 = failed (newest in bit 0)
+    uint8_t windowCount;
+    uint8_t consecutiveFailures;
+    uint8_t backoffLevel;           // Trips since the breaker last stayed closed
+    uint32_t breakerTrips;
+    uint32_t openedAt;
+    uint32_t backoffMs;
+    uint32_t lastRequestAt;
     
     void attemptConnection();
     void processWriteQueue();
     void checkConnectionHealth();
-    bool postJson(const String& endpoint, const JsonDocument& doc);
-    void queueWrite(const String& endpoint, const JsonDocument& doc);
+    void recordResult(bool ok);
+    void tripBreaker();
+    bool probeBackend();
+    bool sendBatch();
+    bool sendPacketBatch();
+    DbSendResult sendPackets(size_t count);
+    DbSendResult sendBody(DbWriteType type, const String& body);
+    int postBody(const String& endpoint, const char* contentType, uint8_t* data, size_t size);
+#if DB_BACKEND_POSTGRES
+    bool connectPostgres();
+    void ensurePacketPartitions();
+    DbSendResult pgSendResult(PgResult result, const char* what);
+#endif
+    DbWriteRecord* allocWrite(DbWriteType type, uint64_t deviceId);
+    void releaseWrite(DbWriteRecord* write);
+    void trimRing();
+    void compactRing();
+    void evictOldest();
+    void flushSpill();
+    void replaySpill();
 };
 
 extern DatabaseManager dbManager;
 
+// Database worker task (runs on Core 1)
+void dbTask(void* parameter);
+
 #endif // DATABASE_MANAGER_H
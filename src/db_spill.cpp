@@ -0,0 +1,344 @@
+/**
+ * Database Spill - LoRa Gateway
+ * Keeps command and event history through long API outages by moving
+ * writes that overflow the RAM ring into LittleFS segment files
+ */
+
+#include "db_spill.h"
+#include <LittleFS.h>
+
+#define SPILL_MAGIC 0x50534244   // "DBSP"
+#define SPILL_VERSION 1
+
+struct SpillSegmentHeader {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t deviceSize;       // Record variant sizes; change with the DB_* field sizes
+    uint8_t commandSize;
+    uint8_t eventSize;
+} __attribute__((packed));
+
+// One spilled write, followed by the variant fields of its type
+struct SpillRecordHeader {
+    uint8_t type;             // DbWriteType
+    uint64_t deviceId;
+} __attribute__((packed));
+
+static bool spillEnabled = false;
+static uint32_t firstSegment = 0;     // Oldest segment (replayed next)
+static uint32_t endSegment = 0;       // One past the newest segment
+static uint32_t appendFrom = 0;       // First segment created this boot
+static uint32_t readOffset = 0;       // Replay position in the oldest segment
+static uint32_t spillBytes = 0;
+static uint32_t spillRecords = 0;
+static uint32_t droppedRecords = 0;
+
+/**
+ * Helper: Size of the variant fields stored for a write type (0 = invalid)
+ */
+static size_t variantSize(uint8_t type) {
+    switch (type) {
+        case DB_WRITE_DEVICE:  return sizeof(DbWriteRecord::device);
+        case DB_WRITE_COMMAND: return sizeof(DbWriteRecord::command);
+        case DB_WRITE_EVENT:   return sizeof(DbWriteRecord::event);
+        default:               return 0;
+    }
+}
+
+/**
+ * Helper: Start of the variant fields (all variants share the union storage)
+ */
+static uint8_t* variantData(DbWriteRecord* write) {
+    return (uint8_t*)&write->device;
+}
+
+static void segmentPath(uint32_t segment, char* path, size_t len) {
+    snprintf(path, len, DB_SPILL_DIR "/seg_%08lu.bin", (unsigned long)segment);
+}
+
+static bool isValidHeader(const SpillSegmentHeader& header) {
+    return header.magic == SPILL_MAGIC && header.version == SPILL_VERSION &&
+           header.deviceSize == variantSize(DB_WRITE_DEVICE) &&
+           header.commandSize == variantSize(DB_WRITE_COMMAND) &&
+           header.eventSize == variantSize(DB_WRITE_EVENT);
+}
+
+/**
+ * Helper: Count complete records from offset to the end of a segment
+ * Stops at a torn record (reset mid-append)
+ */
+static uint32_t countRecords(File& file, size_t offset) {
+    uint32_t count = 0;
+    size_t fileSize = file.size();
+    SpillRecordHeader header;
+
+    file.seek(offset);
+    while (file.read((uint8_t*)&header, sizeof(header)) == sizeof(header)) {
+        size_t size = variantSize(header.type);
+        offset += sizeof(header) + size;
+        if (size == 0 || offset > fileSize) {
+            break;
+        }
+        file.seek(offset);
+        count++;
+    }
+    return count;
+}
+
+/**
+ * Helper: Delete the oldest segment, dropping any records not yet replayed
+ */
+static void dropOldestSegment() {
+    char path[40];
+    segmentPath(firstSegment, path, sizeof(path));
+
+    File file = LittleFS.open(path, "r");
+    if (file) {
+        uint32_t unread = countRecords(file, readOffset > 0 ? readOffset : sizeof(SpillSegmentHeader));
+        spillBytes = spillBytes > file.size() ? spillBytes - file.size() : 0;
+        spillRecords = spillRecords > unread ? spillRecords - unread : 0;
+        droppedRecords += unread;
+        file.close();
+        LittleFS.remove(path);
+
+        Serial.printf("⚠️  [SPILL] Flash cap reached, dropped segment %lu (%lu writes)\n",
+                      (unsigned long)firstSegment, (unsigned long)unread);
+    }
+
+    firstSegment++;
+    readOffset = 0;
+}
+
+/**
+ * Helper: Open the newest segment for append, rotating to a new one when it
+ * is full; segments from a previous boot are never appended to (a torn tail
+ * record would hide everything written after it)
+ */
+static File openAppendSegment() {
+    char path[40];
+
+    if (endSegment != firstSegment && endSegment - 1 >= appendFrom) {
+        segmentPath(endSegment - 1, path, sizeof(path));
+        File file = LittleFS.open(path, "a");
+        if (file && file.size() < DB_SPILL_SEGMENT_BYTES) {
+            return file;
+        }
+        if (file) {
+            file.close();
+        }
+    }
+
+    segmentPath(endSegment, path, sizeof(path));
+    File file = LittleFS.open(path, "w");
+    if (!file) {
+        return file;
+    }
+
+    SpillSegmentHeader header = {
+        SPILL_MAGIC, SPILL_VERSION,
+        (uint8_t)variantSize(DB_WRITE_DEVICE),
+        (uint8_t)variantSize(DB_WRITE_COMMAND),
+        (uint8_t)variantSize(DB_WRITE_EVENT)
+    };
+    file.write((const uint8_t*)&header, sizeof(header));
+    spillBytes += sizeof(header);
+    if (firstSegment == endSegment) {
+        readOffset = 0;
+    }
+    endSegment++;
+    return file;
+}
+
+/**
+ * Scan existing segments left by a previous boot
+ */
+bool initDbSpill() {
+    if (!LittleFS.exists(DB_SPILL_DIR) && !LittleFS.mkdir(DB_SPILL_DIR)) {
+        Serial.println("⚠️  [SPILL] Cannot create spill directory, flash spill disabled");
+        return false;
+    }
+
+    File dir = LittleFS.open(DB_SPILL_DIR);
+    if (!dir || !dir.isDirectory()) {
+        Serial.println("⚠️  [SPILL] Cannot open spill directory, flash spill disabled");
+        return false;
+    }
+
+    // Find the range of segment numbers on flash
+    bool found = false;
+    uint32_t minSegment = 0;
+    uint32_t maxSegment = 0;
+    File entry = dir.openNextFile();
+    while (entry) {
+        const char* name = strrchr(entry.name(), '/');
+        name = name ? name + 1 : entry.name();
+        unsigned long segment;
+        if (sscanf(name, "seg_%lu.bin", &segment) == 1) {
+            if (!found || segment < minSegment) minSegment = segment;
+            if (!found || segment > maxSegment) maxSegment = segment;
+            found = true;
+        }
+        entry.close();
+        entry = dir.openNextFile();
+    }
+    dir.close();
+
+    if (found) {
+        firstSegment = minSegment;
+        endSegment = maxSegment + 1;
+
+        for (uint32_t segment = firstSegment; segment != endSegment; segment++) {
+            char path[40];
+            segmentPath(segment, path, sizeof(path));
+            File file = LittleFS.open(path, "r");
+            if (!file) {
+                continue;
+            }
+
+            SpillSegmentHeader header;
+            if (file.read((uint8_t*)&header, sizeof(header)) != sizeof(header) ||
+                !isValidHeader(header)) {
+                Serial.printf("⚠️  [SPILL] Unknown segment format, discarding %s\n", path);
+                file.close();
+                LittleFS.remove(path);
+                continue;
+            }
+
+            spillBytes += file.size();
+            spillRecords += countRecords(file, sizeof(header));
+            file.close();
+        }
+    }
+
+    appendFrom = endSegment;
+    spillEnabled = true;
+
+    if (spillRecords > 0) {
+        Serial.printf("💾 [SPILL] %lu spilled writes in %lu segments awaiting replay\n",
+                      (unsigned long)spillRecords, (unsigned long)(endSegment - firstSegment));
+    }
+    return true;
+}
+
+/**
+ * Append writes to the newest segment
+ */
+size_t spillDbWrites(const DbWriteRecord* const* writes, size_t count) {
+    if (!spillEnabled || count == 0) {
+        return 0;
+    }
+
+    File file = openAppendSegment();
+    size_t stored = 0;
+
+    for (size_t i = 0; i < count && file; i++) {
+        size_t size = variantSize(writes[i]->type);
+        if (size == 0) {
+            continue;
+        }
+
+        // Rotate once the segment is full
+        if (file.size() >= DB_SPILL_SEGMENT_BYTES) {
+            file.close();
+            file = openAppendSegment();
+            if (!file) {
+                break;
+            }
+        }
+
+        SpillRecordHeader header = { (uint8_t)writes[i]->type, writes[i]->deviceId };
+        file.write((const uint8_t*)&header, sizeof(header));
+        file.write(variantData((DbWriteRecord*)writes[i]), size);
+        spillBytes += sizeof(header) + size;
+        spillRecords++;
+        stored++;
+    }
+
+    if (file) {
+        file.close();
+    } else {
+        Serial.println("⚠️  [SPILL] Failed to open spill segment");
+    }
+
+    // Keep total flash use under the cap, oldest history goes first
+    while (spillBytes > DB_SPILL_MAX_BYTES && endSegment - firstSegment > 1) {
+        dropOldestSegment();
+    }
+
+    return stored;
+}
+
+/**
+ * Read (and consume) the oldest spilled writes
+ * Fully replayed segments are deleted
+ */
+size_t readDbSpill(DbWriteRecord* out, size_t maxCount) {
+    size_t count = 0;
+
+    while (spillEnabled && count < maxCount && firstSegment != endSegment) {
+        char path[40];
+        segmentPath(firstSegment, path, sizeof(path));
+        File file = LittleFS.open(path, "r");
+        if (!file) {
+            // Gap left by a discarded segment
+            firstSegment++;
+            readOffset = 0;
+            continue;
+        }
+
+        size_t fileSize = file.size();
+        if (readOffset == 0) {
+            readOffset = sizeof(SpillSegmentHeader);
+        }
+        file.seek(readOffset);
+
+        while (count < maxCount && readOffset < fileSize) {
+            SpillRecordHeader header;
+            DbWriteRecord* write = &out[count];
+            memset(write, 0, sizeof(*write));
+
+            size_t size = 0;
+            if (file.read((uint8_t*)&header, sizeof(header)) == sizeof(header)) {
+                size = variantSize(header.type);
+            }
+            if (size == 0 || file.read(variantData(write), size) != size) {
+                // Torn tail from a reset mid-append; not counted at boot either
+                readOffset = fileSize;
+                break;
+            }
+
+            write->type = (DbWriteType)header.type;
+            write->deviceId = header.deviceId;
+            readOffset += sizeof(header) + size;
+            if (spillRecords > 0) {
+                spillRecords--;
+            }
+            count++;
+        }
+        file.close();
+
+        if (readOffset < fileSize) {
+            break;  // maxCount reached
+        }
+
+        // Segment fully replayed (the next spill starts a new one)
+        LittleFS.remove(path);
+        spillBytes = spillBytes > fileSize ? spillBytes - fileSize : 0;
+        firstSegment++;
+        readOffset = 0;
+    }
+
+    return count;
+}
+
+uint32_t getDbSpillRecords() {
+    return spillRecords;
+}
+
+uint32_t getDbSpillBytes() {
+    return spillBytes;
+}
+
+uint32_t getDbSpillDropped() {
+    return droppedRecords;
+}
@@ -0,0 +1,55 @@
+#ifndef DB_SPILL_H
+#define DB_SPILL_H
+
+#include <Arduino.h>
+#include "database_manager.h"
+
+// Flash spill for database writes that overflow the RAM ring during long
+// API outages. Records are appended to LittleFS segment files in a compact
+// binary form (type, device id, fixed fields; no JSON) and replayed oldest
+// first once the API is reachable again
+#define DB_SPILL_DIR "/dbspill"
+
+// Segment rotation size and total flash cap; when the cap is exceeded the
+// oldest segment is deleted and its unreplayed records are counted as dropped
+#ifndef DB_SPILL_SEGMENT_BYTES
+#define DB_SPILL_SEGMENT_BYTES 16384
+#endif
+#ifndef DB_SPILL_MAX_BYTES
+#define DB_SPILL_MAX_BYTES (16 * DB_SPILL_SEGMENT_BYTES)
+#endif
+
+// Replay rate: at most DB_SPILL_REPLAY_BATCH records every
+// DB_SPILL_REPLAY_INTERVAL_MS, and only while the RAM ring is under half full
+#ifndef DB_SPILL_REPLAY_BATCH
+#define DB_SPILL_REPLAY_BATCH 16
+#endif
+#ifndef DB_SPILL_REPLAY_INTERVAL_MS
+#define DB_SPILL_REPLAY_INTERVAL_MS 250
+#endif
+
+// NOTE: Not thread-safe on its own; only the DB task calls these, outside
+// the write queue lock (writers never touch flash)
+
+// Scan existing segments (call once LittleFS is mounted)
+// Returns false if the spill directory cannot be used (spill disabled)
+bool initDbSpill();
+
+// Append writes to the newest segment, rotating and enforcing the flash cap
+// Returns number of writes stored
+size_t spillDbWrites(const DbWriteRecord* const* writes, size_t count);
+
+// Read (and consume) up to maxCount of the oldest spilled writes
+// seq and timestamp of the returned records are left 0 for the caller to assign
+size_t readDbSpill(DbWriteRecord* out, size_t maxCount);
+
+// Spilled writes waiting for replay
+uint32_t getDbSpillRecords();
+
+// Bytes of flash used by spill segments
+uint32_t getDbSpillBytes();
+
+// Spilled writes lost to the flash cap or unreadable segments
+uint32_t getDbSpillDropped();
+
+#endif // DB_SPILL_H
@@ -1,9 +1,11 @@
 #include "device_registry.h"
 #include "device_config.h"
 #include "command_sender.h"
+#include "lora_protocol.h"
 #include "database_manager.h"
 #include <LittleFS.h>
 #include <ArduinoJson.h>
+#include <memory>
 
 // Device registry storage
 static DeviceInfo devices[MAX_SENSORS];
@@ -19,6 +21,29 @@ static SemaphoreHandle_t registryMutex = NULL;
 #define LOCK_REGISTRY() if (registryMutex) xSemaphoreTake(registryMutex, portMAX_DELAY)
 #define UNLOCK_REGISTRY() if (registryMutex) xSemaphoreGive(registryMutex)
 
+// Registry version: bumped on every device change (registry lock held),
+// which also stamps the device with the new version (delta queries) and
+// marks its slot for the web server's push stream
+static uint32_t registryVersion = 1;
+static uint32_t deviceVersion[MAX_SENSORS];
+static uint8_t changedSlots[REGISTRY_SLOT_MASK_BYTES];
+#define MARK_CHANGED(slot) (changedSlots[(slot) / 8] |= 1 << ((slot) % 8), \
+                            deviceVersion[slot] = ++registryVersion)
+
+// Command queue state per device as of syncedQueueVersion; queue changes
+// are folded into the device versions lazily (see syncQueueVersions)
+static uint32_t queueSignature[MAX_SENSORS];
+static uint32_t syncedQueueVersion = 0;
+
+// Serialized object per device, rebuilt only when that device's version
+// moved on. Immutable once built: a response still streaming an older one
+// keeps it alive through its pointer
+static std::shared_ptr<const String> deviceFragments[MAX_SENSORS];
+static uint32_t fragmentVersion[MAX_SENSORS];
+
+// Random per boot, so ETags from before a reboot never match
+static uint32_t bootId = 0;
+
 /**
  * Initialize device registry
  * Loads existing registry from filesystem
@@ -31,6 +56,7 @@ void initDeviceRegistry() {
     if (registryMutex == NULL) {
         Serial.println("❌ Failed to create registry mutex!");
     }
+    bootId = esp_random();
     
     // Initialize LittleFS
     if (!LittleFS.begin(true)) {
@@ -110,6 +136,7 @@ void updateDeviceName(uint64_t deviceId, const String& name) {
                 Serial.printf("📝 Updating device name: '%s' -> '%s'\n", 
                              devices[i].deviceName.c_str(), name.c_str());
                 devices[i].deviceName = name;
+                MARK_CHANGED(i);
                 UNLOCK_REGISTRY();
                 saveRegistry();  // Persist changes
                 return;
@@ -140,6 +167,7 @@ void updateDeviceLocation(uint64_t deviceId, const String& location) {
                 Serial.printf("📍 Updating device location: '%s' -> '%s'\n", 
                              devices[i].location.c_str(), location.c_str());
                 devices[i].location = location;
+                MARK_CHANGED(i);
                 UNLOCK_REGISTRY();
                 saveRegistry();  // Persist changes
                 return;
@@ -189,6 +217,7 @@ void updateDeviceInfo(uint64_t deviceId, uint16_t seqNum, int16_t rssi, int8_t s
     // Add to deduplication buffer
     device->sequenceBuffer[device->bufferIndex] = seqNum;
     device->bufferIndex = (device->bufferIndex + 1) % DEDUP_BUFFER_SIZE;
+    MARK_CHANGED(device - devices);
     
     // Write to database (async, non-blocking)
     dbManager.writeDevice(
@@ -284,12 +313,15 @@ void addDevice(uint64_t deviceId, const String& name, const String& location) {
     devices[deviceCount].bufferIndex = 0;
     devices[deviceCount].sensorInterval = 60;  // Default
     devices[deviceCount].deepSleepSec = 90;    // Default
+    devices[deviceCount].capabilities = 0;     // Legacy until advertised
+    devices[deviceCount].groupId = LORA_GROUP_NONE;
     
     // Clear deduplication buffer (set to invalid sequence numbers)
     for (int j = 0; j < DEDUP_BUFFER_SIZE; j++) {
         devices[deviceCount].sequenceBuffer[j] = 0xFFFF;
     }
     
+    MARK_CHANGED(deviceCount);
     deviceCount++;
     
     Serial.printf("[Registry] Added device: %s (0x%016llX)\n", name.c_str(), deviceId);
@@ -328,6 +360,9 @@ void updateDeviceConfig(uint64_t deviceId, uint16_t sensorInterval, uint16_t dee
                           (devices[i].deepSleepSec != deepSleep);
             devices[i].sensorInterval = sensorInterval;
             devices[i].deepSleepSec = deepSleep;
+            if (changed) {
+                MARK_CHANGED(i);
+            }
             UNLOCK_REGISTRY();
             if (changed) {
                 saveRegistry();  // Persist changes
@@ -353,6 +388,7 @@ void updateDeviceSensorType(uint64_t deviceId, const char* sensorType) {
                 Serial.printf("🔧 Device sensor type: %s -> %s\n",
                              devices[i].sensorType.c_str(), sensorType);
                 devices[i].sensorType = sensorType;
+                MARK_CHANGED(i);
                 UNLOCK_REGISTRY();
                 saveRegistry();  // Persist changes
                 return;
@@ -384,6 +420,160 @@ String getDeviceSensorType(uint64_t deviceId) {
     return "Unknown";
 }
 
+/**
+ * Update device capability flags
+ * Called when sensor advertises LORA_CAP_* flags in its status payload
+ */
+void updateDeviceCapabilities(uint64_t deviceId, uint8_t capabilities) {
+    LOCK_REGISTRY();
+
+    for (int i = 0; i < deviceCount; i++) {
+        if (devices[i].deviceId == deviceId) {
+            // Only update if capabilities changed
+            if (devices[i].capabilities != capabilities) {
+                Serial.printf("🔧 Device capabilities: 0x%02X -> 0x%02X\n",
+                             devices[i].capabilities, capabilities);
+                devices[i].capabilities = capabilities;
+                MARK_CHANGED(i);
+                UNLOCK_REGISTRY();
+                saveRegistry();  // Persist changes
+                return;
+            }
+            UNLOCK_REGISTRY();
+            return;
+        }
+    }
+
+    UNLOCK_REGISTRY();
+}
+
+/**
+ * Get device capability flags
+ * Returns 0 (legacy) if device is unknown
+ */
+uint8_t getDeviceCapabilities(uint64_t deviceId) {
+    LOCK_REGISTRY();
+
+    for (int i = 0; i < deviceCount; i++) {
+        if (devices[i].deviceId == deviceId) {
+            uint8_t capabilities = devices[i].capabilities;
+            UNLOCK_REGISTRY();
+            return capabilities;
+        }
+    }
+
+    UNLOCK_REGISTRY();
+    return 0;
+}
+
+/**
+ * Update device command group
+ * Group commands addressed to groupId will include this device
+ */
+void updateDeviceGroup(uint64_t deviceId, uint8_t groupId) {
+    LOCK_REGISTRY();
+
+    for (int i = 0; i < deviceCount; i++) {
+        if (devices[i].deviceId == deviceId) {
+            // Only update if group changed
+            if (devices[i].groupId != groupId) {
+                Serial.printf("👥 Device group: %d -> %d\n", devices[i].groupId, groupId);
+                devices[i].groupId = groupId;
+                MARK_CHANGED(i);
+                UNLOCK_REGISTRY();
+                saveRegistry();  // Persist changes
+                return;
+            }
+            UNLOCK_REGISTRY();
+            return;
+        }
+    }
+
+    UNLOCK_REGISTRY();
+}
+
+/**
+ * Get device command group
+ * Returns LORA_GROUP_NONE if device is unknown
+ */
+uint8_t getDeviceGroup(uint64_t deviceId) {
+    LOCK_REGISTRY();
+
+    for (int i = 0; i < deviceCount; i++) {
+        if (devices[i].deviceId == deviceId) {
+            uint8_t groupId = devices[i].groupId;
+            UNLOCK_REGISTRY();
+            return groupId;
+        }
+    }
+
+    UNLOCK_REGISTRY();
+    return LORA_GROUP_NONE;
+}
+
+/**
+ * Get registry slot of a device
+ * Devices are never removed, so a slot identifies a device until reflash
+ */
+int getDeviceSlot(uint64_t deviceId) {
+    LOCK_REGISTRY();
+
+    for (int i = 0; i < deviceCount; i++) {
+        if (devices[i].deviceId == deviceId) {
+            UNLOCK_REGISTRY();
+            return i;
+        }
+    }
+
+    UNLOCK_REGISTRY();
+    return -1;
+}
+
+/**
+ * Build a bitmap of the registry slots belonging to a group
+ */
+int getGroupMemberMask(uint8_t groupId, uint8_t* mask) {
+    memset(mask, 0, REGISTRY_SLOT_MASK_BYTES);
+    if (groupId == LORA_GROUP_NONE) {
+        return 0;
+    }
+
+    LOCK_REGISTRY();
+
+    int members = 0;
+    for (int i = 0; i < deviceCount; i++) {
+        if (groupId == LORA_GROUP_BROADCAST || devices[i].groupId == groupId) {
+            mask[i / 8] |= (1 << (i % 8));
+            members++;
+        }
+    }
+
+    UNLOCK_REGISTRY();
+    return members;
+}
+
+/**
+ * Collect the ids of devices matching a location and/or sensor type
+ * Matching is case-insensitive; an empty or NULL filter matches any device
+ */
+int selectDevices(const char* location, const char* sensorType, uint64_t* ids, int maxCount) {
+    LOCK_REGISTRY();
+
+    int count = 0;
+    for (int i = 0; i < deviceCount && count < maxCount; i++) {
+        if (location && *location && !devices[i].location.equalsIgnoreCase(location)) {
+            continue;
+        }
+        if (sensorType && *sensorType && !devices[i].sensorType.equalsIgnoreCase(sensorType)) {
+            continue;
+        }
+        ids[count++] = devices[i].deviceId;
+    }
+
+    UNLOCK_REGISTRY();
+    return count;
+}
+
 /**
  * Get total device count
  */
@@ -421,6 +611,8 @@ bool saveRegistry() {
         deviceObj["packetCount"] = devices[i].packetCount;
         deviceObj["sensorInterval"] = devices[i].sensorInterval;
         deviceObj["deepSleepSec"] = devices[i].deepSleepSec;
+        deviceObj["capabilities"] = devices[i].capabilities;
+        deviceObj["group"] = devices[i].groupId;
     }
     
     UNLOCK_REGISTRY();
@@ -470,6 +662,7 @@ bool loadRegistry() {
     // Load devices
     JsonArray devicesArray = doc["devices"];
     deviceCount = 0;
+    registryVersion++;
     
     for (JsonObject deviceObj : devicesArray) {
         if (deviceCount >= MAX_SENSORS) {
@@ -496,12 +689,15 @@ bool loadRegistry() {
         devices[deviceCount].bufferIndex = 0;
         devices[deviceCount].sensorInterval = deviceObj["sensorInterval"] | 60;
         devices[deviceCount].deepSleepSec = deviceObj["deepSleepSec"] | 90;
+        devices[deviceCount].capabilities = deviceObj["capabilities"] | 0;
+        devices[deviceCount].groupId = deviceObj["group"] | LORA_GROUP_NONE;
         
         // Clear deduplication buffer (set to invalid sequence numbers)
         for (int j = 0; j < DEDUP_BUFFER_SIZE; j++) {
             devices[deviceCount].sequenceBuffer[j] = 0xFFFF;
         }
         
+        MARK_CHANGED(deviceCount);
         deviceCount++;
     }
     
@@ -511,48 +707,268 @@ bool loadRegistry() {
 }
 
 /**
- * Get a snapshot of all devices for web server
- * Returns JSON array - thread-safe for async web handlers
+ * Helper: Append one device as a dashboard JSON object (registry lock held)
+ * Only device state goes in (no request-time values), so the result stays
+ * valid until the registry or command queue version changes
+ */
+static void appendDeviceJson(JsonArray& devicesArray, int i, bool withQueue = true) {
+    JsonObject deviceObj = devicesArray.add<JsonObject>();
+    
+    // Convert device ID to string
+    char idStr[20];
+    snprintf(idStr, sizeof(idStr), "%016llX", devices[i].deviceId);
+    
+    deviceObj["id"] = idStr;
+    deviceObj["name"] = devices[i].deviceName;
+    deviceObj["location"] = devices[i].location;
+    deviceObj["sensorType"] = devices[i].sensorType;
+    deviceObj["lastSeen"] = devices[i].lastSeen;    // Gateway uptime (ms); age = uptime - lastSeen
+    deviceObj["lastRssi"] = devices[i].lastRssi;
+    deviceObj["lastSnr"] = devices[i].lastSnr;
+    deviceObj["packetCount"] = devices[i].packetCount;
+    deviceObj["lastSequence"] = devices[i].lastSequence;
+    deviceObj["sensorInterval"] = devices[i].sensorInterval;
+    deviceObj["deepSleepSec"] = devices[i].deepSleepSec;
+    deviceObj["capabilities"] = devices[i].capabilities;
+    deviceObj["group"] = devices[i].groupId;
+    
+    // Add command queue info (skipped when a field selection leaves it out)
+    if (withQueue) {
+        deviceObj["cmdQueueCount"] = getQueuedCommandCount(devices[i].deviceId, i);
+        deviceObj["cmdQueue"] = serialized(getQueuedCommandsJson(devices[i].deviceId, i));
+    }
+}
+
+/**
+ * Helper: Stamp devices whose queued commands changed since the last sync
+ * (registry lock held). The command queue cannot call into the registry
+ * (lock order is registry -> queue), so this runs on the read side, and
+ * only when the queue version moved
+ */
+static void syncQueueVersions() {
+    uint32_t queueVersion = getCommandQueueVersion();
+    if (queueVersion == syncedQueueVersion) {
+        return;
+    }
+    syncedQueueVersion = queueVersion;
+    
+    for (int i = 0; i < deviceCount; i++) {
+        uint32_t signature = getQueuedCommandsSignature(devices[i].deviceId, i);
+        if (signature != queueSignature[i]) {
+            queueSignature[i] = signature;
+            MARK_CHANGED(i);
+        }
+    }
+}
+
+/**
+ * Helper: True if name is in a comma-separated field list (NULL = all)
+ */
+static bool wantField(const char* fields, const char* name) {
+    if (fields == nullptr) {
+        return true;
+    }
+    size_t len = strlen(name);
+    for (const char* p = fields; *p; ) {
+        const char* end = strchr(p, ',');
+        size_t tokenLen = end ? (size_t)(end - p) : strlen(p);
+        if (tokenLen == len && strncmp(p, name, len) == 0) {
+            return true;
+        }
+        if (!end) {
+            break;
+        }
+        p = end + 1;
+    }
+    return false;
+}
+
+/**
+ * Helper: Format the ETag for a registry/command queue version pair
+ */
+static void formatRegistryETag(uint32_t version, uint32_t queueVersion, char* etag, size_t len) {
+    snprintf(etag, len, "\"%08lx-%lx-%lx\"", (unsigned long)bootId,
+             (unsigned long)version, (unsigned long)queueVersion);
+}
+
+/**
+ * Helper: Serialized object of one device (registry lock held, queue
+ * versions synced), from the cache unless the device changed since
+ */
+static std::shared_ptr<const String> getDeviceFragment(int i) {
+    if (!deviceFragments[i] || fragmentVersion[i] != deviceVersion[i]) {
+        JsonDocument doc;
+        JsonArray devicesArray = doc.to<JsonArray>();
+        appendDeviceJson(devicesArray, i);
+        
+        std::shared_ptr<String> fragment = std::make_shared<String>();
+        serializeJson(devicesArray[0], *fragment);
+        deviceFragments[i] = fragment;
+        fragmentVersion[i] = deviceVersion[i];
+    }
+    return deviceFragments[i];
+}
+
+/**
+ * Get a consistent device list for web server
+ * Taken under one registry lock hold: only the cached objects of changed
+ * devices are re-serialized, the rest is shared, so nothing here grows
+ * with the fleet beyond one pointer per slot; etag describes this list
+ */
+std::shared_ptr<const DeviceListSnapshot> getDeviceListSnapshot(char* etag, size_t etagLen) {
+    std::shared_ptr<DeviceListSnapshot> list = std::make_shared<DeviceListSnapshot>();
+    
+    LOCK_REGISTRY();
+    
+    syncQueueVersions();
+    list->count = deviceCount;
+    for (int i = 0; i < deviceCount; i++) {
+        list->devices[i] = getDeviceFragment(i);
+        list->lastSeen[i] = devices[i].lastSeen;
+    }
+    
+    // Queue version the device objects were synced to (not a newer one,
+    // which would vouch for changes they may not contain)
+    if (etag != nullptr) {
+        formatRegistryETag(registryVersion, syncedQueueVersion, etag, etagLen);
+    }
+    
+    UNLOCK_REGISTRY();
+    
+    return list;
+}
+
+/**
+ * Get one device as a JSON object (same fields as the snapshot)
+ * Lets large responses be streamed device by device
+ * fields: comma-separated names to keep ("id" is always kept), NULL = all
+ * Returns an empty string if the slot is unused
  */
-String getDeviceRegistrySnapshot() {
+String getDeviceJson(int slot, const char* fields) {
     LOCK_REGISTRY();
     
+    if (slot < 0 || slot >= deviceCount) {
+        UNLOCK_REGISTRY();
+        return String();
+    }
+    
+    if (fields == nullptr) {
+        syncQueueVersions();
+        std::shared_ptr<const String> fragment = getDeviceFragment(slot);
+        UNLOCK_REGISTRY();
+        return *fragment;
+    }
+    
     JsonDocument doc;
     JsonArray devicesArray = doc.to<JsonArray>();
+    appendDeviceJson(devicesArray, slot, wantField(fields, "cmdQueue") || wantField(fields, "cmdQueueCount"));
     
-    uint32_t currentMillis = millis();
+    UNLOCK_REGISTRY();
     
+    // Project the requested fields
+    String result;
+    JsonDocument projected;
+    for (JsonPair field : devicesArray[0].as<JsonObject>()) {
+        if (strcmp(field.key().c_str(), "id") == 0 || wantField(fields, field.key().c_str())) {
+            projected[field.key()] = field.value();
+        }
+    }
+    serializeJson(projected, result);
+    return result;
+}
+
+/**
+ * Get link statistics of the device in a registry slot
+ */
+bool getDeviceLinkStats(int slot, DeviceLinkStats* stats) {
+    LOCK_REGISTRY();
+    
+    if (slot < 0 || slot >= deviceCount) {
+        UNLOCK_REGISTRY();
+        return false;
+    }
+    
+    stats->deviceId = devices[slot].deviceId;
+    stats->deviceName = devices[slot].deviceName;
+    stats->lastRssi = devices[slot].lastRssi;
+    stats->lastSnr = devices[slot].lastSnr;
+    stats->packetCount = devices[slot].packetCount;
+    stats->lastSeen = devices[slot].lastSeen;
+    
+    UNLOCK_REGISTRY();
+    return true;
+}
+
+/**
+ * Get the registry slots of devices changed after a delta cursor
+ * A device counts as changed when its registry fields or its queued
+ * commands changed. Versions restart at boot, so a cursor is only trusted
+ * with this boot's id and a version the registry has reached; anything
+ * else is answered with every device
+ */
+bool getDevicesChangedSince(const char* cursor, uint8_t* mask, int* count,
+                            char* next, size_t nextLen) {
+    uint32_t cursorBoot = bootId;
+    uint32_t since = 0;
+    bool reset = false;
+    if (cursor != NULL && *cursor) {
+        char* end;
+        cursorBoot = strtoul(cursor, &end, 16);
+        if (*end == '-') {
+            since = strtoul(end + 1, nullptr, 10);
+        } else {
+            reset = true;
+        }
+    }
+    
+    LOCK_REGISTRY();
+    
+    syncQueueVersions();
+    
+    if (cursorBoot != bootId || since > registryVersion) {
+        since = 0;
+        reset = true;
+    }
+    
+    memset(mask, 0, REGISTRY_SLOT_MASK_BYTES);
+    *count = 0;
     for (int i = 0; i < deviceCount; i++) {
-        JsonObject deviceObj = devicesArray.add<JsonObject>();
-        
-        // Convert device ID to string
-        char idStr[20];
-        snprintf(idStr, sizeof(idStr), "%016llX", devices[i].deviceId);
-        
-        // Calculate seconds since last seen
-        uint32_t elapsedMs = currentMillis - devices[i].lastSeen;
-        uint32_t elapsedSeconds = elapsedMs / 1000;
-        
-        deviceObj["id"] = idStr;
-        deviceObj["name"] = devices[i].deviceName;
-        deviceObj["location"] = devices[i].location;
-        deviceObj["sensorType"] = devices[i].sensorType;
-        deviceObj["lastSeenSeconds"] = elapsedSeconds;  // Send elapsed seconds instead of timestamp
-        deviceObj["lastRssi"] = devices[i].lastRssi;
-        deviceObj["lastSnr"] = devices[i].lastSnr;
-        deviceObj["packetCount"] = devices[i].packetCount;
-        deviceObj["lastSequence"] = devices[i].lastSequence;
-        deviceObj["sensorInterval"] = devices[i].sensorInterval;
-        deviceObj["deepSleepSec"] = devices[i].deepSleepSec;
-        
-        // Add command queue info
-        deviceObj["cmdQueueCount"] = getQueuedCommandCount(devices[i].deviceId);
-        deviceObj["cmdQueue"] = serialized(getQueuedCommandsJson(devices[i].deviceId));
+        if (deviceVersion[i] > since) {
+            mask[i / 8] |= 1 << (i % 8);
+            (*count)++;
+        }
     }
+    snprintf(next, nextLen, "%08lx-%lu", (unsigned long)bootId, (unsigned long)registryVersion);
     
     UNLOCK_REGISTRY();
     
+    return reset;
+}
+
+/**
+ * Get the devices changed since the last call as a JSON array (same
+ * objects as the snapshot) and clear the change set
+ * Returns an empty string if nothing changed
+ */
+String takeDeviceRegistryChanges() {
     String result;
-    serializeJson(doc, result);
+    
+    LOCK_REGISTRY();
+    
+    // Queue changes mark the affected devices too
+    syncQueueVersions();
+    for (int i = 0; i < deviceCount; i++) {
+        if (changedSlots[i / 8] & (1 << (i % 8))) {
+            result += result.length() == 0 ? "[" : ",";
+            result += *getDeviceFragment(i);
+        }
+    }
+    memset(changedSlots, 0, sizeof(changedSlots));
+    
+    UNLOCK_REGISTRY();
+    
+    if (result.length() > 0) {
+        result += "]";
+    }
     return result;
 }
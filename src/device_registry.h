@@ -2,6 +2,11 @@
 #define DEVICE_REGISTRY_H
 
 #include <Arduino.h>
+#include <memory>
+#include "device_config.h"
+
+// Bytes in a bitmap with one bit per registry slot (group member masks)
+#define REGISTRY_SLOT_MASK_BYTES ((MAX_SENSORS + 7) / 8)
 
 // Device information
 struct DeviceInfo {
@@ -18,10 +23,12 @@ struct DeviceInfo {
     uint8_t bufferIndex;      // Circular buffer index
     uint16_t sensorInterval;  // Sensor reading interval (seconds)
     uint16_t deepSleepSec;    // Deep sleep duration (seconds)
+    uint8_t capabilities;     // LORA_CAP_* flags advertised by the sensor
+    uint8_t groupId;          // Command group (LORA_GROUP_NONE = no group)
 };
 
 // Thread-safe access functions
-// NOTE: For web server, use getDeviceRegistrySnapshot() to avoid holding mutex too long
+// NOTE: For web server, use getDeviceListSnapshot() to avoid holding mutex too long
 
 // Initialize device registry
 void initDeviceRegistry();
@@ -59,6 +66,29 @@ void updateDeviceSensorType(uint64_t deviceId, const char* sensorType);
 // Get device sensor type
 String getDeviceSensorType(uint64_t deviceId);
 
+// Update device capability flags (LORA_CAP_* from status payload)
+void updateDeviceCapabilities(uint64_t deviceId, uint8_t capabilities);
+
+// Get device capability flags (0 = legacy sensor or unknown device)
+uint8_t getDeviceCapabilities(uint64_t deviceId);
+
+// Update device command group (1-254, LORA_GROUP_NONE to leave)
+void updateDeviceGroup(uint64_t deviceId, uint8_t groupId);
+
+// Get device command group (LORA_GROUP_NONE if none or unknown device)
+uint8_t getDeviceGroup(uint64_t deviceId);
+
+// Get registry slot of a device (stable for the device's lifetime), -1 if unknown
+int getDeviceSlot(uint64_t deviceId);
+
+// Fill mask (REGISTRY_SLOT_MASK_BYTES) with the slots of a group's members
+// LORA_GROUP_BROADCAST selects every device; returns member count
+int getGroupMemberMask(uint8_t groupId, uint8_t* mask);
+
+// Fill ids with devices whose location and sensor type match (case-insensitive,
+// NULL or empty = any); returns the number of ids written
+int selectDevices(const char* location, const char* sensorType, uint64_t* ids, int maxCount);
+
 // Get device info by ID
 DeviceInfo* getDeviceInfo(uint64_t deviceId);
 
@@ -71,7 +101,58 @@ bool saveRegistry();
 // Load registry from SPIFFS
 bool loadRegistry();
 
-// Get thread-safe snapshot of all devices (for web server)
-String getDeviceRegistrySnapshot();
+// Strong ETag of a device snapshot: quoted boot id, registry and command
+// queue versions (fits REGISTRY_ETAG_SIZE)
+#define REGISTRY_ETAG_SIZE 32
+
+// Consistent device list for the web server: one serialized JSON object per
+// device, shared with the registry's per-device cache and never changed once
+// built, so it can be streamed device by device while the registry moves on
+struct DeviceListSnapshot {
+    int count;
+    std::shared_ptr<const String> devices[MAX_SENSORS];
+    uint32_t lastSeen[MAX_SENSORS];   // Gateway uptime (ms), for ages at send time
+};
+
+// Get the device list, taken under one registry lock hold; only devices
+// changed since their last serialization are rebuilt. If etag is given it
+// receives the ETag of this list
+std::shared_ptr<const DeviceListSnapshot> getDeviceListSnapshot(char* etag = nullptr, size_t etagLen = 0);
+
+// Get one device (registry slot) as a JSON object, "" if the slot is unused
+// Used to stream the device list without building it in memory
+// fields: comma-separated names to keep ("id" is always kept), NULL = all
+String getDeviceJson(int slot, const char* fields = nullptr);
+
+// Radio link statistics of one device (copied out for /metrics)
+struct DeviceLinkStats {
+    uint64_t deviceId;
+    String deviceName;
+    int16_t lastRssi;
+    int8_t lastSnr;
+    uint32_t packetCount;
+    uint32_t lastSeen;        // Gateway uptime (ms) of the last packet
+};
+
+// Get link statistics of the device in a registry slot (false if unused)
+bool getDeviceLinkStats(int slot, DeviceLinkStats* stats);
+
+// Delta sync cursor: "<boot id>-<registry version>", so a cursor kept
+// across a gateway reboot (versions restart) is recognised
+#define REGISTRY_CURSOR_SIZE 24
+
+// Delta sync: fill mask (REGISTRY_SLOT_MASK_BYTES) with the slots of
+// devices changed after cursor (NULL or "" = all), including changes to
+// their queued commands; count receives the number of slots and next the
+// cursor for the next query. A cursor from another boot or ahead of the
+// registry selects every device
+// Returns true if the cursor was rejected (client should replace its list)
+bool getDevicesChangedSince(const char* cursor, uint8_t* mask, int* count,
+                            char* next, size_t nextLen);
+
+// Get devices changed since the last call, including changes to their
+// queued commands (JSON array, "" if none), and clear the change set;
+// used for the dashboard push stream
+String takeDeviceRegistryChanges();
 
 #endif // DEVICE_REGISTRY_H
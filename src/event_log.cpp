@@ -0,0 +1,122 @@
+/**
+ * Event Log - LoRa Gateway
+ * Ring buffer of recent sensor events served by /api/events
+ */
+
+#include "event_log.h"
+
+// Written from the MQTT task, read from the web server task; entries are
+// small, so copies are done under a spinlock
+static portMUX_TYPE eventMux = portMUX_INITIALIZER_UNLOCKED;
+static EventLogEntry entries[EVENT_LOG_CAPACITY];
+static uint32_t lastId = 0;           // Entry id N lives in slot N % capacity
+static uint32_t bootId = 0;           // Set on first cursor use (RNG is seeded by then)
+
+/**
+ * Record an event, overwriting the oldest one when the ring is full
+ */
+void logEvent(uint64_t deviceId, uint8_t eventType, uint8_t severity,
+              const char* message, size_t messageLen, uint32_t timestamp) {
+    if (messageLen > EVENT_LOG_MESSAGE_MAX) {
+        messageLen = EVENT_LOG_MESSAGE_MAX;
+    }
+
+    portENTER_CRITICAL(&eventMux);
+    uint32_t id = ++lastId;
+    EventLogEntry* entry = &entries[id % EVENT_LOG_CAPACITY];
+    entry->id = id;
+    entry->timestamp = timestamp;
+    entry->deviceId = deviceId;
+    entry->eventType = eventType;
+    entry->severity = severity;
+    entry->messageLen = messageLen;
+    memcpy(entry->message, message, messageLen);
+    portEXIT_CRITICAL(&eventMux);
+}
+
+/**
+ * Copy matching events, oldest first (see event_log.h for the cursor rules)
+ */
+size_t readEventLog(uint32_t since, uint8_t minSeverity, EventLogEntry* out, size_t maxCount) {
+    size_t count = 0;
+
+    portENTER_CRITICAL(&eventMux);
+
+    uint32_t oldest = lastId >= EVENT_LOG_CAPACITY ? lastId - EVENT_LOG_CAPACITY + 1 : 1;
+
+    if (since > 0) {
+        // Page forward from the cursor (ids already overwritten are skipped)
+        uint32_t id = since + 1 > oldest ? since + 1 : oldest;
+        for (; id <= lastId && count < maxCount; id++) {
+            const EventLogEntry* entry = &entries[id % EVENT_LOG_CAPACITY];
+            if (entry->severity >= minSeverity) {
+                out[count++] = *entry;
+            }
+        }
+    } else {
+        // Newest first into the tail of out, then shift to oldest first
+        for (uint32_t id = lastId; id >= oldest && id > 0 && count < maxCount; id--) {
+            const EventLogEntry* entry = &entries[id % EVENT_LOG_CAPACITY];
+            if (entry->severity >= minSeverity) {
+                out[maxCount - 1 - count++] = *entry;
+            }
+        }
+        if (count > 0 && count < maxCount) {
+            memmove(out, out + maxCount - count, count * sizeof(EventLogEntry));
+        }
+    }
+
+    portEXIT_CRITICAL(&eventMux);
+
+    return count;
+}
+
+uint32_t getEventLogLastId() {
+    portENTER_CRITICAL(&eventMux);
+    uint32_t id = lastId;
+    portEXIT_CRITICAL(&eventMux);
+    return id;
+}
+
+/**
+ * Helper: Boot id for cursors, drawn on first use
+ */
+static uint32_t getEventBootId() {
+    uint32_t id = esp_random() | 1;
+    portENTER_CRITICAL(&eventMux);
+    if (bootId == 0) {
+        bootId = id;
+    }
+    id = bootId;
+    portEXIT_CRITICAL(&eventMux);
+    return id;
+}
+
+/**
+ * Resolve a client cursor to the event id to read after
+ */
+uint32_t parseEventCursor(const char* cursor, bool* reset) {
+    *reset = false;
+    if (cursor == nullptr || *cursor == '\0') {
+        return 0;
+    }
+
+    uint32_t cursorBoot = getEventBootId();
+    char* end;
+    uint32_t since = strtoul(cursor, &end, 10);
+    if (*end == '-') {
+        cursorBoot = strtoul(cursor, nullptr, 16);
+        since = strtoul(end + 1, nullptr, 10);
+    }
+
+    // Ids restart after a reboot; a stale cursor would hide new events
+    if (cursorBoot != getEventBootId() || since > getEventLogLastId()) {
+        *reset = true;
+        return 0;
+    }
+    return since;
+}
+
+void formatEventCursor(uint32_t id, char* out, size_t len) {
+    snprintf(out, len, "%08lx-%lu", (unsigned long)getEventBootId(), (unsigned long)id);
+}
@@ -0,0 +1,54 @@
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include <Arduino.h>
+
+// Recent sensor events kept in RAM for /api/events, so the dashboard can
+// show them without the external database. Fixed-size ring of compact
+// entries; when full the oldest entry is overwritten. Every entry gets an
+// increasing id; clients page with a cursor of "<boot id>-<last id>" so ids
+// that restart after a reboot are not mistaken for old ones
+#ifndef EVENT_LOG_CAPACITY
+#define EVENT_LOG_CAPACITY 64
+#endif
+// Longer messages are truncated (the radio allows up to 237 bytes)
+#ifndef EVENT_LOG_MESSAGE_MAX
+#define EVENT_LOG_MESSAGE_MAX 64
+#endif
+
+// "<boot id>-<event id>" cursor plus NUL
+#define EVENT_LOG_CURSOR_SIZE 24
+
+struct EventLogEntry {
+    uint32_t id;              // Cursor, increasing from 1 (0 = before any event)
+    uint32_t timestamp;       // Gateway uptime (ms) at reception
+    uint64_t deviceId;
+    uint8_t eventType;        // EVENT_* code
+    uint8_t severity;         // SEVERITY_*
+    uint8_t messageLen;
+    char message[EVENT_LOG_MESSAGE_MAX];  // Not NUL-terminated
+} __attribute__((packed));
+
+// Record an event (thread-safe, never blocks)
+void logEvent(uint64_t deviceId, uint8_t eventType, uint8_t severity,
+              const char* message, size_t messageLen, uint32_t timestamp);
+
+// Copy events with severity >= minSeverity into out, oldest first
+// since == 0: the newest maxCount matching events
+// since > 0:  the first maxCount matching events with id > since (page
+//             forward by passing the last id returned)
+// Returns the number of entries copied
+size_t readEventLog(uint32_t since, uint8_t minSeverity, EventLogEntry* out, size_t maxCount);
+
+// Id of the newest event (0 if none yet)
+uint32_t getEventLogLastId();
+
+// Event id to read after for a client cursor ("<boot id>-<id>", or a bare id)
+// A cursor from an earlier boot, or ahead of the newest event, is stale:
+// *reset is set and 0 is returned, so the client gets the current tail
+uint32_t parseEventCursor(const char* cursor, bool* reset);
+
+// Format the cursor a client passes back after reading up to id
+void formatEventCursor(uint32_t id, char* out, size_t len);
+
+#endif // EVENT_LOG_H
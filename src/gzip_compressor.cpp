@@ -0,0 +1,236 @@
+/**
+ * Gzip Compressor - LoRa Gateway
+ * Fixed-Huffman deflate for compressing request bodies before upload
+ */
+
+#include "gzip_compressor.h"
+
+#define GZIP_MIN_MATCH 3
+#define GZIP_MAX_MATCH 258
+#define GZIP_WINDOW 32768
+#define GZIP_HEADER_SIZE 10
+#define GZIP_TRAILER_SIZE 8
+
+// Deflate length codes 257..285: base length and extra bits
+static const uint16_t LENGTH_BASE[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uint8_t LENGTH_EXTRA[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+// Deflate distance codes 0..29: base distance and extra bits
+static const uint16_t DIST_BASE[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+static const uint8_t DIST_EXTRA[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+/**
+ * Helper: CRC-32 (IEEE, as in gzip/zlib), 4 bits at a time
+ */
+static uint32_t crc32(const uint8_t* data, size_t len) {
+    static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+        0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+        0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+    };
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+/**
+ * Helper: Reverse the low count bits (Huffman codes are sent MSB first)
+ */
+static uint32_t reverseBits(uint32_t value, uint8_t count) {
+    uint32_t result = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        result = (result << 1) | (value & 1);
+        value >>= 1;
+    }
+    return result;
+}
+
+static uint16_t hashPrefix(const uint8_t* p) {
+    uint32_t prefix = ((uint32_t)p[0] << 16) | ((uint32_t)p[1] << 8) | p[2];
+    return (uint32_t)(prefix * 2654435761u) >> (32 - GZIP_HASH_BITS);
+}
+
+GzipCompressor::GzipCompressor()
+    : head(NULL)
+    , out(NULL)
+    , capacity(0)
+    , limit(0)
+    , outLen(0)
+    , bitBuffer(0)
+    , bitCount(0)
+    , overflow(false) {
+}
+
+GzipCompressor::~GzipCompressor() {
+    free(head);
+    free(out);
+}
+
+bool GzipCompressor::begin(size_t maxOutput) {
+    if (out != NULL) {
+        return true;
+    }
+    head = (uint16_t*)malloc(sizeof(uint16_t) << GZIP_HASH_BITS);
+    out = (uint8_t*)malloc(maxOutput);
+    if (head == NULL || out == NULL) {
+        free(head);
+        free(out);
+        head = NULL;
+        out = NULL;
+        return false;
+    }
+    capacity = maxOutput;
+    return true;
+}
+
+void GzipCompressor::putByte(uint8_t value) {
+    if (outLen >= limit) {
+        overflow = true;
+        return;
+    }
+    out[outLen++] = value;
+}
+
+/**
+ * Append count bits (LSB first, as deflate packs them)
+ */
+void GzipCompressor::putBits(uint32_t value, uint8_t count) {
+    bitBuffer |= value << bitCount;
+    bitCount += count;
+    while (bitCount >= 8) {
+        putByte(bitBuffer & 0xFF);
+        bitBuffer >>= 8;
+        bitCount -= 8;
+    }
+}
+
+void GzipCompressor::flushBits() {
+    if (bitCount > 0) {
+        putByte(bitBuffer & 0xFF);
+    }
+    bitBuffer = 0;
+    bitCount = 0;
+}
+
+/**
+ * Emit a literal/length symbol with the fixed Huffman code (RFC 1951 3.2.6)
+ */
+void GzipCompressor::putSymbol(uint16_t symbol) {
+    if (symbol < 144) {
+        putBits(reverseBits(0x30 + symbol, 8), 8);
+    } else if (symbol < 256) {
+        putBits(reverseBits(0x190 + symbol - 144, 9), 9);
+    } else if (symbol < 280) {
+        putBits(reverseBits(symbol - 256, 7), 7);
+    } else {
+        putBits(reverseBits(0xC0 + symbol - 280, 8), 8);
+    }
+}
+
+void GzipCompressor::putMatch(uint16_t length, uint16_t distance) {
+    uint8_t code = 28;
+    while (LENGTH_BASE[code] > length) {
+        code--;
+    }
+    putSymbol(257 + code);
+    putBits(length - LENGTH_BASE[code], LENGTH_EXTRA[code]);
+
+    code = 29;
+    while (DIST_BASE[code] > distance) {
+        code--;
+    }
+    putBits(reverseBits(code, 5), 5);
+    putBits(distance - DIST_BASE[code], DIST_EXTRA[code]);
+}
+
+/**
+ * Compress one body into a complete gzip member
+ */
+size_t GzipCompressor::compress(const uint8_t* data, size_t len) {
+    if (out == NULL || len == 0 || len > GZIP_MAX_INPUT) {
+        return 0;
+    }
+
+    // Only worth sending if strictly smaller than the original
+    limit = len - 1 < capacity ? len - 1 : capacity;
+    outLen = 0;
+    bitBuffer = 0;
+    bitCount = 0;
+    overflow = false;
+    memset(head, 0, sizeof(uint16_t) << GZIP_HASH_BITS);
+
+    // Header: magic, deflate, no flags, no mtime, no extra flags, OS unknown
+    static const uint8_t header[GZIP_HEADER_SIZE] = {
+        0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF
+    };
+    for (size_t i = 0; i < GZIP_HEADER_SIZE; i++) {
+        putByte(header[i]);
+    }
+
+    // One final block with fixed Huffman codes (BFINAL = 1, BTYPE = 01)
+    putBits(1, 1);
+    putBits(1, 2);
+
+    size_t pos = 0;
+    while (pos < len && !overflow) {
+        uint16_t matchLength = 0;
+        size_t matchPos = 0;
+
+        if (pos + GZIP_MIN_MATCH <= len) {
+            uint16_t hash = hashPrefix(data + pos);
+            if (head[hash] != 0) {
+                matchPos = head[hash] - 1;
+                size_t maxLength = len - pos < GZIP_MAX_MATCH ? len - pos : GZIP_MAX_MATCH;
+                if (pos - matchPos <= GZIP_WINDOW) {
+                    while (matchLength < maxLength && data[matchPos + matchLength] == data[pos + matchLength]) {
+                        matchLength++;
+                    }
+                }
+            }
+            head[hash] = pos + 1;
+        }
+
+        if (matchLength >= GZIP_MIN_MATCH) {
+            putMatch(matchLength, pos - matchPos);
+            // Index the prefixes inside the match so later repeats find them
+            for (size_t i = pos + 1; i < pos + matchLength && i + GZIP_MIN_MATCH <= len; i++) {
+                head[hashPrefix(data + i)] = i + 1;
+            }
+            pos += matchLength;
+        } else {
+            putSymbol(data[pos]);
+            pos++;
+        }
+    }
+
+    putSymbol(256);  // End of block
+    flushBits();
+
+    // Trailer: CRC-32 and input size, little-endian
+    uint32_t crc = crc32(data, len);
+    for (int i = 0; i < 4; i++) {
+        putByte(crc >> (8 * i));
+    }
+    for (int i = 0; i < 4; i++) {
+        putByte(len >> (8 * i));
+    }
+
+    return overflow ? 0 : outLen;
+}
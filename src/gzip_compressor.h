@@ -0,0 +1,49 @@
+#ifndef GZIP_COMPRESSOR_H
+#define GZIP_COMPRESSOR_H
+
+#include <Arduino.h>
+
+// Small gzip (RFC 1952) encoder for outgoing request bodies
+// Single-block deflate with the fixed Huffman code and greedy LZ77 over a
+// hash of 3-byte prefixes (most recent match only). Batched JSON is mostly
+// repeated keys and separators, which this catches; no dynamic trees keeps
+// the code and context small. The context (hash table and output buffer) is
+// allocated once by begin() and reused for every body
+
+#define GZIP_HASH_BITS 12                 // 4096-entry hash table (8 KB)
+#define GZIP_MAX_INPUT 65535              // Hash table stores 16-bit positions
+
+class GzipCompressor {
+public:
+    GzipCompressor();
+    ~GzipCompressor();
+
+    // Allocate the context; bodies whose gzip form exceeds maxOutput bytes
+    // are left uncompressed. Returns false if out of memory
+    bool begin(size_t maxOutput);
+    bool ready() const { return out != NULL; }
+
+    // Compress data into the output buffer
+    // Returns the gzip size, or 0 if it would not be smaller than the input
+    // (or not fit the buffer), in which case the body should be sent as is
+    size_t compress(const uint8_t* data, size_t len);
+    uint8_t* output() { return out; }
+
+private:
+    uint16_t* head;               // Position + 1 of the last 3-byte prefix per hash
+    uint8_t* out;
+    size_t capacity;
+    size_t limit;                 // Output budget of the current body
+    size_t outLen;
+    uint32_t bitBuffer;
+    uint8_t bitCount;
+    bool overflow;
+
+    void putByte(uint8_t value);
+    void putBits(uint32_t value, uint8_t count);
+    void putSymbol(uint16_t symbol);
+    void putMatch(uint16_t length, uint16_t distance);
+    void flushBits();
+};
+
+#endif // GZIP_COMPRESSOR_H
@@ -4,6 +4,8 @@
 #include "packet_queue.h"
 #include "device_registry.h"
 #include "display_manager.h"
+#include "metrics.h"
+#include "command_sender.h"
 #include <RadioLib.h>
 #include <SPI.h>
 #include <esp_task_wdt.h>
@@ -14,6 +16,17 @@ static SX1262* radio = nullptr;
 // Radio mutex for thread-safe access
 static SemaphoreHandle_t radioMutex = nullptr;
 
+// DIO1 interrupt routing: RX done wakes the RX task, TX done wakes the transmitter
+static TaskHandle_t rxTaskHandle = nullptr;
+static SemaphoreHandle_t txDoneSemaphore = nullptr;
+static volatile bool txInProgress = false;
+
+// Margin added to computed time-on-air when waiting for TX done
+#define TX_DONE_MARGIN_MS 100
+
+// RX task wakes at least this often without an interrupt (watchdog, stats)
+#define RX_IDLE_WAKE_MS 1000
+
 // Packet queue for communication between LoRa RX and MQTT tasks
 static QueueHandle_t rxPacketQueue = nullptr;
 
@@ -30,6 +43,19 @@ static uint32_t duplicatesFiltered = 0;
 #define VEXT_CTRL 36  // Vext control pin for Heltec boards
 #endif
 
+/**
+ * DIO1 interrupt handler (RxDone / TxDone)
+ */
+static void IRAM_ATTR onDio1Interrupt() {
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    if (txInProgress) {
+        xSemaphoreGiveFromISR(txDoneSemaphore, &higherPriorityTaskWoken);
+    } else if (rxTaskHandle != nullptr) {
+        vTaskNotifyGiveFromISR(rxTaskHandle, &higherPriorityTaskWoken);
+    }
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
 /**
  * Initialize LoRa receiver
  */
@@ -98,13 +124,6 @@ bool initLoRaReceiver() {
     Serial.printf("  Sync Word: 0x%02X\n", LORA_SYNC_WORD);
     Serial.println("===================================\n");
     
-    // Configure IRQ on DIO1
-    // The SX126x requires we set up DIO1 to notify us of RxDone.
-    // In RadioLib setDio1Action() usually attaches an interrupt to a pin.
-    // Since we are moving to a polling model in the task, we may not want the ISR.
-    // However, if we don't set it, RadioLib might not configure the radio to fire the signal on the pin.
-    // But startReceive() configures the radio to listen.
-    
     // Create radio mutex
     radioMutex = xSemaphoreCreateMutex();
     if (radioMutex == NULL) {
@@ -112,6 +131,16 @@ bool initLoRaReceiver() {
         return false;
     }
     
+    // Create TX done signal
+    txDoneSemaphore = xSemaphoreCreateBinary();
+    if (txDoneSemaphore == NULL) {
+        Serial.println("❌ Failed to create TX done semaphore!");
+        return false;
+    }
+    
+    // Configure IRQ on DIO1 (RxDone and TxDone both raise DIO1)
+    radio->setDio1Action(onDio1Interrupt);
+    
     // Create packet queue
     rxPacketQueue = xQueueCreate(20, sizeof(ReceivedPacket));
     if (rxPacketQueue == NULL) {
@@ -129,7 +158,7 @@ bool initLoRaReceiver() {
     Serial.println("✅");
     
     Serial.println("✅ LoRa receiver ready!\n");
-    Serial.println("Gateway will poll for packets using IRQ flag checks in loraRxTask()\n");
+    Serial.println("Gateway waits for DIO1 interrupts in loraRxTask()\n");
     return true;
 }
 
@@ -143,28 +172,26 @@ void loraRxTask(void* parameter) {
     // Subscribe this task to the watchdog
     esp_task_wdt_add(NULL);
     
+    // Route DIO1 RxDone notifications to this task
+    rxTaskHandle = xTaskGetCurrentTaskHandle();
+    
     uint8_t rxBuffer[sizeof(LoRaPacketHeader) + LORA_MAX_PAYLOAD_SIZE];
     
     while (true) {
         // Feed watchdog at start of loop
         esp_task_wdt_reset();
         
-        // Poll for packet availability
-        // In "startReceive" mode (interrupt-based logic but without ISR callback),
-        // we can poll the IRQ pin manually or ask the radio object.
+        // Sleep until the DIO1 interrupt signals RxDone (or idle timeout)
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(RX_IDLE_WAKE_MS));
         
-        // Method 1: Check hardware pin if available (fastest, no SPI)
+        // Confirm with the pin level (also catches an edge missed while
+        // another task held the radio)
         bool irqTriggered = (digitalRead(LORA_DIO1) == HIGH);
         
-        // Method 2: Ask RadioLib (uses SPI, slower)
-        // int16_t state = radio->readData(rxBuffer, sizeof(rxBuffer));
-        // But readData() is blocking or designed for packet mode?
-        // Actually, startReceive() puts radio in RX.
-        // We must detect when it's done.
-        
         if (irqTriggered) {
-             // Acquire mutex before accessing radio
-             if (xSemaphoreTake(radioMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+             // Acquire mutex before accessing radio; a TX holds it for at
+             // most one frame's time-on-air, and giving it back wakes us
+             if (xSemaphoreTake(radioMutex, pdMS_TO_TICKS(RX_IDLE_WAKE_MS)) == pdTRUE) {
                  // Interrupt detected! A packet might be ready.
                  // readData() reads the packet and clears the IRQ flags.
                  memset(rxBuffer, 0, sizeof(rxBuffer));
@@ -173,6 +200,7 @@ void loraRxTask(void* parameter) {
              if (state == RADIOLIB_ERR_NONE) {
                 // Packet received successfully
                 packetsReceived++;
+                metricsInc(METRIC_RX_PACKETS);
                 
                 // Get actual packet length
                 size_t packetLen = radio->getPacketLength();
@@ -189,6 +217,7 @@ void loraRxTask(void* parameter) {
             if (packetLen < sizeof(LoRaPacketHeader)) {
                 Serial.printf("⚠️  Packet too short (%zu bytes)\n", packetLen);
                 packetsDropped++;
+                metricsInc(METRIC_RX_DROP_SHORT);
                 radio->startReceive();
                 xSemaphoreGive(radioMutex);
                 continue;
@@ -218,6 +247,7 @@ void loraRxTask(void* parameter) {
                              header->magic[0], header->magic[1], header->version,
                              header->checksum, calculateHeaderChecksum(header));
                 packetsDropped++;
+                metricsInc(METRIC_RX_DROP_HEADER);
                 displayUpdateLoRaStats(packetsReceived, packetsDropped, duplicatesFiltered);
                 radio->startReceive();
                 xSemaphoreGive(radioMutex);
@@ -228,6 +258,7 @@ void loraRxTask(void* parameter) {
             if (isDuplicate(header->deviceId, header->sequenceNum)) {
                 Serial.printf("⚠️  Duplicate packet (Seq: %d)\n", header->sequenceNum);
                 duplicatesFiltered++;
+                metricsInc(METRIC_RX_DUPLICATES);
                 displayUpdateLoRaStats(packetsReceived, packetsDropped, duplicatesFiltered);
                 radio->startReceive();
                 xSemaphoreGive(radioMutex);
@@ -269,8 +300,11 @@ void loraRxTask(void* parameter) {
             if (xQueueSend(rxPacketQueue, &packet, pdMS_TO_TICKS(100)) != pdTRUE) {
                 Serial.println("⚠️  Queue full, packet dropped!");
                 packetsDropped++;
+                metricsInc(METRIC_RX_DROP_QUEUE_FULL);
             } else {
                 Serial.println("✅ Packet queued for MQTT");
+                metricsObserve(METRIC_STAGE_RX, millis() - timestamp);
+                metricsHighWater(METRIC_RX_QUEUE_HWM, uxQueueMessagesWaiting(rxPacketQueue));
             }
             
             // Send ACK if this is a readings/status/event message
@@ -289,6 +323,7 @@ void loraRxTask(void* parameter) {
              } 
              else if (state == RADIOLIB_ERR_CRC_MISMATCH) {
                  Serial.println("Rx CRC error");
+                 metricsInc(METRIC_RX_DROP_CRC);
                  radio->startReceive();
                  xSemaphoreGive(radioMutex);
              }
@@ -298,13 +333,11 @@ void loraRxTask(void* parameter) {
                  xSemaphoreGive(radioMutex);
              }
              } else {
-                 // Couldn't acquire mutex, skip this cycle
-                 vTaskDelay(pdMS_TO_TICKS(5));
+                 // Radio still busy after a full idle period: feed the
+                 // watchdog and re-check DIO1 right away (the take above
+                 // blocks, so this never spins)
+                 xTaskNotifyGive(rxTaskHandle);
              }
-        } else {
-            // Yield to avoid starving other tasks / triggering watchdog
-            // For high responsiveness, we can reduce this, but 10ms is usually fine.
-            vTaskDelay(pdMS_TO_TICKS(10));
         }
 
         
@@ -318,6 +351,53 @@ void loraRxTask(void* parameter) {
     }
 }
 
+/**
+ * Time-on-air of a frame at the configured SF/BW/CR (ms, rounded up)
+ * Pure calculation; no radio access, so no mutex needed
+ */
+uint32_t getTimeOnAirMs(size_t len) {
+    if (radio == nullptr) {
+        return 0;
+    }
+    return (radio->getTimeOnAir(len) + 999) / 1000;
+}
+
+/**
+ * Transmit a frame and return the radio to continuous RX
+ * Caller must hold the radio mutex
+ */
+bool transmitFrame(uint8_t* data, size_t len) {
+    if (radio == nullptr) {
+        return false;
+    }
+    
+    // Leave continuous RX before loading the TX buffer
+    int state = radio->standby();
+    if (state != RADIOLIB_ERR_NONE) {
+        radio->startReceive();
+        return false;
+    }
+    
+    // Bound the wait by the frame's time-on-air rather than a fixed guess
+    uint32_t timeoutMs = radio->getTimeOnAir(len) / 1000 + TX_DONE_MARGIN_MS;
+    
+    // Start non-blocking TX; RadioLib waits on BUSY between SPI commands
+    xSemaphoreTake(txDoneSemaphore, 0);  // Drop any stale TX done signal
+    txInProgress = true;
+    state = radio->startTransmit(data, len);
+    if (state == RADIOLIB_ERR_NONE &&
+        xSemaphoreTake(txDoneSemaphore, pdMS_TO_TICKS(timeoutMs)) != pdTRUE) {
+        state = RADIOLIB_ERR_TX_TIMEOUT;
+    }
+    txInProgress = false;
+    
+    // Clear TX IRQ flags and go straight back to RX
+    radio->finishTransmit();
+    radio->startReceive();
+    
+    return state == RADIOLIB_ERR_NONE;
+}
+
 /**
  * Send ACK to sensor
  */
@@ -344,16 +424,16 @@ bool sendAck(uint64_t deviceId, uint16_t seqNum, bool success, int8_t rssi, int8
     memcpy(txBuffer, &header, sizeof(LoRaPacketHeader));
     memcpy(txBuffer + sizeof(LoRaPacketHeader), &ack, sizeof(AckPayload));
     
-    // Transmit ACK (caller must handle RX restart and holds mutex)
+    // Transmit ACK (caller holds mutex; radio is back in RX on return)
+    // ACKs are not deferred, but their airtime counts against the budget
+    chargeDownlinkAirtime(getTimeOnAirMs(sizeof(txBuffer)));
     Serial.printf("[LoRa TX] Sending ACK for seq %d... ", seqNum);
 
-    int state = radio->transmit(txBuffer, sizeof(txBuffer));
-
-    if (state == RADIOLIB_ERR_NONE) {
+    if (transmitFrame(txBuffer, sizeof(txBuffer))) {
         Serial.println("✅");
         return true;
     } else {
-        Serial.printf("❌ (code: %d)\n", state);
+        Serial.println("❌");
         return false;
     }
 }
@@ -378,17 +458,11 @@ bool sendCommand(uint64_t deviceId, const CommandPayload* cmd) {
     
     Serial.printf("[LoRa TX] Sending command 0x%02X to device 0x%016llX... ", cmd->cmdType, deviceId);
     
-    int state = radio->transmit(txBuffer, sizeof(LoRaPacketHeader) + payloadLen);
-    
-    if (state == RADIOLIB_ERR_NONE) {
+    if (transmitFrame(txBuffer, sizeof(LoRaPacketHeader) + payloadLen)) {
         Serial.println("✅");
-        // Restart receiving
-        radio->startReceive();
         return true;
     } else {
-        Serial.printf("❌ (code: %d)\n", state);
-        // Restart receiving even on failure
-        radio->startReceive();
+        Serial.println("❌");
         return false;
     }
 }
@@ -22,6 +22,13 @@ bool initLoRaReceiver();
 // LoRa RX task (runs on Core 0)
 void loraRxTask(void* parameter);
 
+// Transmit a frame (non-blocking TX, DIO1 TxDone) and return to RX
+// Caller must hold the radio mutex
+bool transmitFrame(uint8_t* data, size_t len);
+
+// Time-on-air (ms, rounded up) of a frame of len bytes at current modem settings
+uint32_t getTimeOnAirMs(size_t len);
+
 // Send ACK to sensor
 bool sendAck(uint64_t deviceId, uint16_t seqNum, bool success, int8_t rssi, int8_t snr);
 
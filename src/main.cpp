@@ -15,6 +15,7 @@
 #include "command_tester.h"
 #include "web_server.h"
 #include "database_manager.h"
+#include "metrics.h"
 
 // Watchdog timeout (seconds)
 #define WDT_TIMEOUT 30
@@ -22,6 +23,7 @@
 // FreeRTOS task handles
 TaskHandle_t loraRxTaskHandle = NULL;
 TaskHandle_t mqttTaskHandle = NULL;
+TaskHandle_t dbTaskHandle = NULL;
 
 void setup() {
     Serial.begin(115200);
@@ -133,6 +135,23 @@ void setup() {
         1                     // Core 1
     );
 
+    // Core 1: Database persistence (lowest priority, blocking HTTP)
+    xTaskCreatePinnedToCore(
+        dbTask,               // Task function
+        "DB",                 // Task name
+        DB_TASK_STACK_SIZE,   // Stack size
+        NULL,                 // Parameters
+        DB_TASK_PRIORITY,     // Priority
+        &dbTaskHandle,        // Task handle
+        1                     // Core 1
+    );
+
+    // Stack high-water marks for /metrics
+    metricsRegisterTask("lora_rx", loraRxTaskHandle);
+    metricsRegisterTask("mqtt", mqttTaskHandle);
+    metricsRegisterTask("db", dbTaskHandle);
+    metricsRegisterTask("loop", xTaskGetCurrentTaskHandle());
+
     Serial.println("Gateway startup complete!");
     Serial.println("====================================\n");
 
@@ -151,9 +170,6 @@ void loop() {
     // Handle OTA updates
     ArduinoOTA.handle();
 
-    // Handle database operations
-    dbManager.loop();
-
     // Check WiFi connection
     static uint32_t lastWiFiCheck = 0;
     if (millis() - lastWiFiCheck > 30000) {  // Check every 30 seconds
@@ -174,6 +190,9 @@ void loop() {
     }
 #endif
 
+    // Push dashboard updates to connected browsers
+    webServerLoop();
+
     // Yield to other tasks
     vTaskDelay(pdMS_TO_TICKS(10));
 }
@@ -0,0 +1,163 @@
+/**
+ * Metrics - LoRa Gateway
+ * Lock-free counters and latency histograms for the /metrics endpoint
+ */
+
+#include "metrics.h"
+#include <atomic>
+
+struct HistogramData {
+    std::atomic<uint32_t> buckets[METRIC_BUCKET_COUNT + 1];  // Last one is +Inf
+    std::atomic<uint32_t> count;
+    std::atomic<uint32_t> sumMs;
+};
+
+struct TaskEntry {
+    const char* name;
+    TaskHandle_t handle;
+};
+
+static const uint32_t bucketBounds[METRIC_BUCKET_COUNT] = METRIC_BUCKETS;
+
+static std::atomic<uint32_t> counters[METRIC_COUNTER_COUNT];
+static std::atomic<uint32_t> highWater[METRIC_HIGH_WATER_COUNT];
+static HistogramData histograms[METRIC_HISTOGRAM_COUNT];
+
+// Written during setup() only, before the web server serves /metrics
+static TaskEntry tasks[METRIC_MAX_TASKS];
+static int taskCount = 0;
+
+// Exposition names: counters sharing a name are one family told apart by
+// their label (e.g. drop reasons)
+struct MetricInfo {
+    const char* name;
+    const char* label;            // NULL = no label
+    const char* help;
+};
+
+static const MetricInfo counterInfo[METRIC_COUNTER_COUNT] = {
+    { "lora_rx_packets_total", NULL, "LoRa frames read from the radio" },
+    { "lora_rx_dropped_total", "reason=\"short\"", "LoRa frames dropped, by reason" },
+    { "lora_rx_dropped_total", "reason=\"header\"", NULL },
+    { "lora_rx_dropped_total", "reason=\"crc\"", NULL },
+    { "lora_rx_dropped_total", "reason=\"queue_full\"", NULL },
+    { "lora_rx_duplicates_total", NULL, "LoRa frames filtered as duplicates" },
+    { "mqtt_publish_total", "result=\"ok\"", "MQTT publish calls, by result" },
+    { "mqtt_publish_total", "result=\"fail\"", NULL },
+    { "db_batches_total", "result=\"ok\"", "Database write batches, by result" },
+    { "db_batches_total", "result=\"fail\"", NULL },
+    { "http_rejected_total", "reason=\"rate\"", "API requests refused by admission control, by reason" },
+    { "http_rejected_total", "reason=\"busy\"", NULL },
+};
+
+static const MetricInfo highWaterInfo[METRIC_HIGH_WATER_COUNT] = {
+    { "lora_rx_queue_high_water", NULL, "Most packets waiting in the RX to MQTT queue" },
+    { "db_queue_high_water", NULL, "Most writes waiting in the database ring" },
+};
+
+static const MetricInfo histogramInfo[METRIC_HISTOGRAM_COUNT] = {
+    { "gateway_stage_latency_ms", "stage=\"rx\"", "Per-stage latency in milliseconds" },
+    { "gateway_stage_latency_ms", "stage=\"queue_wait\"", NULL },
+    { "gateway_stage_latency_ms", "stage=\"mqtt_publish\"", NULL },
+    { "gateway_stage_latency_ms", "stage=\"db_batch\"", NULL },
+};
+
+void metricsInc(MetricCounter counter, uint32_t n) {
+    counters[counter].fetch_add(n, std::memory_order_relaxed);
+}
+
+void metricsHighWater(MetricHighWater gauge, uint32_t value) {
+    uint32_t current = highWater[gauge].load(std::memory_order_relaxed);
+    while (value > current &&
+           !highWater[gauge].compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+void metricsObserve(MetricHistogram histogram, uint32_t ms) {
+    HistogramData* h = &histograms[histogram];
+    int bucket = 0;
+    while (bucket < METRIC_BUCKET_COUNT && ms > bucketBounds[bucket]) {
+        bucket++;
+    }
+    h->buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    h->count.fetch_add(1, std::memory_order_relaxed);
+    h->sumMs.fetch_add(ms, std::memory_order_relaxed);
+}
+
+void metricsRegisterTask(const char* name, TaskHandle_t task) {
+    if (taskCount < METRIC_MAX_TASKS && task != NULL) {
+        tasks[taskCount].name = name;
+        tasks[taskCount].handle = task;
+        taskCount++;
+    }
+}
+
+void writeMetricHeader(Print& out, const char* name, const char* type, const char* help) {
+    out.printf("# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+}
+
+/**
+ * Helper: One sample line, with an optional label
+ */
+static void writeSample(Print& out, const char* name, const char* suffix,
+                        const char* label, uint32_t value) {
+    if (label != NULL) {
+        out.printf("%s%s{%s} %lu\n", name, suffix, label, (unsigned long)value);
+    } else {
+        out.printf("%s%s %lu\n", name, suffix, (unsigned long)value);
+    }
+}
+
+/**
+ * Write the registry in Prometheus text format
+ * The family header is written by the first entry carrying help text
+ */
+void writeMetrics(Print& out) {
+    for (int i = 0; i < METRIC_COUNTER_COUNT; i++) {
+        const MetricInfo& info = counterInfo[i];
+        if (info.help != NULL) {
+            writeMetricHeader(out, info.name, "counter", info.help);
+        }
+        writeSample(out, info.name, "", info.label, counters[i].load(std::memory_order_relaxed));
+    }
+
+    for (int i = 0; i < METRIC_HIGH_WATER_COUNT; i++) {
+        const MetricInfo& info = highWaterInfo[i];
+        if (info.help != NULL) {
+            writeMetricHeader(out, info.name, "gauge", info.help);
+        }
+        writeSample(out, info.name, "", info.label, highWater[i].load(std::memory_order_relaxed));
+    }
+
+    for (int i = 0; i < METRIC_HISTOGRAM_COUNT; i++) {
+        const MetricInfo& info = histogramInfo[i];
+        HistogramData* h = &histograms[i];
+        if (info.help != NULL) {
+            writeMetricHeader(out, info.name, "histogram", info.help);
+        }
+
+        // Buckets are cumulative in the exposition format
+        uint32_t cumulative = 0;
+        for (int b = 0; b <= METRIC_BUCKET_COUNT; b++) {
+            cumulative += h->buckets[b].load(std::memory_order_relaxed);
+            if (b < METRIC_BUCKET_COUNT) {
+                out.printf("%s_bucket{%s,le=\"%lu\"} %lu\n", info.name, info.label,
+                           (unsigned long)bucketBounds[b], (unsigned long)cumulative);
+            } else {
+                out.printf("%s_bucket{%s,le=\"+Inf\"} %lu\n", info.name, info.label,
+                           (unsigned long)cumulative);
+            }
+        }
+        writeSample(out, info.name, "_sum", info.label, h->sumMs.load(std::memory_order_relaxed));
+        writeSample(out, info.name, "_count", info.label, h->count.load(std::memory_order_relaxed));
+    }
+
+    if (taskCount > 0) {
+        writeMetricHeader(out, "task_stack_free_min_bytes", "gauge",
+                          "Lowest free stack seen per task");
+        for (int i = 0; i < taskCount; i++) {
+            out.printf("task_stack_free_min_bytes{task=\"%s\"} %lu\n", tasks[i].name,
+                       (unsigned long)uxTaskGetStackHighWaterMark(tasks[i].handle));
+        }
+    }
+}
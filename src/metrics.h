@@ -0,0 +1,66 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <Arduino.h>
+
+// Gateway metrics for the Prometheus endpoint (/metrics)
+// Counters, high-water marks and histograms are fixed arrays of atomics,
+// updated with relaxed atomic adds: no locks, so recording from the radio
+// and MQTT tasks costs a few instructions and a scrape never blocks them.
+// A scrape reads each value independently (a histogram may be one
+// observation ahead in one bucket vs. its count; Prometheus tolerates that)
+
+enum MetricCounter {
+    METRIC_RX_PACKETS,            // Frames read from the radio
+    METRIC_RX_DROP_SHORT,         // Dropped: shorter than a header
+    METRIC_RX_DROP_HEADER,        // Dropped: bad magic/version/checksum
+    METRIC_RX_DROP_CRC,           // Dropped: radio CRC error
+    METRIC_RX_DROP_QUEUE_FULL,    // Dropped: RX -> MQTT queue full
+    METRIC_RX_DUPLICATES,         // Filtered as duplicates
+    METRIC_MQTT_PUBLISH_OK,
+    METRIC_MQTT_PUBLISH_FAIL,
+    METRIC_DB_BATCH_OK,           // Database batches accepted
+    METRIC_DB_BATCH_FAIL,         // Database batches failed or rejected
+    METRIC_HTTP_REJECT_RATE,      // API requests over a client's rate (429)
+    METRIC_HTTP_REJECT_BUSY,      // API requests over the concurrency cap (503)
+    METRIC_COUNTER_COUNT
+};
+
+enum MetricHighWater {
+    METRIC_RX_QUEUE_HWM,          // Most packets waiting in the RX -> MQTT queue
+    METRIC_DB_QUEUE_HWM,          // Most writes waiting in the database ring
+    METRIC_HIGH_WATER_COUNT
+};
+
+// Latency histograms (milliseconds)
+enum MetricHistogram {
+    METRIC_STAGE_RX,              // Radio read to queued for MQTT
+    METRIC_STAGE_QUEUE_WAIT,      // Radio read to dequeued by the MQTT task
+    METRIC_STAGE_MQTT_PUBLISH,    // One MQTT publish call
+    METRIC_STAGE_DB_BATCH,        // One database batch round trip
+    METRIC_HISTOGRAM_COUNT
+};
+
+// Histogram bucket upper bounds (ms); a final +Inf bucket is implicit
+#define METRIC_BUCKETS { 1, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000 }
+#define METRIC_BUCKET_COUNT 12
+
+// Tasks whose stack high-water mark is reported
+#define METRIC_MAX_TASKS 6
+
+// Record (safe from any task)
+void metricsInc(MetricCounter counter, uint32_t n = 1);
+void metricsHighWater(MetricHighWater gauge, uint32_t value);
+void metricsObserve(MetricHistogram histogram, uint32_t ms);
+
+// Report a task's minimum free stack (call once after creating it)
+void metricsRegisterTask(const char* name, TaskHandle_t task);
+
+// Write the registry (counters, high-water marks, histograms, task stacks)
+// in Prometheus text format
+void writeMetrics(Print& out);
+
+// Write the # HELP / # TYPE lines for one metric family
+void writeMetricHeader(Print& out, const char* name, const char* type, const char* help);
+
+#endif // METRICS_H
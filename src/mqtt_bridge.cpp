@@ -4,6 +4,10 @@
 #include "device_config.h"
 #include "secrets.h"
 #include "command_sender.h"
+#include "database_manager.h"
+#include "event_log.h"
+#include "metrics.h"
+#include "reading_history.h"
 #include <PubSubClient.h>
 #include <WiFi.h>
 #include <ArduinoJson.h>
@@ -37,6 +41,17 @@ static String formatDeviceId(uint64_t deviceId) {
     return String(buffer);
 }
 
+/**
+ * Publish to MQTT, counting the outcome and call time for /metrics
+ */
+static bool publishMqtt(const char* topic, const char* payload, bool retained = false) {
+    uint32_t start = millis();
+    bool ok = mqttClient.publish(topic, payload, retained);
+    metricsObserve(METRIC_STAGE_MQTT_PUBLISH, millis() - start);
+    metricsInc(ok ? METRIC_MQTT_PUBLISH_OK : METRIC_MQTT_PUBLISH_FAIL);
+    return ok;
+}
+
 /**
  * Initialize MQTT bridge
  */
@@ -104,19 +119,36 @@ void mqttTask(void* parameter) {
         // Check for packets from LoRa RX task
         if (xQueueReceive(packetQueue, &packet, pdMS_TO_TICKS(100)) == pdTRUE) {
             uint32_t packetReceivedMs = millis();
+            metricsObserve(METRIC_STAGE_QUEUE_WAIT, packetReceivedMs - packet.timestamp);
             Serial.printf("\n[MQTT] Processing packet from device 0x%016llX (received at +%lums)\n", 
                          packet.header.deviceId, packetReceivedMs);
             
+            // Packet history row (copied into a RAM ring, flushed in bulk by dbTask)
+            dbManager.writePacket(packet.header.deviceId, packet.header.msgType,
+                                  packet.header.sequenceNum, packet.rssi, packet.snr,
+                                  packet.timestamp);
+            
+            // Command ACKs answer our downlink; no new RX window to serve
+            if (packet.header.msgType == MSG_COMMAND_ACK) {
+                publishCommandAck(&packet);
+                continue;
+            }
+            
             // Wait for sensor to be ready to receive commands
             // Sensor needs ~2 seconds after TX: display operations + RX setup
-            Serial.println("⏱️  Waiting 3 seconds for sensor to enter RX mode...");
-            vTaskDelay(pdMS_TO_TICKS(3000));
+            // Time spent in the RX queue already counts towards the delay
+            uint32_t sinceUplink = packetReceivedMs - packet.timestamp;
+            if (sinceUplink < SENSOR_RX_DELAY_MS) {
+                Serial.printf("⏱️  Waiting %lums for sensor to enter RX mode...\n",
+                              SENSOR_RX_DELAY_MS - sinceUplink);
+                vTaskDelay(pdMS_TO_TICKS(SENSOR_RX_DELAY_MS - sinceUplink));
+            }
             
             // Retry any queued commands for this sensor (it's now in RX window)
             uint32_t cmdSendMs = millis();
             Serial.printf("⏱️  Sending commands at +%lums (%lums after packet received)\n", 
                          cmdSendMs, cmdSendMs - packetReceivedMs);
-            retryCommandsForSensor(packet.header.deviceId);
+            retryCommandsForSensor(packet.header.deviceId, packet.timestamp);
             
             // Route packet based on message type
             switch (packet.header.msgType) {
@@ -187,6 +219,9 @@ void publishReadings(const ReceivedPacket* packet) {
 
     // Update device registry with sensor type
     updateDeviceSensorType(packet->header.deviceId, sensorType);
+    
+    // Keep it for /api/history charts, independent of MQTT
+    recordReading(packet->header.deviceId, readings, packet->rssi, packet->timestamp);
 
     // Get device name and ID
     String deviceName = getDeviceName(packet->header.deviceId);
@@ -243,7 +278,7 @@ void publishReadings(const ReceivedPacket* packet) {
     // Publish to MQTT
     String topic = String(MQTT_TOPIC_PREFIX) + deviceId + "/readings";
 
-    if (mqttClient.publish(topic.c_str(), jsonString.c_str(), false)) {
+    if (publishMqtt(topic.c_str(), jsonString.c_str(), false)) {
         Serial.printf("✅ Published to %s (%s)\n", topic.c_str(), sensorType);
         Serial.println(jsonString);
 
@@ -270,7 +305,9 @@ void publishReadings(const ReceivedPacket* packet) {
  * Publish device status to MQTT
  */
 void publishStatus(const ReceivedPacket* packet) {
-    if (packet->header.payloadLen != sizeof(StatusPayload)) {
+    // Newer sensors append a capabilities byte after StatusPayload
+    if (packet->header.payloadLen != sizeof(StatusPayload) &&
+        packet->header.payloadLen != sizeof(StatusPayload) + 1) {
         Serial.println("⚠️  Invalid status payload size");
         return;
     }
@@ -278,6 +315,13 @@ void publishStatus(const ReceivedPacket* packet) {
     // Parse payload
     StatusPayload* status = (StatusPayload*)packet->payload;
     
+    // Record what the sensor understands (TLV params, batched commands)
+    uint8_t capabilities = 0;
+    if (packet->header.payloadLen > sizeof(StatusPayload)) {
+        capabilities = packet->payload[sizeof(StatusPayload)];
+    }
+    updateDeviceCapabilities(packet->header.deviceId, capabilities);
+    
     // Extract device name from payload and update registry if present
     if (status->deviceName[0] != '\0') {
         String sensorName = String(status->deviceName);
@@ -331,7 +375,7 @@ void publishStatus(const ReceivedPacket* packet) {
     // Publish
     String topic = String(MQTT_TOPIC_PREFIX) + deviceId + "/status";
     
-    if (mqttClient.publish(topic.c_str(), jsonString.c_str(), false)) {
+    if (publishMqtt(topic.c_str(), jsonString.c_str(), false)) {
         Serial.printf("✅ Published status to %s\n", topic.c_str());
     } else {
         Serial.printf("❌ Failed to publish status\n");
@@ -366,6 +410,10 @@ void publishEvent(const ReceivedPacket* packet) {
     memcpy(message, event->message, messageLen);
     message[messageLen] = '\0';
     
+    // Keep it for the dashboard (/api/events), independent of MQTT
+    logEvent(packet->header.deviceId, event->eventType, event->severity,
+             message, messageLen, packet->timestamp);
+    
     // Build JSON
     JsonDocument doc;
     doc["device_id"] = deviceId;
@@ -394,13 +442,56 @@ void publishEvent(const ReceivedPacket* packet) {
     // Publish
     String topic = String(MQTT_TOPIC_PREFIX) + deviceId + "/events";
     
-    if (mqttClient.publish(topic.c_str(), jsonString.c_str(), false)) {
+    if (publishMqtt(topic.c_str(), jsonString.c_str(), false)) {
         Serial.printf("✅ Published event: %s\n", message);
     } else {
         Serial.printf("❌ Failed to publish event\n");
     }
 }
 
+/**
+ * Publish per-command results from a sensor's MSG_COMMAND_ACK
+ */
+void publishCommandAck(const ReceivedPacket* packet) {
+    const size_t fixedLen = sizeof(CommandAckPayload) - sizeof(((CommandAckPayload*)0)->results);
+    if (packet->header.payloadLen < fixedLen) {
+        Serial.println("⚠️  Invalid command ACK payload size");
+        return;
+    }
+    
+    // Parse payload (clamp result count to what was actually received)
+    const CommandAckPayload* ack = (const CommandAckPayload*)packet->payload;
+    uint8_t resultCount = min((size_t)ack->resultCount,
+                              (packet->header.payloadLen - fixedLen) / sizeof(CommandResult));
+    resultCount = min(resultCount, (uint8_t)MAX_BATCH_COMMANDS);
+    
+    handleCommandAck(packet->header.deviceId, ack, resultCount);
+    
+    String deviceId = formatDeviceId(packet->header.deviceId);
+    
+    // Build JSON
+    JsonDocument doc;
+    doc["device_id"] = deviceId;
+    doc["sequence"] = ack->ackSequenceNum;
+    JsonArray results = doc["results"].to<JsonArray>();
+    for (uint8_t i = 0; i < resultCount; i++) {
+        JsonObject result = results.add<JsonObject>();
+        result["action"] = getCommandName(ack->results[i].cmdType);
+        result["status"] = (ack->results[i].status == CMD_RESULT_OK) ? "confirmed" : "failed";
+        result["error_code"] = ack->results[i].status;
+    }
+    
+    // Serialize
+    String jsonString;
+    serializeJson(doc, jsonString);
+    
+    if (publishMqtt("lora/command/ack", jsonString.c_str())) {
+        Serial.printf("✅ Published command ACK (%d results)\n", resultCount);
+    } else {
+        Serial.printf("❌ Failed to publish command ACK\n");
+    }
+}
+
 /**
  * MQTT callback for incoming commands
  * Expected JSON format:
@@ -423,64 +514,79 @@ void mqttCallback(char* topic, byte* payload, unsigned int length) {
     }
     
     // Extract command details
-    const char* targetDeviceStr = doc["device_id"];
     const char* action = doc["action"];
+    JsonVariant group = doc["group"];
+    
+    if ((!doc["device_id"].is<const char*>() && group.isNull()) || action == nullptr) {
+        Serial.println("❌ Missing device_id/group or action in command");
+        return;
+    }
     
-    if (targetDeviceStr == nullptr || action == nullptr) {
-        Serial.println("❌ Missing device_id or action in command");
+    // Group is read wide, so 256 or -1 cannot wrap to "no group" or broadcast
+    if (!group.isNull() && (!group.is<long>() || !isLoraGroupTarget(group.as<long>()))) {
+        Serial.println("❌ group must be 1-254, or 255 for every sensor");
         return;
     }
     
-    // Parse device ID (hex string to uint64_t)
-    uint64_t targetDevice = strtoull(targetDeviceStr, nullptr, 16);
+    // Target: one device (hex string to uint64_t), or every member of a group
+    uint64_t targetDevice = !group.isNull() ? loraGroupAddress(group.as<long>())
+                          : strtoull(doc["device_id"].as<const char*>(), nullptr, 16);
+    char targetDeviceStr[20];
+    snprintf(targetDeviceStr, sizeof(targetDeviceStr), "%016llX", targetDevice);
     
     Serial.printf("[MQTT CMD] Action: %s for device: 0x%016llX\n", action, targetDevice);
     
+    // Optional scheduling hints: priority class and delivery deadline
+    uint8_t priority = parseCommandPriority(doc["priority"].as<const char*>());
+    uint32_t deadlineMs = parseCommandDeadline(doc["deadline_sec"].as<uint32_t>());
+    
     bool success = false;
     
     // Route to appropriate command sender
     if (strcmp(action, "set_interval") == 0) {
         uint32_t seconds = doc["value"] | 30;  // Default 30 seconds
         Serial.printf("  Setting sensor interval to %lu seconds\n", seconds);
-        
-        // Pack seconds as ASCII decimal string
-        char paramStr[16];
-        snprintf(paramStr, sizeof(paramStr), "%lu", seconds);
-        success = queueCommand(targetDevice, 0x07, (uint8_t*)paramStr, strlen(paramStr));  // CMD_SET_INTERVAL
+        success = queueCommandValue(targetDevice, CMD_SET_INTERVAL, seconds, priority, deadlineMs);
         
     } else if (strcmp(action, "set_sleep") == 0) {
         uint32_t seconds = doc["value"] | 900;  // Default 15 minutes
         Serial.printf("  Setting deep sleep to %lu seconds\n", seconds);
-        
-        // Pack seconds as ASCII decimal string
-        char paramStr[16];
-        snprintf(paramStr, sizeof(paramStr), "%lu", seconds);
-        success = queueCommand(targetDevice, 0x06, (uint8_t*)paramStr, strlen(paramStr));  // CMD_SET_SLEEP
+        success = queueCommandValue(targetDevice, CMD_SET_SLEEP, seconds, priority, deadlineMs);
         
     } else if (strcmp(action, "restart") == 0) {
         Serial.println("  Sending restart command");
-        success = queueCommand(targetDevice, 0x04, nullptr, 0);  // CMD_RESTART
+        success = queueCommand(targetDevice, 0x04, nullptr, 0, priority, deadlineMs);  // CMD_RESTART
         
     } else if (strcmp(action, "status") == 0) {
         Serial.println("  Requesting status update");
-        success = queueCommand(targetDevice, 0x05, nullptr, 0);  // CMD_STATUS
+        success = queueCommand(targetDevice, 0x05, nullptr, 0, priority, deadlineMs);  // CMD_STATUS
 
     } else if (strcmp(action, "calibrate") == 0) {
         Serial.println("  Calibrating pressure baseline (current reading)");
-        success = queueCommand(targetDevice, 0x01, nullptr, 0);  // CMD_CALIBRATE
+        success = queueCommand(targetDevice, 0x01, nullptr, 0, priority, deadlineMs);  // CMD_CALIBRATE
 
     } else if (strcmp(action, "set_baseline") == 0) {
         float baselineHpa = doc["value"] | 1013.25;  // Default sea level pressure
         Serial.printf("  Setting pressure baseline to %.2f hPa\n", baselineHpa);
         
-        // Pack baseline as ASCII decimal string
-        char paramStr[16];
-        snprintf(paramStr, sizeof(paramStr), "%.2f", baselineHpa);
-        success = queueCommand(targetDevice, 0x02, (uint8_t*)paramStr, strlen(paramStr));  // CMD_SET_BASELINE
+        // Baseline travels as integer Pa (hPa * 100)
+        success = queueCommandValue(targetDevice, CMD_SET_BASELINE,
+                                    (uint32_t)lroundf(baselineHpa * 100.0f), priority, deadlineMs);
+
+    } else if (strcmp(action, "set_group") == 0) {
+        JsonVariant value = doc["value"];
+        if (isLoraGroupAddress(targetDevice) || !value.is<long>() ||
+            !isLoraGroupAssignment(value.as<long>())) {
+            Serial.println("❌ set_group needs a device_id and a group of 0-254");
+            return;
+        }
+        uint8_t newGroup = value.as<long>();
+        Serial.printf("  Assigning sensor to group %d\n", newGroup);
+        success = queueCommandValue(targetDevice, CMD_SET_GROUP, newGroup, priority, deadlineMs);
 
     } else if (strcmp(action, "clear_baseline") == 0) {
         Serial.println("  Clearing pressure baseline");
-        success = queueCommand(targetDevice, 0x03, nullptr, 0);  // CMD_CLEAR_BASELINE
+        success = queueCommand(targetDevice, 0x03, nullptr, 0, priority, deadlineMs);  // CMD_CLEAR_BASELINE
 
     } else {
         Serial.printf("❌ Unknown action: %s\n", action);
@@ -497,7 +603,7 @@ void mqttCallback(char* topic, byte* payload, unsigned int length) {
         snprintf(ackPayload, sizeof(ackPayload), 
                  "{\"device_id\":\"%s\",\"action\":\"%s\",\"status\":\"queued\"}", 
                  targetDeviceStr, action);
-        mqttClient.publish(ackTopic, ackPayload);
+        publishMqtt(ackTopic, ackPayload);
     } else {
         Serial.println("❌ Command queueing failed");
     }
@@ -528,7 +634,7 @@ bool reconnectMqtt() {
         
         String jsonString;
         serializeJson(doc, jsonString);
-        mqttClient.publish(MQTT_STATUS_TOPIC, jsonString.c_str(), true);  // Retained
+        publishMqtt(MQTT_STATUS_TOPIC, jsonString.c_str(), true);  // Retained
         
         return true;
     }
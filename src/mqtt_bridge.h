@@ -20,6 +20,9 @@ void publishStatus(const ReceivedPacket* packet);
 // Publish event to MQTT
 void publishEvent(const ReceivedPacket* packet);
 
+// Publish per-command results from a sensor's command ACK
+void publishCommandAck(const ReceivedPacket* packet);
+
 // MQTT callback for incoming commands
 void mqttCallback(char* topic, byte* payload, unsigned int length);
 
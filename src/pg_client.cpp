@@ -0,0 +1,602 @@
+/**
+ * PostgreSQL Client - LoRa Gateway
+ * Just enough of the PostgreSQL wire protocol for the database manager to
+ * write straight to PostgreSQL without the REST service in between
+ */
+
+#include "pg_client.h"
+#include <mbedtls/md.h>
+#include <mbedtls/base64.h>
+
+#define PG_PROTOCOL_VERSION 196608   // 3.0
+
+#define PG_AUTH_OK 0
+#define PG_AUTH_CLEARTEXT 3
+#define PG_AUTH_MD5 5
+#define PG_AUTH_SASL 10
+#define PG_AUTH_SASL_CONTINUE 11
+#define PG_AUTH_SASL_FINAL 12
+
+#define SCRAM_KEY_SIZE 32
+
+/**
+ * Helper: Read a big-endian 32-bit value
+ */
+static int32_t getInt32(const uint8_t* p) {
+    return (int32_t)(((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+                     ((uint32_t)p[2] << 8) | (uint32_t)p[3]);
+}
+
+static void hmacSha256(const uint8_t* key, size_t keyLen, const uint8_t* data, size_t len,
+                       uint8_t out[SCRAM_KEY_SIZE]) {
+    mbedtls_md_hmac(mbedtls_md_info_from_type(MBEDTLS_MD_SHA256), key, keyLen, data, len, out);
+}
+
+static void sha256(const uint8_t* data, size_t len, uint8_t out[SCRAM_KEY_SIZE]) {
+    mbedtls_md(mbedtls_md_info_from_type(MBEDTLS_MD_SHA256), data, len, out);
+}
+
+/**
+ * Helper: MD5 of data as 32 lowercase hex characters (+ NUL)
+ */
+static void md5Hex(const uint8_t* data, size_t len, char out[33]) {
+    uint8_t digest[16];
+    mbedtls_md(mbedtls_md_info_from_type(MBEDTLS_MD_MD5), data, len, digest);
+    for (int i = 0; i < 16; i++) {
+        snprintf(out + i * 2, 3, "%02x", digest[i]);
+    }
+}
+
+/**
+ * Helper: PBKDF2-HMAC-SHA256 with a single output block (SCRAM SaltedPassword)
+ */
+static void pbkdf2Sha256(const char* password, const uint8_t* salt, size_t saltLen,
+                         uint32_t iterations, uint8_t out[SCRAM_KEY_SIZE]) {
+    std::vector<uint8_t> block(salt, salt + saltLen);
+    const uint8_t index[4] = { 0, 0, 0, 1 };
+    block.insert(block.end(), index, index + 4);
+
+    uint8_t u[SCRAM_KEY_SIZE];
+    size_t passwordLen = strlen(password);
+    hmacSha256((const uint8_t*)password, passwordLen, block.data(), block.size(), u);
+    memcpy(out, u, SCRAM_KEY_SIZE);
+
+    for (uint32_t i = 1; i < iterations; i++) {
+        hmacSha256((const uint8_t*)password, passwordLen, u, SCRAM_KEY_SIZE, u);
+        for (int j = 0; j < SCRAM_KEY_SIZE; j++) {
+            out[j] ^= u[j];
+        }
+    }
+}
+
+static String base64Encode(const uint8_t* data, size_t len) {
+    size_t outLen = 0;
+    std::vector<uint8_t> buf(((len + 2) / 3) * 4 + 1);
+    mbedtls_base64_encode(buf.data(), buf.size(), &outLen, data, len);
+    return String((const char*)buf.data()).substring(0, outLen);
+}
+
+static std::vector<uint8_t> base64Decode(const String& text) {
+    size_t outLen = 0;
+    std::vector<uint8_t> buf(text.length());
+    if (mbedtls_base64_decode(buf.data(), buf.size(), &outLen,
+                              (const uint8_t*)text.c_str(), text.length()) != 0) {
+        outLen = 0;
+    }
+    buf.resize(outLen);
+    return buf;
+}
+
+/**
+ * Helper: Value of attribute "<key>=" in a SCRAM message ("" if absent)
+ */
+static String scramAttribute(const String& message, char key) {
+    int start = 0;
+    while (start < (int)message.length()) {
+        int end = message.indexOf(',', start);
+        if (end < 0) {
+            end = message.length();
+        }
+        if (end - start >= 2 && message[start] == key && message[start + 1] == '=') {
+            return message.substring(start + 2, end);
+        }
+        start = end + 1;
+    }
+    return "";
+}
+
+PgClient::PgClient()
+    : timeoutMs(5000)
+    , ready(false)
+    , lengthPos(0)
+    , rxLen(0) {
+}
+
+/**
+ * Message building: type byte (none for the startup message), then an
+ * Int32 length that endMessage() fills in, then the fields
+ */
+void PgClient::beginMessage(char type) {
+    if (type) {
+        tx.push_back((uint8_t)type);
+    }
+    lengthPos = tx.size();
+    putInt32(0);
+}
+
+void PgClient::endMessage() {
+    uint32_t len = tx.size() - lengthPos;
+    tx[lengthPos] = len >> 24;
+    tx[lengthPos + 1] = len >> 16;
+    tx[lengthPos + 2] = len >> 8;
+    tx[lengthPos + 3] = len;
+}
+
+void PgClient::putInt32(int32_t value) {
+    tx.push_back((uint32_t)value >> 24);
+    tx.push_back((uint32_t)value >> 16);
+    tx.push_back((uint32_t)value >> 8);
+    tx.push_back((uint32_t)value);
+}
+
+void PgClient::putInt16(int16_t value) {
+    tx.push_back((uint16_t)value >> 8);
+    tx.push_back((uint16_t)value);
+}
+
+void PgClient::putString(const char* str) {
+    putBytes((const uint8_t*)str, strlen(str) + 1);
+}
+
+void PgClient::putBytes(const uint8_t* data, size_t len) {
+    tx.insert(tx.end(), data, data + len);
+}
+
+/**
+ * Send all buffered messages in one write
+ */
+bool PgClient::flush() {
+    size_t sent = 0;
+    while (sent < tx.size()) {
+        size_t n = client.write(tx.data() + sent, tx.size() - sent);
+        if (n == 0) {
+            break;
+        }
+        sent += n;
+    }
+    bool ok = sent == tx.size();
+    tx.clear();
+    return ok;
+}
+
+/**
+ * Read exactly len bytes, failing after timeoutMs without progress
+ */
+bool PgClient::readExact(uint8_t* buf, size_t len) {
+    size_t got = 0;
+    uint32_t lastProgress = millis();
+
+    while (got < len) {
+        int n = client.read(buf + got, len - got);
+        if (n > 0) {
+            got += n;
+            lastProgress = millis();
+        } else if (!client.connected() || millis() - lastProgress > timeoutMs) {
+            return false;
+        } else {
+            delay(1);
+        }
+    }
+    return true;
+}
+
+/**
+ * Read one backend message; the first PG_RX_BUFFER_SIZE payload bytes are
+ * kept in rx (rxLen), the rest is discarded
+ */
+bool PgClient::readMessage(char* type) {
+    uint8_t header[5];
+    if (!readExact(header, sizeof(header))) {
+        return false;
+    }
+
+    *type = (char)header[0];
+    int32_t len = getInt32(header + 1) - 4;
+    if (len < 0) {
+        return false;
+    }
+
+    rxLen = min((size_t)len, (size_t)PG_RX_BUFFER_SIZE);
+    if (!readExact(rx, rxLen)) {
+        return false;
+    }
+    rx[rxLen] = 0;
+
+    uint8_t discard[64];
+    for (size_t left = len - rxLen; left > 0; ) {
+        size_t n = min(left, sizeof(discard));
+        if (!readExact(discard, n)) {
+            return false;
+        }
+        left -= n;
+    }
+    return true;
+}
+
+/**
+ * Store SQLSTATE and message of an ErrorResponse in lastError
+ */
+void PgClient::parseError() {
+    String code;
+    String message;
+    size_t pos = 0;
+
+    while (pos < rxLen && rx[pos] != 0) {
+        char field = rx[pos++];
+        const char* value = (const char*)rx + pos;
+        if (field == 'C') {
+            code = value;
+        } else if (field == 'M') {
+            message = value;
+        }
+        pos += strlen(value) + 1;
+    }
+
+    lastError = code + " " + message;
+}
+
+/**
+ * Consume replies up to ReadyForQuery
+ */
+PgResult PgClient::waitReady() {
+    PgResult result = PG_OK;
+    char type;
+
+    while (readMessage(&type)) {
+        if (type == 'Z') {
+            return result;
+        }
+        if (type == 'E') {
+            parseError();
+            result = PG_SQL_ERROR;
+        }
+        // ParseComplete, BindComplete, CommandComplete, rows, notices: nothing to do
+    }
+    // Keep the server's reason if it closed the session after an error
+    return ioError(result == PG_SQL_ERROR ? NULL : "connection lost");
+}
+
+/**
+ * Close after an I/O failure; what (if set) replaces lastError
+ */
+PgResult PgClient::ioError(const char* what) {
+    if (what) {
+        lastError = what;
+    }
+    close();
+    return PG_IO_ERROR;
+}
+
+/**
+ * Connect and authenticate
+ */
+bool PgClient::connect(const char* host, uint16_t port, const char* user,
+                       const char* password, const char* database, uint32_t timeout) {
+    close();
+    timeoutMs = timeout;
+
+    if (!client.connect(host, port, timeoutMs)) {
+        lastError = "connect failed";
+        return false;
+    }
+    client.setNoDelay(true);
+
+    // StartupMessage: protocol version and name/value pairs
+    beginMessage(0);
+    putInt32(PG_PROTOCOL_VERSION);
+    putString("user");
+    putString(user);
+    putString("database");
+    putString(database);
+    putString("application_name");
+    putString("lora-gateway");
+    tx.push_back(0);
+    endMessage();
+
+    if (!flush()) {
+        ioError("startup failed");
+        return false;
+    }
+    if (!authenticate(user, password)) {
+        close();
+        return false;
+    }
+
+    // ParameterStatus and BackendKeyData follow until the first ReadyForQuery
+    if (waitReady() != PG_OK) {
+        close();
+        return false;
+    }
+
+    ready = true;
+    return true;
+}
+
+/**
+ * Answer authentication requests until AuthenticationOk
+ */
+bool PgClient::authenticate(const char* user, const char* password) {
+    String clientNonce;
+    String clientFirstBare;
+    String serverSignature;
+    char type;
+
+    while (readMessage(&type)) {
+        if (type == 'E') {
+            parseError();
+            return false;
+        }
+        if (type != 'R' || rxLen < 4) {
+            continue;
+        }
+
+        switch (getInt32(rx)) {
+            case PG_AUTH_OK:
+                return true;
+
+            case PG_AUTH_CLEARTEXT:
+                beginMessage('p');
+                putString(password);
+                endMessage();
+                break;
+
+            case PG_AUTH_MD5: {
+                // "md5" + md5hex(md5hex(password + user) + salt)
+                String inner = String(password) + user;
+                char hex[33];
+                md5Hex((const uint8_t*)inner.c_str(), inner.length(), hex);
+                uint8_t salted[36];
+                memcpy(salted, hex, 32);
+                memcpy(salted + 32, rx + 4, 4);
+                char outer[33];
+                md5Hex(salted, sizeof(salted), outer);
+
+                beginMessage('p');
+                putBytes((const uint8_t*)"md5", 3);
+                putString(outer);
+                endMessage();
+                break;
+            }
+
+            case PG_AUTH_SASL: {
+                // Mechanism list: NUL-terminated names
+                bool scram = false;
+                for (size_t pos = 4; pos < rxLen && rx[pos] != 0; ) {
+                    const char* name = (const char*)rx + pos;
+                    scram |= strcmp(name, "SCRAM-SHA-256") == 0;
+                    pos += strlen(name) + 1;
+                }
+                if (!scram) {
+                    lastError = "no supported SASL mechanism";
+                    return false;
+                }
+
+                uint8_t nonce[18];
+                for (size_t i = 0; i < sizeof(nonce); i++) {
+                    nonce[i] = esp_random();
+                }
+                clientNonce = base64Encode(nonce, sizeof(nonce));
+                // User name is taken from the startup message, so it is left empty
+                clientFirstBare = "n=,r=" + clientNonce;
+                String clientFirst = "n,," + clientFirstBare;
+
+                beginMessage('p');
+                putString("SCRAM-SHA-256");
+                putInt32(clientFirst.length());
+                putBytes((const uint8_t*)clientFirst.c_str(), clientFirst.length());
+                endMessage();
+                break;
+            }
+
+            case PG_AUTH_SASL_CONTINUE: {
+                String serverFirst = (const char*)rx + 4;
+                String nonce = scramAttribute(serverFirst, 'r');
+                std::vector<uint8_t> salt = base64Decode(scramAttribute(serverFirst, 's'));
+                uint32_t iterations = scramAttribute(serverFirst, 'i').toInt();
+                if (!nonce.startsWith(clientNonce) || salt.empty() || iterations == 0) {
+                    lastError = "invalid SCRAM server-first message";
+                    return false;
+                }
+
+                uint8_t saltedPassword[SCRAM_KEY_SIZE];
+                uint8_t clientKey[SCRAM_KEY_SIZE];
+                uint8_t storedKey[SCRAM_KEY_SIZE];
+                uint8_t serverKey[SCRAM_KEY_SIZE];
+                uint8_t signature[SCRAM_KEY_SIZE];
+                pbkdf2Sha256(password, salt.data(), salt.size(), iterations, saltedPassword);
+                hmacSha256(saltedPassword, SCRAM_KEY_SIZE, (const uint8_t*)"Client Key", 10, clientKey);
+                sha256(clientKey, SCRAM_KEY_SIZE, storedKey);
+
+                String clientFinal = "c=biws,r=" + nonce;
+                String authMessage = clientFirstBare + "," + serverFirst + "," + clientFinal;
+                hmacSha256(storedKey, SCRAM_KEY_SIZE, (const uint8_t*)authMessage.c_str(),
+                           authMessage.length(), signature);
+                uint8_t proof[SCRAM_KEY_SIZE];
+                for (int i = 0; i < SCRAM_KEY_SIZE; i++) {
+                    proof[i] = clientKey[i] ^ signature[i];
+                }
+
+                // Expected server signature, checked in SASLFinal
+                hmacSha256(saltedPassword, SCRAM_KEY_SIZE, (const uint8_t*)"Server Key", 10, serverKey);
+                hmacSha256(serverKey, SCRAM_KEY_SIZE, (const uint8_t*)authMessage.c_str(),
+                           authMessage.length(), signature);
+                serverSignature = base64Encode(signature, SCRAM_KEY_SIZE);
+
+                clientFinal += ",p=" + base64Encode(proof, SCRAM_KEY_SIZE);
+                beginMessage('p');
+                putBytes((const uint8_t*)clientFinal.c_str(), clientFinal.length());
+                endMessage();
+                break;
+            }
+
+            case PG_AUTH_SASL_FINAL: {
+                String serverFinal = (const char*)rx + 4;
+                if (serverSignature.length() == 0 ||
+                    scramAttribute(serverFinal, 'v') != serverSignature) {
+                    lastError = "SCRAM server signature mismatch";
+                    return false;
+                }
+                continue;  // AuthenticationOk follows
+            }
+
+            default:
+                lastError = "unsupported authentication method " + String(getInt32(rx));
+                return false;
+        }
+
+        if (!flush()) {
+            lastError = "authentication write failed";
+            return false;
+        }
+    }
+
+    if (lastError.length() == 0) {
+        lastError = "connection closed during authentication";
+    }
+    return false;
+}
+
+void PgClient::close() {
+    if (client.connected()) {
+        // Terminate lets the server end the session cleanly
+        tx.clear();
+        beginMessage('X');
+        endMessage();
+        flush();
+    }
+    client.stop();
+    tx.clear();
+    ready = false;
+}
+
+bool PgClient::connected() {
+    return ready && client.connected();
+}
+
+PgResult PgClient::ping() {
+    if (!connected()) {
+        return ioError("not connected");
+    }
+    beginMessage('S');
+    endMessage();
+    return flush() ? waitReady() : ioError("write failed");
+}
+
+PgResult PgClient::prepare(const char* name, const char* sql) {
+    if (!connected()) {
+        return ioError("not connected");
+    }
+
+    beginMessage('P');
+    putString(name);
+    putString(sql);
+    putInt16(0);              // Parameter types inferred by the server
+    endMessage();
+    beginMessage('S');
+    endMessage();
+
+    return flush() ? waitReady() : ioError("write failed");
+}
+
+PgResult PgClient::execute(const char* name, const char* const* params, int paramCount) {
+    if (!connected()) {
+        return ioError("not connected");
+    }
+
+    // Bind: unnamed portal, all parameters and results in text format
+    beginMessage('B');
+    putString("");
+    putString(name);
+    putInt16(0);
+    putInt16(paramCount);
+    for (int i = 0; i < paramCount; i++) {
+        if (params[i] == NULL) {
+            putInt32(-1);
+        } else {
+            size_t len = strlen(params[i]);
+            putInt32(len);
+            putBytes((const uint8_t*)params[i], len);
+        }
+    }
+    putInt16(0);
+    endMessage();
+
+    beginMessage('E');
+    putString("");
+    putInt32(0);              // No row limit
+    endMessage();
+    beginMessage('S');
+    endMessage();
+
+    return flush() ? waitReady() : ioError("write failed");
+}
+
+PgResult PgClient::copyIn(const char* sql, const String& rows) {
+    if (!connected()) {
+        return ioError("not connected");
+    }
+
+    beginMessage('Q');
+    putString(sql);
+    endMessage();
+    if (!flush()) {
+        return ioError("write failed");
+    }
+
+    // CopyInResponse, or an error (bad table/columns) followed by ReadyForQuery
+    char type = 0;
+    while (type != 'G') {
+        if (!readMessage(&type)) {
+            return ioError("connection lost");
+        }
+        if (type == 'E') {
+            parseError();
+            return waitReady() == PG_IO_ERROR ? PG_IO_ERROR : PG_SQL_ERROR;
+        }
+    }
+
+    beginMessage('d');
+    putBytes((const uint8_t*)rows.c_str(), rows.length());
+    endMessage();
+    beginMessage('c');
+    endMessage();
+
+    return flush() ? waitReady() : ioError("write failed");
+}
+
+PgResult PgClient::query(const char* sql) {
+    if (!connected()) {
+        return ioError("not connected");
+    }
+
+    beginMessage('Q');
+    putString(sql);
+    endMessage();
+
+    return flush() ? waitReady() : ioError("write failed");
+}
+
+/**
+ * Append a value to a COPY text-format row
+ */
+void pgCopyEscape(String& row, const char* value) {
+    for (const char* p = value; *p; p++) {
+        switch (*p) {
+            case '\\': row += "\\\\"; break;
+            case '\t': row += "\\t"; break;
+            case '\n': row += "\\n"; break;
+            case '\r': row += "\\r"; break;
+            default:   row += *p; break;
+        }
+    }
+}
@@ -0,0 +1,81 @@
+#ifndef PG_CLIENT_H
+#define PG_CLIENT_H
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+#include <vector>
+
+// Minimal PostgreSQL client speaking the v3 frontend/backend protocol
+// Supports trust, cleartext, MD5 and SCRAM-SHA-256 authentication, prepared
+// statements (extended query protocol, text parameters) and
+// COPY ... FROM STDIN in text format. Plain TCP only (sslmode=disable)
+
+// Receive buffer; longer backend messages (large rows) are read and discarded
+#define PG_RX_BUFFER_SIZE 512
+
+enum PgResult {
+    PG_OK,
+    PG_SQL_ERROR,             // Server rejected the statement (connection still usable)
+    PG_IO_ERROR               // Connection lost or timed out (connection closed)
+};
+
+class PgClient {
+public:
+    PgClient();
+
+    // Connect and authenticate; timeoutMs also applies to every later reply
+    bool connect(const char* host, uint16_t port, const char* user,
+                 const char* password, const char* database, uint32_t timeoutMs);
+    void close();
+    bool connected();
+
+    // Sync round trip (health probe)
+    PgResult ping();
+
+    // Parse a named statement with $1..$n text parameters
+    PgResult prepare(const char* name, const char* sql);
+
+    // Bind and execute a prepared statement (NULL entries are SQL NULL)
+    PgResult execute(const char* name, const char* const* params, int paramCount);
+
+    // Run a COPY ... FROM STDIN statement and stream text-format rows
+    PgResult copyIn(const char* sql, const String& rows);
+
+    // Simple query, results discarded
+    PgResult query(const char* sql);
+
+    // SQLSTATE and message of the last error response (or I/O failure)
+    const String& getLastError() const { return lastError; }
+
+private:
+    WiFiClient client;
+    String lastError;
+    uint32_t timeoutMs;
+    bool ready;                           // Authenticated and idle
+
+    std::vector<uint8_t> tx;              // Outgoing messages, sent by flush()
+    size_t lengthPos;
+    uint8_t rx[PG_RX_BUFFER_SIZE + 1];    // Payload, NUL-terminated at rxLen
+    size_t rxLen;
+
+    void beginMessage(char type);
+    void endMessage();
+    void putInt32(int32_t value);
+    void putInt16(int16_t value);
+    void putString(const char* str);
+    void putBytes(const uint8_t* data, size_t len);
+    bool flush();
+
+    bool readExact(uint8_t* buf, size_t len);
+    bool readMessage(char* type);
+    void parseError();
+    PgResult waitReady();
+    PgResult ioError(const char* what);
+
+    bool authenticate(const char* user, const char* password);
+};
+
+// Append a value to a COPY text-format row, escaping backslash, tab, CR and LF
+void pgCopyEscape(String& row, const char* value);
+
+#endif // PG_CLIENT_H
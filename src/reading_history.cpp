@@ -0,0 +1,177 @@
+/**
+ * Reading History - LoRa Gateway
+ * Per-device rings of recent readings and LTTB downsampling for charts
+ */
+
+#include "reading_history.h"
+#include "device_registry.h"
+
+struct DeviceHistory {
+    uint64_t deviceId;        // Owner of the slot (0 = unused)
+    uint16_t head;            // Next write position
+    uint16_t count;
+    HistorySample samples[HISTORY_CAPACITY];
+};
+
+// Written from the MQTT task, read from the web server task; samples are
+// small, so copies are done under a spinlock
+static portMUX_TYPE historyMux = portMUX_INITIALIZER_UNLOCKED;
+static DeviceHistory histories[MAX_SENSORS];
+
+static const char* const FIELD_NAMES[HISTORY_FIELD_COUNT] = {
+    "temperature", "humidity", "pressure", "battery", "rssi"
+};
+
+/**
+ * Record one readings packet in its device's ring
+ * Indexed by registry slot, which stays the same for a device's lifetime
+ */
+void recordReading(uint64_t deviceId, const ReadingsPayload* readings,
+                   int16_t rssi, uint32_t receivedAt) {
+    int slot = getDeviceSlot(deviceId);
+    if (slot < 0 || slot >= MAX_SENSORS) {
+        return;
+    }
+
+    HistorySample sample;
+    sample.time = receivedAt;
+    sample.temperature = readings->temperature;
+    sample.humidity = readings->humidity;
+    sample.pressure = readings->pressure / 10 > 0xFFFF ? 0xFFFF : readings->pressure / 10;
+    sample.batteryMv = readings->batteryVoltage;
+    sample.rssi = rssi < -128 ? -128 : (rssi > 127 ? 127 : rssi);
+
+    portENTER_CRITICAL(&historyMux);
+    DeviceHistory* history = &histories[slot];
+    if (history->deviceId != deviceId) {
+        history->deviceId = deviceId;
+        history->head = 0;
+        history->count = 0;
+    }
+    history->samples[history->head] = sample;
+    history->head = (history->head + 1) % HISTORY_CAPACITY;
+    if (history->count < HISTORY_CAPACITY) {
+        history->count++;
+    }
+    portEXIT_CRITICAL(&historyMux);
+}
+
+/**
+ * Copy the samples of a time window, oldest first
+ */
+size_t readHistory(uint64_t deviceId, uint32_t from, uint32_t to,
+                   HistorySample* out, size_t maxCount) {
+    int slot = getDeviceSlot(deviceId);
+    if (slot < 0 || slot >= MAX_SENSORS) {
+        return 0;
+    }
+
+    size_t copied = 0;
+
+    portENTER_CRITICAL(&historyMux);
+    const DeviceHistory* history = &histories[slot];
+    if (history->deviceId == deviceId) {
+        uint16_t oldest = (history->head + HISTORY_CAPACITY - history->count) % HISTORY_CAPACITY;
+        for (uint16_t i = 0; i < history->count && copied < maxCount; i++) {
+            const HistorySample& sample = history->samples[(oldest + i) % HISTORY_CAPACITY];
+            if (sample.time >= from && sample.time <= to) {
+                out[copied++] = sample;
+            }
+        }
+    }
+    portEXIT_CRITICAL(&historyMux);
+
+    return copied;
+}
+
+HistoryField parseHistoryField(const char* name) {
+    for (int i = 0; i < HISTORY_FIELD_COUNT; i++) {
+        if (strcmp(name, FIELD_NAMES[i]) == 0) {
+            return (HistoryField)i;
+        }
+    }
+    return HISTORY_FIELD_COUNT;
+}
+
+const char* getHistoryFieldName(HistoryField field) {
+    return field < HISTORY_FIELD_COUNT ? FIELD_NAMES[field] : "unknown";
+}
+
+float getHistoryValue(const HistorySample& sample, HistoryField field) {
+    switch (field) {
+        case HISTORY_TEMPERATURE: return sample.temperature / 100.0f;
+        case HISTORY_HUMIDITY:    return sample.humidity / 100.0f;
+        case HISTORY_PRESSURE:    return sample.pressure / 10.0f;
+        case HISTORY_BATTERY:     return sample.batteryMv / 1000.0f;
+        case HISTORY_RSSI:        return sample.rssi;
+        default:                  return 0;
+    }
+}
+
+/**
+ * Largest-Triangle-Three-Buckets (Steinarsson, 2013)
+ * First and last samples are always kept; the rest are split into
+ * threshold - 2 buckets and each bucket keeps the sample forming the largest
+ * triangle with the previously kept sample and the next bucket's average
+ */
+size_t downsampleHistory(const HistorySample* samples, size_t count, HistoryField field,
+                         size_t threshold, uint16_t* indexes) {
+    if (threshold >= count) {
+        for (size_t i = 0; i < count; i++) {
+            indexes[i] = i;
+        }
+        return count;
+    }
+    if (threshold < 3) {
+        // Too few points for buckets: just the ends
+        if (threshold > 0) indexes[0] = 0;
+        if (threshold > 1) indexes[1] = count - 1;
+        return threshold;
+    }
+
+    float bucketSize = (float)(count - 2) / (threshold - 2);
+    size_t kept = 0;
+    size_t a = 0;
+    indexes[kept++] = 0;
+
+    for (size_t bucket = 0; bucket < threshold - 2; bucket++) {
+        // Average of the next bucket (the last sample for the final bucket)
+        size_t avgStart = (size_t)((bucket + 1) * bucketSize) + 1;
+        size_t avgEnd = (size_t)((bucket + 2) * bucketSize) + 1;
+        if (avgEnd > count) {
+            avgEnd = count;
+        }
+        float avgX = 0;
+        float avgY = 0;
+        for (size_t i = avgStart; i < avgEnd; i++) {
+            avgX += (float)(samples[i].time - samples[0].time);
+            avgY += getHistoryValue(samples[i], field);
+        }
+        avgX /= (avgEnd - avgStart);
+        avgY /= (avgEnd - avgStart);
+
+        // Pick the point of this bucket with the largest triangle
+        size_t rangeStart = (size_t)(bucket * bucketSize) + 1;
+        size_t rangeEnd = (size_t)((bucket + 1) * bucketSize) + 1;
+        float aX = (float)(samples[a].time - samples[0].time);
+        float aY = getHistoryValue(samples[a], field);
+        float maxArea = -1;
+        size_t next = rangeStart;
+
+        for (size_t i = rangeStart; i < rangeEnd; i++) {
+            float x = (float)(samples[i].time - samples[0].time);
+            float y = getHistoryValue(samples[i], field);
+            float area = fabsf((aX - avgX) * (y - aY) - (aX - x) * (avgY - aY));
+            if (area > maxArea) {
+                maxArea = area;
+                next = i;
+            }
+        }
+
+        indexes[kept++] = next;
+        a = next;
+    }
+
+    indexes[kept++] = count - 1;
+    return kept;
+}
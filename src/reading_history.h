@@ -0,0 +1,60 @@
+#ifndef READING_HISTORY_H
+#define READING_HISTORY_H
+
+#include <Arduino.h>
+#include "lora_protocol.h"
+
+// Recent sensor readings kept on the gateway for /api/history/<device_id>
+// One ring of compact samples per registry slot; when full the oldest
+// sample is overwritten. Times are gateway uptime in ms (the same clock as
+// lastSeen and event timestamps)
+#ifndef HISTORY_CAPACITY
+#define HISTORY_CAPACITY 192      // Samples per device (~3 h at 60 s intervals)
+#endif
+
+// Point budget of one history response (requests asking for more get this)
+#define HISTORY_MAX_POINTS HISTORY_CAPACITY
+
+struct HistorySample {
+    uint32_t time;            // Gateway uptime (ms) at reception
+    int16_t temperature;      // °C * 100
+    uint16_t humidity;        // % * 100
+    uint16_t pressure;        // Pa / 10 (0.1 hPa)
+    uint16_t batteryMv;
+    int8_t rssi;              // dBm, clamped to int8
+} __attribute__((packed));
+
+// Series that can be queried
+enum HistoryField {
+    HISTORY_TEMPERATURE,      // °C
+    HISTORY_HUMIDITY,         // %
+    HISTORY_PRESSURE,         // hPa
+    HISTORY_BATTERY,          // V
+    HISTORY_RSSI,             // dBm
+    HISTORY_FIELD_COUNT
+};
+
+// Record one readings packet (thread-safe, never blocks)
+void recordReading(uint64_t deviceId, const ReadingsPayload* readings,
+                   int16_t rssi, uint32_t receivedAt);
+
+// Copy a device's samples with from <= time <= to into out, oldest first
+// Returns the number of samples copied (0 for an unknown device)
+size_t readHistory(uint64_t deviceId, uint32_t from, uint32_t to,
+                   HistorySample* out, size_t maxCount);
+
+// Parse a field name ("temperature", "humidity", "pressure", "battery",
+// "rssi"); returns HISTORY_FIELD_COUNT if unknown
+HistoryField parseHistoryField(const char* name);
+const char* getHistoryFieldName(HistoryField field);
+
+// Value of one field of a sample in display units
+float getHistoryValue(const HistorySample& sample, HistoryField field);
+
+// Downsample to at most threshold points with Largest-Triangle-Three-
+// Buckets on the given field (keeps peaks and dips that plain decimation
+// loses). Writes the kept sample indexes to indexes, returns their count
+size_t downsampleHistory(const HistorySample* samples, size_t count, HistoryField field,
+                         size_t threshold, uint16_t* indexes);
+
+#endif // READING_HISTORY_H
@@ -8,591 +8,722 @@
 #include "command_sender.h"
 #include "database_manager.h"
 #include "lora_protocol.h"
+#include "lora_receiver.h"
+#include "event_log.h"
+#include "metrics.h"
+#include "reading_history.h"
+#include "dashboard_html.h"     // Generated from web/dashboard.html
 #include <ESPAsyncWebServer.h>
 #include <ArduinoJson.h>
+#include <memory>
+#include <vector>
 
 AsyncWebServer server(80);
+AsyncEventSource events("/api/stream");
 
-// HTML Dashboard (embedded)
-const char index_html[] PROGMEM = R"rawliteral(
-<!DOCTYPE html>
-<html>
-<head>
-    <meta charset="UTF-8">
-    <meta name="viewport" content="width=device-width, initial-scale=1.0">
-    <title>LoRa Gateway Admin</title>
-    <link href="https://fonts.googleapis.com/css2?family=Ubuntu:wght@300;400;500;700&display=swap" rel="stylesheet">
-    <style>
-        * { margin: 0; padding: 0; box-sizing: border-box; }
-        body { 
-            font-family: 'Ubuntu', sans-serif;
-            background: #0f0f0f;
-            color: #e0e0e0;
-            overflow: hidden;
-        }
-        .app-container {
-            display: flex;
-            height: 100vh;
-        }
-        .sidebar {
-            width: 280px;
-            background: #1a1a1a;
-            border-right: 1px solid #2a2a2a;
-            display: flex;
-            flex-direction: column;
-            overflow-y: auto;
-        }
-        .sidebar-header {
-            padding: 20px;
-            border-bottom: 1px solid #2a2a2a;
-        }
-        .sidebar-header h1 {
-            color: #00d4ff;
-            font-size: 1.4em;
-            font-weight: 500;
-            margin-bottom: 5px;
-        }
-        .sidebar-header .subtitle {
-            color: #888;
-            font-size: 0.85em;
-            font-weight: 300;
-        }
-        .gateway-status {
-            padding: 20px;
-            border-bottom: 1px solid #2a2a2a;
-        }
-        .status-title {
-            color: #00d4ff;
-            font-size: 0.9em;
-            font-weight: 500;
-            margin-bottom: 15px;
-            text-transform: uppercase;
-            letter-spacing: 0.5px;
-        }
-        .status-item {
-            margin-bottom: 12px;
-        }
-        .status-label {
-            color: #888;
-            font-size: 0.8em;
-            font-weight: 300;
-            margin-bottom: 4px;
-        }
-        .status-value {
-            color: #fff;
-            font-size: 0.95em;
-            font-weight: 400;
-        }
-        .status-badge {
-            display: inline-block;
-            padding: 4px 10px;
-            border-radius: 12px;
-            font-size: 0.8em;
-            font-weight: 500;
-            background: #065f46;
-            color: #10b981;
-        }
-        .status-badge.disconnected {
-            background: #7f1d1d;
-            color: #ef4444;
-        }
-        .status-badge.reconnecting {
-            background: #78350f;
-            color: #f59e0b;
-        }
-        .main-content {
-            flex: 1;
-            overflow-y: auto;
-            padding: 30px;
-        }
-        .content-header {
-            margin-bottom: 25px;
-        }
-        .content-header h2 {
-            color: #fff;
-            font-size: 1.8em;
-            font-weight: 500;
-            margin-bottom: 5px;
-        }
-        .content-header .description {
-            color: #888;
-            font-size: 0.95em;
-            font-weight: 300;
-        }
-        .sensors-grid {
-            display: grid;
-            grid-template-columns: repeat(auto-fill, minmax(420px, 1fr));
-            gap: 20px;
-        }
-        .sensor-card {
-            background: #1a1a1a;
-            border-radius: 12px;
-            padding: 20px;
-            border: 1px solid #2a2a2a;
-            transition: all 0.3s;
-        }
-        .sensor-card:hover {
-            border-color: #00d4ff;
-            box-shadow: 0 0 20px rgba(0,212,255,0.3);
-        }
-        .sensor-header {
-            display: flex;
-            justify-content: space-between;
-            margin-bottom: 15px;
-            padding-bottom: 12px;
-            border-bottom: 2px solid #2a2a2a;
-        }
-        .sensor-name { 
-            font-size: 1.2em; 
-            font-weight: 500; 
-            color: #00d4ff; 
-        }
-        .sensor-stats {
-            display: grid;
-            grid-template-columns: 1fr 1fr;
-            gap: 10px;
-            margin-bottom: 15px;
-        }
-        .stat { 
-            background: #151515;
-            padding: 10px;
-            border-radius: 8px;
-        }
-        .stat-label { 
-            font-size: 0.8em; 
-            color: #888;
-            font-weight: 300;
-        }
-        .stat-value { 
-            font-size: 1.05em; 
-            font-weight: 500; 
-            color: #fff; 
-            margin-top: 5px; 
-        }
-        .commands {
-            display: grid;
-            grid-template-columns: repeat(2, 1fr);
-            gap: 8px;
-        }
-        button {
-            font-family: 'Ubuntu', sans-serif;
-            background: linear-gradient(135deg, #1e3a8a, #3b82f6);
-            color: white;
-            border: none;
-            padding: 10px 15px;
-            border-radius: 8px;
-            cursor: pointer;
-            font-size: 0.9em;
-            font-weight: 500;
-            transition: all 0.2s;
-        }
-        button:hover {
-            transform: translateY(-2px);
-            box-shadow: 0 5px 15px rgba(59,130,246,0.4);
-        }
-        button:active { transform: translateY(0); }
-        .btn-danger { background: linear-gradient(135deg, #991b1b, #dc2626); }
-        .btn-success { background: linear-gradient(135deg, #065f46, #10b981); }
-        input[type="number"] {
-            font-family: 'Ubuntu', sans-serif;
-            background: #151515;
-            border: 1px solid #3a3a3a;
-            color: #fff;
-            padding: 8px;
-            border-radius: 6px;
-            width: 100%;
-            margin-top: 5px;
-            font-weight: 400;
-        }
-        .command-group {
-            grid-column: span 2;
-            background: #151515;
-            padding: 12px;
-            border-radius: 8px;
-        }
-        .command-group label {
-            display: block;
-            margin-bottom: 8px;
-            font-size: 0.9em;
-            font-weight: 400;
-            color: #00d4ff;
-        }
-        .status { 
-            padding: 4px 12px;
-            border-radius: 12px;
-            font-size: 0.8em;
-            font-weight: 500;
-            background: #065f46;
-            color: #10b981;
-        }
-        .loading {
-            text-align: center;
-            padding: 40px;
-            color: #888;
-        }
-        @keyframes spin {
-            to { transform: rotate(360deg); }
-        }
-        .spinner {
-            display: inline-block;
-            width: 40px;
-            height: 40px;
-            border: 4px solid #2a2a2a;
-            border-top-color: #00d4ff;
-            border-radius: 50%;
-            animation: spin 1s linear infinite;
-        }
-        /* Toast notifications */
-        .toast {
-            position: fixed;
-            bottom: 30px;
-            right: 30px;
-            background: #1a1a1a;
-            color: #fff;
-            padding: 16px 20px;
-            border-radius: 8px;
-            border: 1px solid #2a2a2a;
-            box-shadow: 0 4px 20px rgba(0,0,0,0.5);
-            font-size: 0.95em;
-            font-weight: 400;
-            z-index: 10000;
-            animation: slideIn 0.3s ease-out;
-            min-width: 250px;
-        }
-        .toast.success { border-color: #10b981; background: #065f46; }
-        .toast.error { border-color: #ef4444; background: #7f1d1d; }
-        @keyframes slideIn {
-            from { transform: translateX(400px); opacity: 0; }
-            to { transform: translateX(0); opacity: 1; }
-        }
-        @keyframes slideOut {
-            from { transform: translateX(0); opacity: 1; }
-            to { transform: translateX(400px); opacity: 0; }
-        }
-    </style>
-</head>
-<body>
-    <div class="app-container">
-        <!-- Sidebar -->
-        <div class="sidebar">
-            <div class="sidebar-header">
-                <h1>🌐 LoRa Gateway</h1>
-                <div class="subtitle">Admin Dashboard</div>
-            </div>
-            
-            <div class="gateway-status">
-                <div class="status-title">Gateway Status</div>
-                
-                <div class="status-item">
-                    <div class="status-label">System</div>
-                    <div class="status-value">
-                        <span class="status-badge">● ONLINE</span>
-                    </div>
-                </div>
-                
-                <div class="status-item">
-                    <div class="status-label">IP Address</div>
-                    <div class="status-value" id="gateway-ip">Loading...</div>
-                </div>
-                
-                <div class="status-item">
-                    <div class="status-label">WiFi Signal</div>
-                    <div class="status-value" id="wifi-rssi">Loading...</div>
-                </div>
-                
-                <div class="status-item">
-                    <div class="status-label">Uptime</div>
-                    <div class="status-value" id="uptime">Loading...</div>
-                </div>
-                
-                <div class="status-item">
-                    <div class="status-label">Free Memory</div>
-                    <div class="status-value" id="free-mem">Loading...</div>
-                </div>
-                
-                <div class="status-item">
-                    <div class="status-label">Database</div>
-                    <div class="status-value">
-                        <span class="status-badge" id="db-status">● CHECKING</span>
-                    </div>
-                </div>
-                
-                <div class="status-item">
-                    <div class="status-label">LoRa Frequency</div>
-                    <div class="status-value">915 MHz</div>
-                </div>
-                
-                <div class="status-item">
-                    <div class="status-label">Active Sensors</div>
-                    <div class="status-value" id="sensor-count">0</div>
-                </div>
-            </div>
-        </div>
-        
-        <!-- Main Content -->
-        <div class="main-content">
-            <div class="content-header">
-                <h2>Connected Sensors</h2>
-                <div class="description">Monitor and control your LoRa sensor network</div>
-            </div>
-            
-            <div id="sensors" class="sensors-grid">
-                <div class="loading">
-                    <div class="spinner"></div>
-                    <p>Loading sensors...</p>
-                </div>
-            </div>
-            
-            <div class="content-header" style="margin-top: 40px;">
-                <h2>Recent Events</h2>
-                <div class="description">System and device event logs from database</div>
-            </div>
-            
-            <div id="events" style="background: #1a1a1a; border-radius: 12px; padding: 20px; margin-top: 20px;">
-                <div class="loading">
-                    <div class="spinner"></div>
-                    <p>Loading events...</p>
-                </div>
-            </div>
-        </div>
-    </div>
-    
-    <script>
-        function formatTime(seconds) {
-            if (seconds < 60) return seconds + 's ago';
-            const min = Math.floor(seconds / 60);
-            if (min < 60) return min + 'm ago';
-            const hr = Math.floor(min / 60);
-            if (hr < 24) return hr + 'h ago';
-            const days = Math.floor(hr / 24);
-            return days + 'd ago';
+// Admission control state. Handlers, response fillers and disconnect
+// callbacks all run on the AsyncTCP task, so no lock is needed
+struct ClientBucket {
+    uint32_t ip;              // Client IPv4 address (0 = unused)
+    uint32_t tokens;          // Thousandths of a request
+    uint32_t lastRefill;      // millis() of the last refill
+    uint8_t active;           // Admitted requests of this client still open
+};
+
+static ClientBucket clientBuckets[WEB_RATE_CLIENTS];
+static int activeRequests = 0;    // Admitted requests not yet disconnected
+
+/**
+ * Helper: Reject a request with a JSON error and a Retry-After hint
+ */
+static void sendRejected(AsyncWebServerRequest *request, int code, const char* error,
+                         uint32_t retrySeconds) {
+    AsyncWebServerResponse *response = request->beginResponse(code, "application/json",
+        String("{\"success\":false,\"error\":\"") + error + "\"}");
+    response->addHeader("Retry-After", String(retrySeconds));
+    request->send(response);
+}
+
+/**
+ * Helper: Bucket of a client IP, or the longest idle bucket without open
+ * requests taken over for it (NULL if every bucket is busy)
+ */
+static ClientBucket* findClientBucket(uint32_t ip, uint32_t now) {
+    ClientBucket* idle = NULL;
+    for (int i = 0; i < WEB_RATE_CLIENTS; i++) {
+        ClientBucket* bucket = &clientBuckets[i];
+        if (bucket->ip == ip) {
+            return bucket;
         }
-        
-        function formatUptime(ms) {
-            const sec = Math.floor(ms / 1000);
-            const days = Math.floor(sec / 86400);
-            const hrs = Math.floor((sec % 86400) / 3600);
-            const mins = Math.floor((sec % 3600) / 60);
-            const secs = sec % 60;
-            if (days > 0) {
-                return `${days}d ${hrs}h ${mins}m`;
-            }
-            return `${hrs}h ${mins}m ${secs}s`;
+        if (bucket->active == 0 &&
+            (idle == NULL || now - bucket->lastRefill > now - idle->lastRefill)) {
+            idle = bucket;
         }
-        
-        function updateGatewayStatus() {
-            // Fetch gateway stats
-            fetch('/api/gateway')
-            .then(r => r.json())
-            .then(data => {
-                document.getElementById('gateway-ip').textContent = data.ip || 'Unknown';
-                document.getElementById('wifi-rssi').textContent = data.wifi_rssi ? data.wifi_rssi + ' dBm' : 'Unknown';
-                document.getElementById('free-mem').textContent = data.free_heap ? Math.round(data.free_heap / 1024) + ' KB' : 'Unknown';
-                document.getElementById('uptime').textContent = data.uptime ? formatUptime(data.uptime) : 'Unknown';
+    }
+    if (idle != NULL) {
+        idle->ip = ip;
+        idle->tokens = WEB_RATE_BURST * 1000;
+        idle->lastRefill = now;
+    }
+    return idle;
+}
+
+/**
+ * Helper: Admit an API request or answer it with 429/503
+ * Each client IP has a token bucket (WEB_RATE_PER_SEC, bursts up to
+ * WEB_RATE_BURST) and may keep WEB_MAX_CLIENT_ACTIVE requests open; at
+ * most WEB_MAX_ACTIVE_REQUESTS admitted requests may be open in total.
+ * Rejections are answered before any registry, queue or radio work, so a
+ * request storm costs the other tasks nothing, and the per-client cap
+ * keeps one slow client from taking every slot
+ * 
+ * @param cost: Tokens the request takes (heavier endpoints cost more)
+ * @return true if the handler may go on
+ */
+static bool admitRequest(AsyncWebServerRequest *request, uint32_t cost = 1) {
+    uint32_t ip = request->client()->remoteIP();
+    uint32_t now = millis();
+    ClientBucket* bucket = findClientBucket(ip, now);
+    
+    if (bucket == NULL || activeRequests >= WEB_MAX_ACTIVE_REQUESTS) {
+        metricsInc(METRIC_HTTP_REJECT_BUSY);
+        sendRejected(request, 503, "Server busy", 1);
+        return false;
+    }
+    if (bucket->active >= WEB_MAX_CLIENT_ACTIVE) {
+        metricsInc(METRIC_HTTP_REJECT_RATE);
+        sendRejected(request, 429, "Too many concurrent requests", 1);
+        return false;
+    }
+    
+    uint32_t elapsed = now - bucket->lastRefill;
+    if (elapsed >= WEB_RATE_BURST * 1000 / WEB_RATE_PER_SEC) {
+        bucket->tokens = WEB_RATE_BURST * 1000;
+    } else {
+        bucket->tokens = min<uint32_t>(bucket->tokens + elapsed * WEB_RATE_PER_SEC,
+                                       WEB_RATE_BURST * 1000);
+    }
+    bucket->lastRefill = now;
+    
+    if (bucket->tokens < cost * 1000) {
+        metricsInc(METRIC_HTTP_REJECT_RATE);
+        uint32_t waitMs = (cost * 1000 - bucket->tokens) / WEB_RATE_PER_SEC;
+        sendRejected(request, 429, "Too many requests", waitMs / 1000 + 1);
+        return false;
+    }
+    bucket->tokens -= cost * 1000;
+    
+    // A bucket with open requests is never taken over, so it is still
+    // this client's when the request ends
+    activeRequests++;
+    bucket->active++;
+    request->onDisconnect([bucket]() {
+        activeRequests--;
+        bucket->active--;
+    });
+    return true;
+}
+
+// Produces item i of a streamed JSON array ("" = skip the item)
+typedef std::function<String(size_t)> JsonItemSource;
+
+// Progress of one streamed array response (owned by its filler callback)
+struct JsonArrayStream {
+    JsonItemSource item;
+    size_t count;             // Items to ask for (fixed when the response starts)
+    size_t next;              // Next item index
+    bool first;               // No item written yet (no comma)
+    bool closed;              // Closing bracket queued
+    String pending;           // Serialized text not yet copied out
+    size_t pendingPos;
+};
+
+/**
+ * Helper: Begin a chunked response streaming a JSON array item by item
+ * Only one item is serialized at a time, so peak memory does not depend on
+ * how many items there are
+ */
+static AsyncWebServerResponse* beginJsonArrayStream(AsyncWebServerRequest *request,
+                                                    size_t count, JsonItemSource item) {
+    std::shared_ptr<JsonArrayStream> stream = std::make_shared<JsonArrayStream>();
+    stream->item = item;
+    stream->count = count;
+    stream->next = 0;
+    stream->first = true;
+    stream->closed = false;
+    stream->pending = "[";
+    stream->pendingPos = 0;
+    
+    return request->beginChunkedResponse("application/json",
+        [stream](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+            size_t written = 0;
+            
+            while (written < maxLen) {
+                // Copy out what is left of the current item
+                if (stream->pendingPos < stream->pending.length()) {
+                    size_t n = stream->pending.length() - stream->pendingPos;
+                    if (n > maxLen - written) {
+                        n = maxLen - written;
+                    }
+                    memcpy(buffer + written, stream->pending.c_str() + stream->pendingPos, n);
+                    stream->pendingPos += n;
+                    written += n;
+                    continue;
+                }
                 
-                // Update database status
-                const dbBadge = document.getElementById('db-status');
-                if (data.db_status === 'connected') {
-                    dbBadge.textContent = '● CONNECTED';
-                    dbBadge.className = 'status-badge';
-                } else if (data.db_status === 'reconnecting') {
-                    dbBadge.textContent = '● RECONNECTING';
-                    dbBadge.className = 'status-badge reconnecting';
+                stream->pendingPos = 0;
+                if (stream->next < stream->count) {
+                    String json = stream->item(stream->next++);
+                    if (json.length() == 0) {
+                        stream->pending = "";
+                        continue;
+                    }
+                    stream->pending = stream->first ? json : "," + json;
+                    stream->first = false;
+                } else if (!stream->closed) {
+                    stream->pending = "]";
+                    stream->closed = true;
                 } else {
-                    dbBadge.textContent = '● DISCONNECTED';
-                    dbBadge.className = 'status-badge disconnected';
+                    stream->pending = "";
+                    break;  // Done; returning 0 ends the response
                 }
-            })
-            .catch(e => console.error('Gateway stats error:', e));
-        }
-        
-        function showToast(message, type = 'success') {
-            const toast = document.createElement('div');
-            toast.className = 'toast ' + type;
-            toast.textContent = message;
-            document.body.appendChild(toast);
+            }
             
-            setTimeout(() => {
-                toast.style.animation = 'slideOut 0.3s ease-out';
-                setTimeout(() => toast.remove(), 300);
-            }, 3000);
+            return written;
+        });
+}
+
+/**
+ * Helper: Delta device query for /api/devices
+ * ?since=<cursor>   only devices changed after that cursor (0 = all)
+ * ?fields=a,b,c     only these fields per device ("id" is always included)
+ * ?offset=&limit=   page through the matching devices (registry order)
+ * X-Registry-Version is the since cursor for the next query (take it from
+ * the first page; changes made while paging show up in that next delta),
+ * X-Total-Count the number of matching devices before paging
+ * X-Registry-Reset: 1 means the cursor was not usable (e.g. from before a
+ * gateway reboot) and every device was selected: replace the local list
+ */
+static void sendDeviceDelta(AsyncWebServerRequest *request) {
+    String since;
+    size_t offset = 0;
+    size_t limit = MAX_SENSORS;
+    String fields;
+    
+    if (request->hasParam("since")) {
+        since = request->getParam("since")->value();
+    }
+    if (request->hasParam("offset")) {
+        offset = request->getParam("offset")->value().toInt();
+    }
+    if (request->hasParam("limit")) {
+        long value = request->getParam("limit")->value().toInt();
+        limit = value < 1 ? 1 : value;
+    }
+    if (request->hasParam("fields")) {
+        fields = request->getParam("fields")->value();
+    }
+    
+    uint8_t mask[REGISTRY_SLOT_MASK_BYTES];
+    int total = 0;
+    char cursor[REGISTRY_CURSOR_SIZE];
+    bool reset = getDevicesChangedSince(since.c_str(), mask, &total, cursor, sizeof(cursor));
+    
+    // Matching slots in this page (at most MAX_SENSORS, copied into the filler)
+    std::shared_ptr<std::vector<uint8_t>> slots = std::make_shared<std::vector<uint8_t>>();
+    size_t match = 0;
+    for (int i = 0; i < MAX_SENSORS && slots->size() < limit; i++) {
+        if ((mask[i / 8] & (1 << (i % 8))) && match++ >= offset) {
+            slots->push_back(i);
         }
-        
-        function sendCommand(deviceId, action, value = null) {
-            const payload = { device_id: deviceId, action: action };
-            if (value !== null) payload.value = parseInt(value);
-            
-            fetch('/api/command', {
-                method: 'POST',
-                headers: { 'Content-Type': 'application/json' },
-                body: JSON.stringify(payload)
-            })
-            .then(r => r.json())
-            .then(data => {
-                if (data.success) {
-                    showToast('✅ Command sent: ' + action, 'success');
-                } else {
-                    showToast('❌ Failed: ' + (data.error || 'Unknown error'), 'error');
-                }
-            })
-            .catch(e => showToast('❌ Error: ' + e.message, 'error'));
+    }
+    
+    AsyncWebServerResponse *response = beginJsonArrayStream(request, slots->size(),
+        [slots, fields](size_t i) {
+            return getDeviceJson((*slots)[i], fields.length() > 0 ? fields.c_str() : nullptr);
+        });
+    response->addHeader("X-Registry-Version", cursor);
+    if (reset) {
+        response->addHeader("X-Registry-Reset", "1");
+    }
+    response->addHeader("X-Total-Count", String(total));
+    response->addHeader("Cache-Control", "no-cache");
+    request->send(response);
+}
+
+/**
+ * Helper: Write a Prometheus label value, escaping backslash, quote and newline
+ */
+static void writeLabelValue(Print& out, const String& value) {
+    for (size_t i = 0; i < value.length(); i++) {
+        char c = value[i];
+        if (c == '\\' || c == '"') {
+            out.write('\\');
+            out.write(c);
+        } else if (c == '\n') {
+            out.print("\\n");
+        } else {
+            out.write(c);
         }
-        
-        function loadSensors() {
-            // Skip refresh if user is editing an input field
-            const activeEl = document.activeElement;
-            if (activeEl && activeEl.tagName === 'INPUT') {
-                return;
+    }
+}
+
+/**
+ * Helper: Gateway metrics in Prometheus text format (/metrics)
+ * Hot-path counters come from the lock-free metrics registry; the rest are
+ * read here at scrape time from the modules that own them
+ */
+static void writeGatewayMetrics(Print& out) {
+    writeMetrics(out);
+    
+    // Queues
+    writeMetricHeader(out, "lora_rx_queue_depth", "gauge", "Packets waiting in the RX to MQTT queue");
+    out.printf("lora_rx_queue_depth %lu\n", (unsigned long)uxQueueMessagesWaiting(getPacketQueue()));
+    writeMetricHeader(out, "db_queue_depth", "gauge", "Database writes waiting, by kind");
+    out.printf("db_queue_depth{kind=\"write\"} %lu\n", (unsigned long)dbManager.getQueueDepth());
+    out.printf("db_queue_depth{kind=\"packet\"} %lu\n", (unsigned long)dbManager.getPacketQueueDepth());
+    out.printf("db_queue_depth{kind=\"spill\"} %lu\n", (unsigned long)dbManager.getSpilledWrites());
+    
+    // Database
+    writeMetricHeader(out, "db_connected", "gauge", "1 if the database backend is reachable");
+    out.printf("db_connected %d\n", dbManager.getStatus() == DB_CONNECTED ? 1 : 0);
+    writeMetricHeader(out, "db_writes_failed_total", "counter", "Database writes that failed");
+    out.printf("db_writes_failed_total %lu\n", (unsigned long)dbManager.getFailedWrites());
+    writeMetricHeader(out, "db_writes_dropped_total", "counter", "Database writes dropped, by kind");
+    out.printf("db_writes_dropped_total{kind=\"write\"} %lu\n", (unsigned long)dbManager.getDroppedWrites());
+    out.printf("db_writes_dropped_total{kind=\"packet\"} %lu\n", (unsigned long)dbManager.getDroppedPackets());
+    writeMetricHeader(out, "db_breaker_trips_total", "counter", "Database circuit breaker openings");
+    out.printf("db_breaker_trips_total %lu\n", (unsigned long)dbManager.getBreakerTrips());
+    
+    // Commands
+    writeMetricHeader(out, "command_sent_total", "counter", "Commands transmitted, by priority class");
+    for (uint8_t p = 0; p < CMD_PRIORITY_COUNT; p++) {
+        CommandClassStats stats;
+        if (getCommandClassStats(p, &stats)) {
+            out.printf("command_sent_total{class=\"%s\"} %lu\n", getCommandPriorityName(p), (unsigned long)stats.sent);
+        }
+    }
+    writeMetricHeader(out, "command_expired_total", "counter", "Commands dropped at their deadline, by priority class");
+    for (uint8_t p = 0; p < CMD_PRIORITY_COUNT; p++) {
+        CommandClassStats stats;
+        if (getCommandClassStats(p, &stats)) {
+            out.printf("command_expired_total{class=\"%s\"} %lu\n", getCommandPriorityName(p), (unsigned long)stats.expired);
+        }
+    }
+    
+    // System
+    uint32_t freeHeap = ESP.getFreeHeap();
+    uint32_t maxAlloc = ESP.getMaxAllocHeap();
+    writeMetricHeader(out, "heap_free_bytes", "gauge", "Free heap");
+    out.printf("heap_free_bytes %lu\n", (unsigned long)freeHeap);
+    writeMetricHeader(out, "heap_free_min_bytes", "gauge", "Lowest free heap since boot");
+    out.printf("heap_free_min_bytes %lu\n", (unsigned long)ESP.getMinFreeHeap());
+    writeMetricHeader(out, "heap_max_alloc_bytes", "gauge", "Largest allocatable heap block");
+    out.printf("heap_max_alloc_bytes %lu\n", (unsigned long)maxAlloc);
+    writeMetricHeader(out, "heap_fragmentation_percent", "gauge", "100 - largest block / free heap");
+    out.printf("heap_fragmentation_percent %lu\n",
+               (unsigned long)(freeHeap > 0 ? 100 - (uint64_t)maxAlloc * 100 / freeHeap : 0));
+    writeMetricHeader(out, "wifi_rssi_dbm", "gauge", "Wi-Fi signal strength");
+    out.printf("wifi_rssi_dbm %d\n", WiFi.RSSI());
+    writeMetricHeader(out, "uptime_seconds", "counter", "Time since boot");
+    out.printf("uptime_seconds %lu\n", (unsigned long)(millis() / 1000));
+    
+    // Per-device link stats
+    int count = getDeviceCount();
+    const char* families[][3] = {
+        { "device_rssi_dbm", "gauge", "Last packet RSSI per device" },
+        { "device_snr_db", "gauge", "Last packet SNR per device" },
+        { "device_packets_total", "counter", "Packets received per device" },
+        { "device_last_seen_seconds", "gauge", "Seconds since the last packet per device" },
+    };
+    for (int f = 0; f < 4; f++) {
+        writeMetricHeader(out, families[f][0], families[f][1], families[f][2]);
+        for (int slot = 0; slot < count; slot++) {
+            DeviceLinkStats stats;
+            if (!getDeviceLinkStats(slot, &stats)) {
+                continue;
+            }
+            out.printf("%s{device=\"%016llX\",name=\"", families[f][0], stats.deviceId);
+            writeLabelValue(out, stats.deviceName);
+            // Prometheus wants bare \n line ends (Print::println would add \r)
+            switch (f) {
+                case 0: out.printf("\"} %d\n", stats.lastRssi); break;
+                case 1: out.printf("\"} %d\n", stats.lastSnr); break;
+                case 2: out.printf("\"} %lu\n", (unsigned long)stats.packetCount); break;
+                default: out.printf("\"} %lu\n", (unsigned long)((millis() - stats.lastSeen) / 1000)); break;
             }
+        }
+    }
+}
 
-            fetch('/api/devices')
-            .then(r => r.json())
-            .then(devices => {
-                const container = document.getElementById('sensors');
-                document.getElementById('sensor-count').textContent = devices.length;
+/**
+ * Helper: Parse a history time bound (gateway uptime ms; negative = that
+ * many ms before now)
+ */
+static uint32_t parseHistoryTime(const String& value, uint32_t now) {
+    long long ms = atoll(value.c_str());
+    if (ms < 0) {
+        return -ms > now ? 0 : now + ms;
+    }
+    return ms;
+}
 
-                if (devices.length === 0) {
-                    container.innerHTML = '<div class="loading"><p>No sensors registered yet</p></div>';
-                    return;
-                }
+/**
+ * Helper: Reading history of one device for /api/history/<device_id>
+ * ?from=&to=   window in gateway uptime ms, negative = relative to now
+ *              (default: everything kept)
+ * ?points=N    at most N points, LTTB-downsampled (default 100)
+ * ?field=      temperature (default), humidity, pressure, battery or rssi
+ */
+static void sendHistory(AsyncWebServerRequest *request) {
+    String idStr = request->url().substring(strlen("/api/history/"));
+    uint64_t deviceId = strtoull(idStr.c_str(), nullptr, 16);
+    if (idStr.length() == 0 || getDeviceSlot(deviceId) < 0) {
+        request->send(404, "application/json", "{\"success\":false,\"error\":\"Unknown device\"}");
+        return;
+    }
+    
+    uint32_t now = millis();
+    uint32_t from = 0;
+    uint32_t to = now;
+    size_t points = 100;
+    HistoryField field = HISTORY_TEMPERATURE;
+    
+    if (request->hasParam("from")) {
+        from = parseHistoryTime(request->getParam("from")->value(), now);
+    }
+    if (request->hasParam("to")) {
+        to = parseHistoryTime(request->getParam("to")->value(), now);
+    }
+    if (request->hasParam("points")) {
+        long value = request->getParam("points")->value().toInt();
+        points = value < 2 ? 2 : (value > HISTORY_MAX_POINTS ? HISTORY_MAX_POINTS : value);
+    }
+    if (request->hasParam("field")) {
+        field = parseHistoryField(request->getParam("field")->value().c_str());
+        if (field == HISTORY_FIELD_COUNT) {
+            request->send(400, "application/json", "{\"success\":false,\"error\":\"Unknown field\"}");
+            return;
+        }
+    }
+    
+    // Window copy and index list (bounded by HISTORY_CAPACITY)
+    HistorySample* samples = new HistorySample[HISTORY_CAPACITY];
+    uint16_t* indexes = new uint16_t[HISTORY_CAPACITY];
+    size_t count = readHistory(deviceId, from, to, samples, HISTORY_CAPACITY);
+    size_t kept = downsampleHistory(samples, count, field, points, indexes);
+    
+    char canonicalId[20];
+    snprintf(canonicalId, sizeof(canonicalId), "%016llX", deviceId);
+    
+    JsonDocument doc;
+    doc["device_id"] = canonicalId;
+    doc["field"] = getHistoryFieldName(field);
+    doc["from"] = from;
+    doc["to"] = to;
+    doc["samples"] = count;            // In the window, before downsampling
+    JsonArray series = doc["points"].to<JsonArray>();
+    for (size_t i = 0; i < kept; i++) {
+        const HistorySample& sample = samples[indexes[i]];
+        JsonArray point = series.add<JsonArray>();
+        point.add(sample.time);
+        point.add(getHistoryValue(sample, field));
+    }
+    
+    delete[] samples;
+    delete[] indexes;
+    
+    String json;
+    serializeJson(doc, json);
+    AsyncWebServerResponse *response = request->beginResponse(200, "application/json", json);
+    response->addHeader("Cache-Control", "no-cache");
+    request->send(response);
+}
 
-                // Preserve input values before refresh
-                const savedValues = {};
-                document.querySelectorAll('input[type="number"]').forEach(input => {
-                    savedValues[input.id] = input.value;
-                });
-                
-                container.innerHTML = devices.map(d => {
-                    const isBME280 = d.sensorType === 'BME280';
-                    const sensorBadge = d.sensorType === 'DS18B20' ? '🌡️' : d.sensorType === 'BME280' ? '🌤️' : '❓';
-                    return `
-                    <div class="sensor-card">
-                        <div class="sensor-header">
-                            <div class="sensor-name">${sensorBadge} ${d.name}</div>
-                            <div style="display:flex;gap:8px;align-items:center;">
-                                <span style="color:#888;font-size:0.8em;">${d.sensorType || 'Unknown'}</span>
-                                <div class="status">ONLINE</div>
-                            </div>
-                        </div>
-                        <div class="sensor-stats">
-                            <div class="stat">
-                                <div class="stat-label">Device ID</div>
-                                <div class="stat-value">${d.id.substring(0,12)}...</div>
-                            </div>
-                            <div class="stat">
-                                <div class="stat-label">Location</div>
-                                <div class="stat-value">${d.location}</div>
-                            </div>
-                            <div class="stat">
-                                <div class="stat-label">Last Seen</div>
-                                <div class="stat-value">${formatTime(d.lastSeenSeconds)}</div>
-                            </div>
-                            <div class="stat">
-                                <div class="stat-label">Packets</div>
-                                <div class="stat-value">${d.packetCount}</div>
-                            </div>
-                            <div class="stat">
-                                <div class="stat-label">RSSI / SNR</div>
-                                <div class="stat-value">${d.lastRssi} dBm / ${d.lastSnr} dB</div>
-                            </div>
-                            <div class="stat">
-                                <div class="stat-label">Sequence</div>
-                                <div class="stat-value">#${d.lastSequence}</div>
-                            </div>
-                            <div class="stat" style="grid-column: span 2; ${d.cmdQueueCount > 0 ? 'background: #1e3a5f; border: 1px solid #2563eb;' : ''}">
-                                <div class="stat-label">Command Queue</div>
-                                <div class="stat-value">
-                                    ${d.cmdQueueCount > 0
-                                        ? d.cmdQueueCount + ' pending: ' + d.cmdQueue.map(c => c.type + (c.retries > 0 ? ' (retry ' + c.retries + ')' : '')).join(', ')
-                                        : 'Empty'}
-                                </div>
-                            </div>
-                        </div>
-                        <div class="commands">
-                            <button onclick="sendCommand('${d.id}', 'status')">📊 Status</button>
-                            <button class="btn-danger" onclick="sendCommand('${d.id}', 'restart')">🔄 Restart</button>
-                            ${isBME280 ? `<button onclick="sendCommand('${d.id}', 'calibrate')">🎯 Calibrate</button>` : ''}
-                            ${isBME280 ? `<button onclick="sendCommand('${d.id}', 'clear_baseline')">🗑️ Clear Baseline</button>` : ''}
-                            <div class="command-group">
-                                <label>Sleep Interval (seconds)</label>
-                                <input type="number" id="sleep_${d.id}" value="${d.deepSleepSec}" min="10" max="3600">
-                                <button class="btn-success" style="margin-top:8px" onclick="sendCommand('${d.id}', 'set_sleep', document.getElementById('sleep_${d.id}').value)">Set Sleep</button>
-                            </div>
-                            <div class="command-group">
-                                <label>Sensor Interval (seconds)</label>
-                                <input type="number" id="interval_${d.id}" value="${d.sensorInterval}" min="10" max="3600">
-                                <button class="btn-success" style="margin-top:8px" onclick="sendCommand('${d.id}', 'set_interval', document.getElementById('interval_${d.id}').value)">Set Interval</button>
-                            </div>
-                        </div>
-                    </div>
-                `}).join('');
-                
-                // Restore saved input values after refresh (only if not focused)
-                Object.keys(savedValues).forEach(id => {
-                    const input = document.getElementById(id);
-                    if (input && document.activeElement !== input) {
-                        input.value = savedValues[id];
-                    }
-                });
-            })
-            .catch(e => {
-                document.getElementById('sensors').innerHTML = 
-                    '<div class="loading"><p>Error loading sensors: ' + e.message + '</p></div>';
-            });
+/**
+ * Helper: Parse an event severity filter (number or name), 0 = everything
+ */
+static uint8_t parseSeverity(const String& value) {
+    if (value == "info") return SEVERITY_INFO;
+    if (value == "warning") return SEVERITY_WARNING;
+    if (value == "error") return SEVERITY_ERROR;
+    if (value == "critical") return SEVERITY_CRITICAL;
+    return value.toInt();
+}
+
+/**
+ * Helper: Target of a command object, "device_id" (hex) or "group" (1-255)
+ * The group is read wide, so 256 or -1 cannot wrap to "no group" or broadcast
+ * @return NULL on success, otherwise the error message
+ */
+static const char* parseCommandTarget(JsonVariantConst command, uint64_t* deviceId) {
+    JsonVariantConst group = command["group"];
+    
+    if (!group.isNull()) {
+        if (!group.is<long>() || !isLoraGroupTarget(group.as<long>())) {
+            return "group must be 1-254, or 255 for every sensor";
         }
-        
-        function loadEvents() {
-            fetch('/api/events?limit=20')
-            .then(r => r.json())
-            .then(data => {
-                if (!data || data.length === 0) {
-                    document.getElementById('events').innerHTML = '<p style="color:#888;text-align:center;">No events yet</p>';
-                    return;
-                }
-                
-                const severityColors = { 0: '#10b981', 1: '#f59e0b', 2: '#ef4444' };
-                const severityLabels = { 0: 'INFO', 1: 'WARNING', 2: 'ERROR' };
-                
-                document.getElementById('events').innerHTML = '<table style="width:100%;border-collapse:collapse;">' +
-                    '<thead><tr style="border-bottom:1px solid #2a2a2a;"><th style="text-align:left;padding:12px;color:#00d4ff;font-weight:500;">Time</th>' +
-                    '<th style="text-align:left;padding:12px;color:#00d4ff;font-weight:500;">Device</th>' +
-                    '<th style="text-align:left;padding:12px;color:#00d4ff;font-weight:500;">Severity</th>' +
-                    '<th style="text-align:left;padding:12px;color:#00d4ff;font-weight:500;">Message</th></tr></thead><tbody>' +
-                    data.map(e => {
-                        const color = severityColors[e.severity] || '#888';
-                        const label = severityLabels[e.severity] || 'UNKNOWN';
-                        const time = new Date(e.received_at).toLocaleString();
-                        return `<tr style="border-bottom:1px solid #2a2a2a;">
-                            <td style="padding:12px;color:#888;font-size:0.85em;">${time}</td>
-                            <td style="padding:12px;color:#fff;">${e.device_name}</td>
-                            <td style="padding:12px;"><span style="background:${color}22;color:${color};padding:4px 8px;border-radius:4px;font-size:0.8em;font-weight:500;">${label}</span></td>
-                            <td style="padding:12px;color:#e0e0e0;">${e.message}</td>
-                        </tr>`;
-                    }).join('') +
-                    '</tbody></table>';
-            })
-            .catch(e => {
-                document.getElementById('events').innerHTML = '<p style="color:#888;text-align:center;">Database not available</p>';
-            });
+        *deviceId = loraGroupAddress(group.as<long>());
+    } else if (command["device_id"].is<const char*>()) {
+        *deviceId = strtoull(command["device_id"].as<const char*>(), nullptr, 16);
+    } else {
+        return "Missing device_id/group";
+    }
+    return NULL;
+}
+
+/**
+ * Helper: Validate a command object ("action", "value", "priority",
+ * "deadline_sec") for one target and encode it
+ * @return NULL on success, otherwise the error message
+ */
+static const char* buildCommandRequest(JsonVariantConst command, uint64_t deviceId,
+                                       CommandRequest* out) {
+    const char* action = command["action"];
+    if (!action) {
+        return "Missing action";
+    }
+    
+    // A group command needs someone to deliver to
+    if (isLoraGroupAddress(deviceId)) {
+        uint8_t members[REGISTRY_SLOT_MASK_BYTES];
+        if (getGroupMemberMask(loraGroupId(deviceId), members) == 0) {
+            return "Group has no members";
         }
+    }
+    
+    out->sensorId = deviceId;
+    out->paramLen = 0;
+    out->priority = parseCommandPriority(command["priority"].as<const char*>());
+    out->deadlineMs = parseCommandDeadline(command["deadline_sec"].as<uint32_t>());
+    
+    uint32_t value = 0;
+    if (strcmp(action, "set_interval") == 0) {
+        value = command["value"].as<uint32_t>();
+        if (value == 0) value = 90;  // Default if missing
         
-        // Load sensors and gateway status on page load
-        loadSensors();
-        updateGatewayStatus();
-        loadEvents();
-        
-        // Auto-refresh sensors every 5 seconds
-        setInterval(loadSensors, 5000);
-        
-        // Update gateway status every 2 seconds
-        setInterval(updateGatewayStatus, 2000);
+        // Validate interval range: must be between 5 and 3600 seconds
+        if (value < 5 || value > 3600) {
+            return "Interval must be between 5 and 3600 seconds";
+        }
+        out->cmdType = CMD_SET_INTERVAL;
+    }
+    else if (strcmp(action, "set_sleep") == 0) {
+        value = command["value"].as<uint32_t>();
+        if (value == 0) value = 90;  // Default if missing
         
-        // Refresh events every 10 seconds
-        setInterval(loadEvents, 10000);
-    </script>
-</body>
-</html>
-)rawliteral";
+        // Validate sleep value: maximum 3600 seconds
+        if (value > 3600) {
+            return "Invalid sleep value (max 3600 seconds)";
+        }
+        out->cmdType = CMD_SET_SLEEP;
+    }
+    else if (strcmp(action, "set_group") == 0) {
+        // Group membership is per device; 255 is reserved for broadcast
+        JsonVariantConst group = command["value"];
+        if (isLoraGroupAddress(deviceId) || !group.is<long>() ||
+            !isLoraGroupAssignment(group.as<long>())) {
+            return "set_group needs device_id and a group of 0-254";
+        }
+        value = group.as<long>();
+        out->cmdType = CMD_SET_GROUP;
+    }
+    else if (strcmp(action, "calibrate") == 0) {
+        out->cmdType = CMD_CALIBRATE;
+        return NULL;
+    }
+    else if (strcmp(action, "clear_baseline") == 0) {
+        out->cmdType = CMD_CLEAR_BASELINE;
+        return NULL;
+    }
+    else if (strcmp(action, "restart") == 0) {
+        out->cmdType = CMD_RESTART;
+        return NULL;
+    }
+    else if (strcmp(action, "status") == 0) {
+        out->cmdType = CMD_STATUS;
+        return NULL;
+    }
+    else {
+        return "Unknown action";
+    }
+    
+    // Value commands carry their parameter as a TLV
+    out->paramLen = encodeCommandParam(out->cmdType, value, out->params);
+    if (out->paramLen == 0) {
+        return "Cannot encode value";
+    }
+    out->cmdType |= CMD_FLAG_TLV_PARAMS;
+    return NULL;
+}
+
+/**
+ * Helper: Handle a complete /api/command/bulk body
+ * Accepts an array of command objects, {"commands": [...]}, or one command
+ * applied to a selection: {"action", "value", "select": {"location",
+ * "sensor_type"}}. Every command is validated before anything is queued,
+ * and the batch is queued all-or-nothing
+ */
+static void handleBulkCommand(AsyncWebServerRequest *request, const uint8_t* body, size_t len) {
+    JsonDocument doc;
+    if (deserializeJson(doc, body, len)) {
+        request->send(400, "application/json", "{\"success\":false,\"error\":\"Invalid JSON\"}");
+        return;
+    }
+    
+    // Expand the body into (target, command) pairs
+    std::vector<uint64_t> targets;
+    std::vector<const char*> targetErrors;
+    std::vector<JsonVariantConst> commands;
+    JsonVariant select = doc["select"];
+    if (!select.isNull()) {
+        // One extra slot tells a selection that is too large from a full one
+        uint64_t ids[WEB_BULK_MAX_COMMANDS + 1];
+        int count = selectDevices(select["location"].as<const char*>(),
+                                  select["sensor_type"].as<const char*>(),
+                                  ids, WEB_BULK_MAX_COMMANDS + 1);
+        if (count > WEB_BULK_MAX_COMMANDS) {
+            request->send(413, "application/json",
+                "{\"success\":false,\"error\":\"Selection matches too many devices, use a group\"}");
+            return;
+        }
+        targets.assign(ids, ids + count);
+        targetErrors.assign(count, (const char*)NULL);
+        commands.assign(count, doc.as<JsonVariantConst>());
+    } else {
+        JsonArray list = doc.is<JsonArray>() ? doc.as<JsonArray>() : doc["commands"].as<JsonArray>();
+        if (list.size() > WEB_BULK_MAX_COMMANDS) {
+            request->send(413, "application/json",
+                "{\"success\":false,\"error\":\"Too many commands, use a group\"}");
+            return;
+        }
+        for (JsonVariant item : list) {
+            uint64_t deviceId = 0;
+            targetErrors.push_back(parseCommandTarget(item, &deviceId));
+            targets.push_back(deviceId);
+            commands.push_back(item);
+        }
+    }
+    
+    if (targets.empty()) {
+        request->send(400, "application/json", "{\"success\":false,\"error\":\"No commands or no matching devices\"}");
+        return;
+    }
+    
+    // Validate everything first; report every bad item, queue nothing
+    size_t count = targets.size();
+    std::vector<CommandRequest> requests(count);
+    JsonDocument result;
+    JsonArray results = result["results"].to<JsonArray>();
+    bool valid = true;
+    for (size_t i = 0; i < count; i++) {
+        const char* error = targetErrors[i] ? targetErrors[i]
+                          : buildCommandRequest(commands[i], targets[i], &requests[i]);
+        if (error) {
+            JsonObject item = results.add<JsonObject>();
+            item["index"] = i;
+            item["error"] = error;
+            valid = false;
+        }
+    }
+    if (!valid) {
+        result["success"] = false;
+        result["error"] = "Invalid commands";
+        String json;
+        serializeJson(result, json);
+        request->send(400, "application/json", json);
+        return;
+    }
+    
+    std::vector<uint32_t> ids(count);
+    size_t failed = 0;
+    CommandBatchResult queued = queueCommandBatch(requests.data(), count, ids.data(), &failed);
+    if (queued == BATCH_EMPTY_GROUP) {
+        // Group emptied since validation: still the client's request at fault
+        JsonObject item = results.add<JsonObject>();
+        item["index"] = failed;
+        item["error"] = "Group has no members";
+        result["success"] = false;
+        result["error"] = "Invalid commands";
+        String json;
+        serializeJson(result, json);
+        request->send(400, "application/json", json);
+        return;
+    }
+    if (queued == BATCH_TOO_LARGE) {
+        // Permanent: retrying cannot help, unlike a temporarily full queue
+        request->send(413, "application/json",
+            "{\"success\":false,\"error\":\"Batch is larger than the command queue, use a group\"}");
+        return;
+    }
+    if (queued == BATCH_QUEUE_FULL) {
+        AsyncWebServerResponse *response = request->beginResponse(503, "application/json",
+            "{\"success\":false,\"error\":\"Command queue full, nothing queued\"}");
+        response->addHeader("Retry-After", "30");
+        request->send(response);
+        return;
+    }
+    
+    for (size_t i = 0; i < count; i++) {
+        const char* action = commands[i]["action"];
+        char idStr[17];
+        snprintf(idStr, sizeof(idStr), "%016llX", targets[i]);
+        JsonObject item = results.add<JsonObject>();
+        item["index"] = i;
+        item["device_id"] = idStr;
+        item["action"] = action;
+        item["id"] = ids[i];
+    }
+    result["success"] = true;
+    result["queued"] = count;
+    
+    String json;
+    serializeJson(result, json);
+    request->send(202, "application/json", json);
+    Serial.printf("[WEB] Bulk command: %u queued\n", (unsigned)count);
+}
+
+/**
+ * Helper: Gateway status as JSON (/api/gateway and the push stream)
+ */
+static String buildGatewayJson() {
+    JsonDocument doc;
+    doc["ip"] = WiFi.localIP().toString();
+    doc["wifi_rssi"] = WiFi.RSSI();
+    doc["free_heap"] = ESP.getFreeHeap();
+    doc["uptime"] = millis();
+    
+    // Database status
+    DatabaseStatus dbStatus = dbManager.getStatus();
+    doc["db_status"] = (dbStatus == DB_CONNECTED) ? "connected" : 
+                       (dbStatus == DB_RECONNECTING) ? "reconnecting" : "disconnected";
+    doc["db_queue"] = dbManager.getQueueDepth();
+    doc["db_coalesced"] = dbManager.getCoalescedWrites();
+    doc["db_dropped"] = dbManager.getDroppedWrites();
+    doc["db_spilled"] = dbManager.getSpilledWrites();
+    doc["db_breaker_trips"] = dbManager.getBreakerTrips();
+    doc["db_packet_queue"] = dbManager.getPacketQueueDepth();
+    doc["db_packets_sent"] = dbManager.getSentPackets();
+    doc["db_packets_dropped"] = dbManager.getDroppedPackets();
+    doc["db_body_bytes"] = dbManager.getBodyBytes();
+    doc["db_wire_bytes"] = dbManager.getWireBytes();
+    
+    // Downlink delivery statistics per priority class
+    JsonObject cmdStats = doc["command_stats"].to<JsonObject>();
+    for (uint8_t p = 0; p < CMD_PRIORITY_COUNT; p++) {
+        CommandClassStats stats;
+        getCommandClassStats(p, &stats);
+        JsonObject cls = cmdStats[getCommandPriorityName(p)].to<JsonObject>();
+        cls["sent"] = stats.sent;
+        cls["expired"] = stats.expired;
+        cls["latency_avg_ms"] = stats.sent ? (uint32_t)(stats.latencySumMs / stats.sent) : 0;
+        cls["latency_max_ms"] = stats.latencyMaxMs;
+    }
+    
+    String json;
+    serializeJson(doc, json);
+    return json;
+}
 
 /**
  * Initialize web server
@@ -600,46 +731,240 @@ const char index_html[] PROGMEM = R"rawliteral(
 void initWebServer() {
     Serial.println("Initializing web dashboard...");
     
-    // Main dashboard page
+    // Main dashboard page: pre-gzipped at build time, sent from flash as is
+    // The ETag is a hash of the page, so a browser holding the current copy
+    // gets a 304 and a firmware update is picked up on the next revalidation
     server.on("/", HTTP_GET, [](AsyncWebServerRequest *request){
-        request->send_P(200, "text/html", index_html);
+        if (request->hasHeader("If-None-Match") &&
+            request->getHeader("If-None-Match")->value().indexOf(DASHBOARD_HTML_ETAG) >= 0) {
+            AsyncWebServerResponse *response = request->beginResponse(304);
+            response->addHeader("ETag", DASHBOARD_HTML_ETAG);
+            response->addHeader("Cache-Control", "public, max-age=" WEB_DASHBOARD_MAX_AGE);
+            request->send(response);
+            return;
+        }
+        
+        AsyncWebServerResponse *response = request->beginResponse_P(200, "text/html",
+            dashboard_html_gz, sizeof(dashboard_html_gz));
+        response->addHeader("Content-Encoding", "gzip");
+        response->addHeader("ETag", DASHBOARD_HTML_ETAG);
+        response->addHeader("Cache-Control", "public, max-age=" WEB_DASHBOARD_MAX_AGE);
+        request->send(response);
     });
     
-    // API: Get all devices (thread-safe snapshot)
+    // API: Get all devices, streamed device by device from one consistent
+    // list (see getDeviceListSnapshot); no full-list buffer is built
+    // Strong ETag from the registry/command queue versions; a matching
+    // If-None-Match is answered with 304 before anything is serialized
+    // With ?since=, ?fields=, ?offset= or ?limit= it is a delta query instead
+    // ?v=1 adds lastSeenSeconds (age at request time) for older clients;
+    // that changes every second, so it is sent without an ETag
     server.on("/api/devices", HTTP_GET, [](AsyncWebServerRequest *request){
-        String json = getDeviceRegistrySnapshot();
-        request->send(200, "application/json", json);
+        if (!admitRequest(request)) {
+            return;
+        }
+        if (request->hasParam("since") || request->hasParam("fields") ||
+            request->hasParam("offset") || request->hasParam("limit")) {
+            sendDeviceDelta(request);
+            return;
+        }
+        bool withAge = request->hasParam("v") && request->getParam("v")->value() == "1";
+        
+        char etag[REGISTRY_ETAG_SIZE];
+        std::shared_ptr<const DeviceListSnapshot> list = getDeviceListSnapshot(etag, sizeof(etag));
+        
+        if (!withAge && request->hasHeader("If-None-Match")) {
+            const String& match = request->getHeader("If-None-Match")->value();
+            if (match == "*" || match.indexOf(etag) >= 0) {
+                AsyncWebServerResponse *response = request->beginResponse(304);
+                response->addHeader("ETag", etag);
+                response->addHeader("Cache-Control", "no-cache");
+                request->send(response);
+                return;
+            }
+        }
+        
+        // The filler holds the list, so devices changing mid-send do not
+        // affect (or free) what this response is sending
+        uint32_t now = millis();
+        AsyncWebServerResponse *response = beginJsonArrayStream(request, list->count,
+            [list, withAge, now](size_t i) -> String {
+                const String& device = *list->devices[i];
+                if (!withAge) {
+                    return device;
+                }
+                // Add the age before the object's closing brace
+                String json = device.substring(0, device.length() - 1);
+                json += ",\"lastSeenSeconds\":";
+                json += String((now - list->lastSeen[i]) / 1000);
+                json += "}";
+                return json;
+            });
+        if (withAge) {
+            response->addHeader("Cache-Control", "no-store");
+        } else {
+            response->addHeader("ETag", etag);
+            response->addHeader("Cache-Control", "no-cache");
+        }
+        request->send(response);
+    });
+    
+    // API: Reading history of one device (/api/history/<device_id>)
+    server.on("/api/history", HTTP_GET, [](AsyncWebServerRequest *request){
+        if (!admitRequest(request, 2)) {
+            return;
+        }
+        sendHistory(request);
+    });
+    
+    // Prometheus scrape endpoint
+    server.on("/metrics", HTTP_GET, [](AsyncWebServerRequest *request){
+        if (!admitRequest(request)) {
+            return;
+        }
+        AsyncResponseStream *response = request->beginResponseStream("text/plain; version=0.0.4");
+        writeGatewayMetrics(*response);
+        request->send(response);
     });
     
     // API: Get gateway status
     server.on("/api/gateway", HTTP_GET, [](AsyncWebServerRequest *request){
-        JsonDocument doc;
-        doc["ip"] = WiFi.localIP().toString();
-        doc["wifi_rssi"] = WiFi.RSSI();
-        doc["free_heap"] = ESP.getFreeHeap();
-        doc["uptime"] = millis();
-        
-        // Database status
-        DatabaseStatus dbStatus = dbManager.getStatus();
-        doc["db_status"] = (dbStatus == DB_CONNECTED) ? "connected" : 
-                           (dbStatus == DB_RECONNECTING) ? "reconnecting" : "disconnected";
-        doc["db_queue"] = dbManager.getQueueDepth();
+        if (!admitRequest(request)) {
+            return;
+        }
+        request->send(200, "application/json", buildGatewayJson());
+    });
+    
+    // Push stream: a new client gets the full device list and gateway
+    // status once, then only what changes (see webServerLoop)
+    events.onConnect([](AsyncEventSourceClient *client){
+        client->send(buildGatewayJson().c_str(), "gateway", millis(), 3000);
         
-        String json;
-        serializeJson(doc, json);
-        request->send(200, "application/json", json);
+        // Device list in messages of whole devices, so no client gets a
+        // fleet-sized buffer; the first one replaces the client's list
+        std::shared_ptr<const DeviceListSnapshot> list = getDeviceListSnapshot();
+        const char* event = "snapshot";
+        String chunk = "[";
+        for (int i = 0; i < list->count; i++) {
+            const String& device = *list->devices[i];
+            if (chunk.length() > 1 && chunk.length() + device.length() > WEB_SNAPSHOT_CHUNK_BYTES) {
+                chunk += "]";
+                client->send(chunk.c_str(), event, millis());
+                event = "devices";
+                chunk = "[";
+            }
+            if (chunk.length() > 1) {
+                chunk += ",";
+            }
+            chunk += device;
+        }
+        chunk += "]";
+        client->send(chunk.c_str(), event, millis());
     });
+    server.addHandler(&events);
     
-    // API: Get recent events from database
+    // API: Recent sensor events from the in-memory event log
+    // ?limit=N (default 20), ?severity=<min level or name>, ?since=<cursor>
+    // returns only events after that cursor (pass the X-Event-Cursor header
+    // back to poll incrementally); oldest first. A cursor from before a
+    // reboot gets the current tail and X-Event-Reset: 1
     server.on("/api/events", HTTP_GET, [](AsyncWebServerRequest *request){
-        // For now, return empty array - ESP32 doesn't query database
-        // Events are stored in PostgreSQL and can be viewed via API service directly
-        request->send(200, "application/json", "[]");
+        if (!admitRequest(request)) {
+            return;
+        }
+        size_t limit = 20;
+        uint32_t since = 0;
+        bool reset = false;
+        uint8_t minSeverity = SEVERITY_INFO;
+        
+        if (request->hasParam("limit")) {
+            long value = request->getParam("limit")->value().toInt();
+            limit = value < 1 ? 1 : (value > EVENT_LOG_CAPACITY ? EVENT_LOG_CAPACITY : value);
+        }
+        if (request->hasParam("since")) {
+            since = parseEventCursor(request->getParam("since")->value().c_str(), &reset);
+        }
+        if (request->hasParam("severity")) {
+            minSeverity = parseSeverity(request->getParam("severity")->value());
+        }
+        
+        // Copy out (bounded by the log size) so the lock is not held while sending
+        std::shared_ptr<EventLogEntry> events(new EventLogEntry[limit], std::default_delete<EventLogEntry[]>());
+        size_t count = readEventLog(since, minSeverity, events.get(), limit);
+        char cursor[EVENT_LOG_CURSOR_SIZE];
+        formatEventCursor(count > 0 ? events.get()[count - 1].id : since, cursor, sizeof(cursor));
+        
+        AsyncWebServerResponse *response = beginJsonArrayStream(request, count,
+            [events](size_t i) {
+                const EventLogEntry& e = events.get()[i];
+                char idStr[20];
+                snprintf(idStr, sizeof(idStr), "%016llX", e.deviceId);
+                char message[EVENT_LOG_MESSAGE_MAX + 1];
+                memcpy(message, e.message, e.messageLen);
+                message[e.messageLen] = '\0';
+                
+                JsonDocument doc;
+                doc["id"] = e.id;
+                doc["device_id"] = idStr;
+                doc["device_name"] = getDeviceName(e.deviceId);
+                doc["event_type"] = e.eventType;
+                doc["severity"] = e.severity;
+                doc["message"] = message;
+                doc["timestamp"] = e.timestamp;   // Gateway uptime (ms)
+                
+                String json;
+                serializeJson(doc, json);
+                return json;
+            });
+        response->addHeader("Cache-Control", "no-cache");
+        response->addHeader("X-Event-Cursor", cursor);
+        if (reset) {
+            response->addHeader("X-Event-Reset", "1");
+        }
+        request->send(response);
     });
     
+    // API: Queue many commands at once (all-or-nothing, see handleBulkCommand)
+    // The body may arrive in several chunks; it is collected in _tempObject
+    // (freed by the request) and handled once complete. Registered before
+    // /api/command, which would otherwise match this path as a prefix
+    server.on("/api/command/bulk", HTTP_POST, [](AsyncWebServerRequest *request){}, NULL,
+        [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total){
+            if (index == 0) {
+                if (!admitRequest(request, 4)) {
+                    return;
+                }
+                if (total > WEB_BULK_MAX_BODY) {
+                    request->send(413, "application/json", "{\"success\":false,\"error\":\"Body too large\"}");
+                    return;
+                }
+                request->_tempObject = malloc(total);
+                if (!request->_tempObject) {
+                    request->send(503, "application/json", "{\"success\":false,\"error\":\"Out of memory\"}");
+                    return;
+                }
+            }
+            if (!request->_tempObject) {
+                return;  // Rejected at the first chunk
+            }
+            
+            memcpy((uint8_t*)request->_tempObject + index, data, len);
+            if (index + len == total) {
+                handleBulkCommand(request, (const uint8_t*)request->_tempObject, total);
+            }
+        }
+    );
+    
     // API: Send command to sensor
+    // Only queued here: the radio is left to the sensor's next RX window
+    // (retryCommandsForSensor on the MQTT task), so the request never waits
+    // on the radio mutex and is answered 202 with the command id at once
     server.on("/api/command", HTTP_POST, [](AsyncWebServerRequest *request){}, NULL,
         [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total){
+            if (index > 0 || !admitRequest(request)) {
+                return;
+            }
+            
             // Parse JSON body
             JsonDocument doc;
             DeserializationError error = deserializeJson(doc, data, len);
@@ -649,75 +974,42 @@ void initWebServer() {
                 return;
             }
             
-            const char* deviceIdStr = doc["device_id"];
             const char* action = doc["action"];
-            
-            if (!deviceIdStr || !action) {
-                request->send(400, "application/json", "{\"success\":false,\"error\":\"Missing device_id or action\"}");
+            uint64_t deviceId;
+            const char* targetError = parseCommandTarget(doc, &deviceId);
+            if (targetError || !action) {
+                JsonDocument errorDoc;
+                errorDoc["success"] = false;
+                errorDoc["error"] = targetError ? targetError : "Missing action";
+                String json;
+                serializeJson(errorDoc, json);
+                request->send(400, "application/json", json);
                 return;
             }
             
-            // Parse device ID
-            uint64_t deviceId = strtoull(deviceIdStr, nullptr, 16);
-            
-            // Map action to command
-            bool success = false;
-            if (strcmp(action, "set_interval") == 0) {
-                uint16_t value = doc["value"].as<uint16_t>();
-                if (value == 0) value = 90;  // Default if missing
-                
-                // Validate interval range: must be between 5 and 3600 seconds
-                if (value < 5 || value > 3600) {
-                    request->send(400, "application/json", "{\"success\":false,\"error\":\"Interval must be between 5 and 3600 seconds\"}");
-                    return;
-                }
-                
-                Serial.printf("[WEB] set_interval: value=%u\n", value);
-                
-                // Format as ASCII decimal string (matches MQTT handler and command_sender)
-                char valueStr[8];
-                snprintf(valueStr, sizeof(valueStr), "%u", value);
-                success = queueCommand(deviceId, CMD_SET_INTERVAL, (uint8_t*)valueStr, strlen(valueStr));
-            }
-            else if (strcmp(action, "set_sleep") == 0) {
-                uint16_t value = doc["value"].as<uint16_t>();
-                if (value == 0) value = 90;  // Default if missing
-                
-                // Validate sleep value: maximum 3600 seconds
-                if (value > 3600) {
-                    request->send(400, "application/json", "{\"success\":false,\"error\":\"Invalid sleep value (max 3600 seconds)\"}");
-                    return;
-                }
-                
-                Serial.printf("[WEB] set_sleep: value=%u\n", value);
-                
-                // Format as ASCII decimal string (matches MQTT handler and command_sender)
-                char valueStr[8];
-                snprintf(valueStr, sizeof(valueStr), "%u", value);
-                success = queueCommand(deviceId, CMD_SET_SLEEP, (uint8_t*)valueStr, strlen(valueStr));
-            }
-            else if (strcmp(action, "calibrate") == 0) {
-                success = queueCommand(deviceId, CMD_CALIBRATE, nullptr, 0);
-            }
-            else if (strcmp(action, "clear_baseline") == 0) {
-                success = queueCommand(deviceId, CMD_CLEAR_BASELINE, nullptr, 0);
-            }
-            else if (strcmp(action, "restart") == 0) {
-                success = queueCommand(deviceId, CMD_RESTART, nullptr, 0);
-            }
-            else if (strcmp(action, "status") == 0) {
-                success = queueCommand(deviceId, CMD_STATUS, nullptr, 0);
-            }
-            else {
-                request->send(400, "application/json", "{\"success\":false,\"error\":\"Unknown action\"}");
+            CommandRequest command;
+            const char* commandError = buildCommandRequest(doc, deviceId, &command);
+            if (commandError) {
+                JsonDocument errorDoc;
+                errorDoc["success"] = false;
+                errorDoc["error"] = commandError;
+                String json;
+                serializeJson(errorDoc, json);
+                request->send(400, "application/json", json);
                 return;
             }
             
-            if (success) {
-                request->send(200, "application/json", "{\"success\":true}");
+            uint32_t id;
+            CommandBatchResult queued = queueCommandBatch(&command, 1, &id);
+            if (queued == BATCH_QUEUED) {
+                char json[48];
+                snprintf(json, sizeof(json), "{\"success\":true,\"id\":%lu}", (unsigned long)id);
+                request->send(202, "application/json", json);
                 Serial.printf("[WEB] Command queued: %s for device 0x%016llX\n", action, deviceId);
+            } else if (queued == BATCH_EMPTY_GROUP) {
+                request->send(400, "application/json", "{\"success\":false,\"error\":\"Group has no members\"}");
             } else {
-                request->send(500, "application/json", "{\"success\":false,\"error\":\"Failed to queue command\"}");
+                request->send(503, "application/json", "{\"success\":false,\"error\":\"Command queue full\"}");
             }
         }
     );
@@ -726,3 +1018,34 @@ void initWebServer() {
     server.begin();
     Serial.println("✅ Web dashboard started on port 80");
 }
+
+/**
+ * Push device changes and gateway stats to stream clients
+ * Each update is serialized once for all clients, and only while someone
+ * is listening; a reconnecting client starts from a fresh snapshot
+ */
+void webServerLoop() {
+    static uint32_t lastPush = 0;
+    static uint32_t lastGatewayPush = 0;
+    
+    uint32_t now = millis();
+    if (now - lastPush < WEB_PUSH_INTERVAL_MS) {
+        return;
+    }
+    lastPush = now;
+    
+    if (events.count() == 0 || events.avgPacketsWaiting() >= WEB_PUSH_MAX_BACKLOG) {
+        return;
+    }
+    
+    // Includes devices whose queued commands changed
+    String changes = takeDeviceRegistryChanges();
+    if (changes.length() > 0) {
+        events.send(changes.c_str(), "devices", now);
+    }
+    
+    if (now - lastGatewayPush >= WEB_GATEWAY_PUSH_MS) {
+        lastGatewayPush = now;
+        events.send(buildGatewayJson().c_str(), "gateway", now);
+    }
+}
@@ -1,7 +1,64 @@
 #ifndef WEB_SERVER_H
 #define WEB_SERVER_H
 
+// Dashboard push stream (Server-Sent Events at /api/stream): changed
+// devices are collected every WEB_PUSH_INTERVAL_MS and gateway stats every
+// WEB_GATEWAY_PUSH_MS, serialized once and sent to every connected client
+#ifndef WEB_PUSH_INTERVAL_MS
+#define WEB_PUSH_INTERVAL_MS 500
+#endif
+#ifndef WEB_GATEWAY_PUSH_MS
+#define WEB_GATEWAY_PUSH_MS 2000
+#endif
+// Largest device list message sent to a newly connected stream client
+// (bigger lists go out as several messages of whole devices)
+#define WEB_SNAPSHOT_CHUNK_BYTES 1024
+// Skip a push while clients still have this many unsent messages queued
+// (changes stay pending instead of being dropped by a full client queue)
+#define WEB_PUSH_MAX_BACKLOG 4
+
+// Browser cache lifetime of the dashboard page (seconds, string literal)
+// Within it the cached copy is used without a request; a page reload always
+// revalidates against the content-hash ETag, so firmware updates still show
+#ifndef WEB_DASHBOARD_MAX_AGE
+#define WEB_DASHBOARD_MAX_AGE "86400"
+#endif
+
+// Bulk command API (/api/command/bulk): most commands per request and
+// largest accepted body (bytes). A batch is queued all-or-nothing, so more
+// commands than the queue holds could never succeed; fleet-wide changes
+// should use group addressing (one queue entry for the whole group)
+#ifndef WEB_BULK_MAX_COMMANDS
+#define WEB_BULK_MAX_COMMANDS MAX_QUEUED_COMMANDS
+#endif
+#ifndef WEB_BULK_MAX_BODY
+#define WEB_BULK_MAX_BODY 4096
+#endif
+
+// Admission control for /api/* and /metrics: each client IP gets
+// WEB_RATE_PER_SEC requests per second with bursts up to WEB_RATE_BURST
+// and at most WEB_MAX_CLIENT_ACTIVE requests in flight (429 beyond that);
+// at most WEB_MAX_ACTIVE_REQUESTS requests may be in flight in total (503
+// beyond that). WEB_RATE_CLIENTS buckets are kept; the longest idle one
+// without open requests is reused for a new client
+#ifndef WEB_RATE_PER_SEC
+#define WEB_RATE_PER_SEC 5
+#endif
+#ifndef WEB_RATE_BURST
+#define WEB_RATE_BURST 20
+#endif
+#ifndef WEB_MAX_ACTIVE_REQUESTS
+#define WEB_MAX_ACTIVE_REQUESTS 4
+#endif
+#ifndef WEB_MAX_CLIENT_ACTIVE
+#define WEB_MAX_CLIENT_ACTIVE 2
+#endif
+#define WEB_RATE_CLIENTS 8
+
 // Initialize web server
 void initWebServer();
 
+// Push pending dashboard updates to stream clients (call from loop())
+void webServerLoop();
+
 #endif // WEB_SERVER_H